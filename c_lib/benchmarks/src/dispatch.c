@@ -0,0 +1,103 @@
+#define INSTRUCTIONS_TABLE
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "omp.h"
+#include "widget.h"
+#include "input_stream.h"
+#include "instructions.h"
+
+#define N_STREAM_TYPES (4)
+#define STREAM_LOCAL (0)
+#define STREAM_NON_LOCAL (1)
+#define STREAM_RZ (2)
+#define STREAM_MIXED (3)
+
+const char* STREAM_NAMES[N_STREAM_TYPES] = {"local", "non local", "rz", "mixed"};
+
+/*
+ * Creates a stream of a single instruction type, or an even mix of local and non local Cliffords
+ * with one RZ in every eight gates
+ */
+instruction_stream_u* create_instruction_stream(const size_t n_qubits, const size_t n_gates, const uint8_t type)
+{
+    instruction_stream_u* inst = malloc(n_gates * sizeof(instruction_stream_u));
+    for (size_t i = 0; i < n_gates; i++)
+    {
+        uint8_t gate = type;
+        if (STREAM_MIXED == type)
+        {
+            gate = (0 == i % 8) ? STREAM_RZ : rand() % 2;
+        }
+
+        switch (gate)
+        {
+            case STREAM_LOCAL:
+                inst[i].single.opcode = LOCAL_CLIFFORD_MASK | (rand() % N_LOCAL_CLIFFORD_INSTRUCTIONS);
+                inst[i].single.arg = rand() % n_qubits;
+                break;
+            case STREAM_NON_LOCAL:
+                inst[i].multi.opcode = NON_LOCAL_CLIFFORD_MASK | (rand() % N_NON_LOCAL_CLIFFORD_INSTRUCTIONS);
+                inst[i].multi.ctrl = rand() % n_qubits;
+                while ((inst[i].multi.targ = rand() % n_qubits) == inst[i].multi.ctrl) {};
+                break;
+            default:
+                inst[i].rz.opcode = _RZ_;
+                inst[i].rz.arg = rand() % n_qubits;
+                inst[i].rz.tag = i;
+        }
+    }
+    return inst;
+}
+
+/*
+ * Times a stream through one ingest mode, returning seconds per gate
+ */
+double dispatch_benchmark(const size_t n_qubits, const instruction_stream_u* inst, const size_t n_gates, const uint8_t mode)
+{
+    // Streams hold at most n_qubits RZ gates
+    widget_t* wid = widget_create(n_qubits, 2 * n_qubits);
+    widget_set_ingest_mode(wid, mode);
+    instruction_stream_u* stream = malloc(n_gates * sizeof(instruction_stream_u));
+    memcpy(stream, inst, n_gates * sizeof(instruction_stream_u));
+
+    double t_start = omp_get_wtime();
+    parse_instruction_block(wid, stream, n_gates);
+    double t_total = omp_get_wtime() - t_start;
+
+    free(stream);
+    widget_destroy(wid);
+    return t_total / n_gates;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 4)
+    {
+        printf("Insufficient parameters, requires <n_qubits> <n_gates> <seed>\n");
+        return 0;
+    }
+
+    size_t n_qubits = atoi(argv[1]);
+    size_t n_gates = atoi(argv[2]);
+    uint32_t seed = atoi(argv[3]);
+
+    srand(seed);
+
+    printf("ns per gate     table    threaded replay\n");
+    for (uint8_t type = 0; type < N_STREAM_TYPES; type++)
+    {
+        // Non local gates sweep the tableau and every RZ allocates a qubit, so these streams are shorter
+        const size_t n_type_gates[N_STREAM_TYPES] = {n_gates, n_gates / 16 + 1, n_qubits, 8 * n_qubits};
+        instruction_stream_u* inst = create_instruction_stream(n_qubits, n_type_gates[type], type);
+        printf("%-12s %8.2f %8.2f %8.2f\n",
+            STREAM_NAMES[type],
+            1e9 * dispatch_benchmark(n_qubits, inst, n_type_gates[type], INGEST_DISPATCH),
+            1e9 * dispatch_benchmark(n_qubits, inst, n_type_gates[type], INGEST_THREADED),
+            1e9 * dispatch_benchmark(n_qubits, inst, n_type_gates[type], INGEST_CHUNK_REPLAY));
+        free(inst);
+    }
+
+    return 0;
+}
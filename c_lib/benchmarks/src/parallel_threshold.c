@@ -0,0 +1,51 @@
+#define INSTRUCTIONS_TABLE
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "omp.h"
+#include "tableau.h"
+#include "tableau_operations.h"
+
+/*
+ * Times a single qubit gate sweep over a tableau with the given parallel threshold
+ */
+double gate_benchmark(const size_t n_qubits, const size_t n_gates, const size_t threshold)
+{
+    tableau_t* tab = tableau_create(n_qubits);
+    tab->parallel_threshold = threshold;
+
+    double t_start = omp_get_wtime();
+    for (size_t i = 0; i < n_gates; i++)
+    {
+        tableau_S(tab, i % n_qubits);
+    }
+    double t_total = omp_get_wtime() - t_start;
+
+    tableau_destroy(tab);
+    return t_total;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        printf("Insufficient parameters, requires <n_gates>\n");
+        return 0;
+    }
+
+    size_t n_gates = atoi(argv[1]);
+
+    size_t threshold = tableau_calibrate_parallel_threshold();
+    printf("Threads: %d Calibrated threshold: %lu chunks\n", omp_get_max_threads(), threshold);
+
+    for (size_t n_qubits = 1 << 8; n_qubits <= 1 << 16; n_qubits <<= 1)
+    {
+        printf("%lu qubits: serial %e parallel %e\n",
+            n_qubits,
+            gate_benchmark(n_qubits, n_gates, SIZE_MAX),
+            gate_benchmark(n_qubits, n_gates, 0));
+    }
+
+    return 0;
+}
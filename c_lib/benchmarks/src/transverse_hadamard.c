@@ -0,0 +1,91 @@
+#define INSTRUCTIONS_TABLE
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "omp.h"
+#include "tableau.h"
+#include "cpu_dispatch.h"
+
+/*
+ * Swaps the bits of a column with a get and set per row, as tableau_transverse_hadamard did
+ * before it was vectorised
+ */
+void transverse_hadamard_get_set(tableau_t* tab, const size_t targ)
+{
+    const size_t n_active = __inline_tableau_active_qubits(tab);
+    for (size_t i = 0; i < n_active; i++)
+    {
+        const uint8_t bit_z = __inline_slice_get_bit(tab->slices_z[i], targ);
+        const uint8_t bit_x = __inline_slice_get_bit(tab->slices_x[i], targ);
+
+        __inline_slice_set_bit(tab->slices_z[i], targ, bit_x);
+        __inline_slice_set_bit(tab->slices_x[i], targ, bit_z);
+    }
+}
+
+/*
+ * Times transverse hadamards over every column of a random tableau
+ * Uses the get and set loop when isa is NULL, otherwise the dispatched kernel for the isa
+ */
+double transverse_hadamard_benchmark(const size_t n_qubits, const size_t n_rounds, const uint8_t* isa)
+{
+    tableau_t* tab = tableau_create(n_qubits);
+    for (size_t i = 0; i < n_qubits; i++)
+    {
+        for (size_t j = 0; j < tab->active_len; j++)
+        {
+            TABLEAU_CHUNK(tab->slices_x[i], j) = ((uint64_t)rand() << 32) | rand();
+            TABLEAU_CHUNK(tab->slices_z[i], j) = ((uint64_t)rand() << 32) | rand();
+        }
+    }
+    if (NULL != isa)
+    {
+        cpu_dispatch_select(*isa);
+    }
+
+    double t_start = omp_get_wtime();
+    for (size_t r = 0; r < n_rounds; r++)
+    {
+        for (size_t i = 0; i < n_qubits; i++)
+        {
+            if (NULL == isa)
+            {
+                transverse_hadamard_get_set(tab, i);
+            }
+            else
+            {
+                tableau_transverse_hadamard(tab, i);
+            }
+        }
+    }
+    double t_total = omp_get_wtime() - t_start;
+
+    tableau_destroy(tab);
+    return t_total / (n_rounds * n_qubits * n_qubits);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        printf("Insufficient parameters, requires <n_rounds>\n");
+        return 0;
+    }
+
+    size_t n_rounds = atoi(argv[1]);
+    const uint8_t host_isa = cpu_dispatch_detect();
+
+    for (size_t n_qubits = 1 << 8; n_qubits <= 1 << 14; n_qubits <<= 2)
+    {
+        printf("%lu qubits, seconds per row: get/set %e", n_qubits, transverse_hadamard_benchmark(n_qubits, n_rounds, NULL));
+        for (uint8_t isa = CPU_ISA_SCALAR; isa <= host_isa; isa++)
+        {
+            printf(" %s %e", cpu_dispatch_isa_name(isa), transverse_hadamard_benchmark(n_qubits, n_rounds, &isa));
+        }
+        printf("\n");
+    }
+    cpu_dispatch_select(host_isa);
+
+    return 0;
+}
@@ -0,0 +1,133 @@
+#ifndef CIRCUIT_FILE_H
+#define CIRCUIT_FILE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "instruction_table.h"
+#include "widget.h"
+
+/*
+ * Binary circuit files
+ * A circuit file is a fixed size header followed by the instruction records
+ *
+ *   Header  : circuit_file_header_t, little endian, CIRCUIT_FILE_HEADER_BYTES long
+ *   Records : n_instructions records in the encoding named by the header
+ *
+ * CIRCUIT_FILE_ENCODING_RAW records are instruction_stream_u images, the opcode in the first
+ * byte, three zero bytes and the two uint32_t fields of the largest member, unused fields are zero
+ * These are parsed in place from the mapping without a copy
+ * CIRCUIT_FILE_ENCODING_PACKED records are a packed stream, see packed_stream.h
+ * These are decoded one window at a time
+ *
+ * Files are mapped read only, consumed windows are released with MADV_DONTNEED so that the
+ * resident size stays bounded by the read ahead regardless of the size of the file
+ */
+#define CIRCUIT_FILE_MAGIC "CABCIRC"
+#define CIRCUIT_FILE_VERSION (1)
+#define CIRCUIT_FILE_HEADER_BYTES (64)
+
+#define CIRCUIT_FILE_ENCODING_RAW (0)
+#define CIRCUIT_FILE_ENCODING_PACKED (1)
+
+// Instructions passed to each call of parse_instruction_block
+#ifndef CIRCUIT_FILE_WINDOW
+#define CIRCUIT_FILE_WINDOW (1 << 16)
+#endif
+
+// Windows requested from the page cache ahead of the one being parsed
+#ifndef CIRCUIT_FILE_READ_AHEAD
+#define CIRCUIT_FILE_READ_AHEAD (4)
+#endif
+
+// Status codes
+#define CIRCUIT_FILE_OK (0)
+#define CIRCUIT_FILE_ERR_IO (1)
+#define CIRCUIT_FILE_ERR_FORMAT (2)
+#define CIRCUIT_FILE_ERR_QUBITS (3)
+
+typedef struct circuit_file_header_t circuit_file_header_t;
+struct circuit_file_header_t
+{
+    char magic[8]; // CIRCUIT_FILE_MAGIC, null terminated
+    uint32_t version; // CIRCUIT_FILE_VERSION
+    uint32_t encoding; // CIRCUIT_FILE_ENCODING_RAW or CIRCUIT_FILE_ENCODING_PACKED
+    uint64_t n_qubits; // Initial qubits of the widget
+    uint64_t max_qubits; // Maximum qubits of the widget
+    uint64_t n_instructions; // Number of records
+    uint64_t n_bytes; // Length of the records
+    uint64_t reserved[2];
+};
+
+/*
+ * circuit_file_t
+ * An open circuit file
+ */
+typedef struct circuit_file_t circuit_file_t;
+struct circuit_file_t
+{
+    circuit_file_header_t header;
+    int fd;
+    uint8_t* map; // Read only mapping of the whole file
+    size_t map_len; // Length of the mapping
+    size_t released; // Prefix of the mapping released after parsing
+};
+
+/*
+ * circuit_file_write
+ * Writes a circuit file
+ * :: path : const char* :: File to create or truncate
+ * :: n_qubits : const size_t :: Initial qubits of the widget
+ * :: max_qubits : const size_t :: Maximum qubits of the widget
+ * :: instructions : const instruction_stream_u* :: Array of instructions
+ * :: n_instructions : const size_t :: Number of instructions
+ * :: encoding : const uint32_t :: CIRCUIT_FILE_ENCODING_RAW or CIRCUIT_FILE_ENCODING_PACKED
+ * Returns CIRCUIT_FILE_OK or CIRCUIT_FILE_ERR_IO
+ */
+int circuit_file_write(
+    const char* path,
+    const size_t n_qubits,
+    const size_t max_qubits,
+    const instruction_stream_u* instructions,
+    const size_t n_instructions,
+    const uint32_t encoding);
+
+/*
+ * circuit_file_open
+ * Maps a circuit file and checks its header
+ * :: path : const char* :: File to open
+ * :: status : int* :: Written with a status code, may be NULL
+ * Returns NULL if the file cannot be mapped or is not a circuit file
+ */
+circuit_file_t* circuit_file_open(const char* path, int* status);
+
+/*
+ * circuit_file_close
+ * Unmaps and closes a circuit file
+ * :: file : circuit_file_t* :: File to close
+ */
+void circuit_file_close(circuit_file_t* file);
+
+/*
+ * circuit_file_widget_create
+ * Creates a widget sized by the header of a circuit file
+ * :: file : const circuit_file_t* :: The circuit file
+ */
+widget_t* circuit_file_widget_create(const circuit_file_t* file);
+
+/*
+ * circuit_file_parse
+ * Streams the instructions of a circuit file into a widget
+ * :: wid : widget_t* :: Current widget
+ * :: file : circuit_file_t* :: The circuit file
+ * :: status : int* :: Written with a status code, may be NULL
+ * Instructions are passed to parse_instruction_block CIRCUIT_FILE_WINDOW at a time
+ * Each window is checked before it is parsed, the parse stops at the first bad window
+ *   CIRCUIT_FILE_ERR_FORMAT : an unknown opcode, or packed records that do not decode
+ *   CIRCUIT_FILE_ERR_QUBITS : a qubit past the initial qubits of the widget, or more RZ gates
+ *                             than the widget has qubits for
+ * Returns the number of instructions parsed
+ */
+size_t circuit_file_parse(widget_t* wid, circuit_file_t* file, int* status);
+
+#endif
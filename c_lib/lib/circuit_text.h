@@ -0,0 +1,144 @@
+#ifndef CIRCUIT_TEXT_H
+#define CIRCUIT_TEXT_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "instruction_table.h"
+#include "widget.h"
+
+/*
+ * Text circuit front ends
+ * Streams OpenQASM 2 or Stim text circuits into instruction blocks without going through Python
+ * Statements are read one at a time, so the parser only holds the statement being emitted
+ *
+ * OpenQASM 2 : qreg declarations and the Clifford + rz subset of qelib1.inc
+ *              id x y z h s sdg sx sxdg cx CX cy cz swap t tdg rz(a) u1(a) p(a)
+ *              Gates over whole registers are broadcast, creg and barrier are ignored
+ * Stim       : I X Y Z H H_XZ S SQRT_Z S_DAG SQRT_Z_DAG SQRT_X SQRT_X_DAG
+ *              CX CNOT ZCX CY ZCY CZ ZCZ SWAP, names are case insensitive
+ *              Two qubit gates take their targets in pairs
+ *              TICK, DETECTOR, OBSERVABLE_INCLUDE and the coordinate annotations are ignored
+ *              QUBIT_COORDS declares its targets
+ *
+ * Gates outside of the Clifford + rz subset, measurements, resets, classical control,
+ * gate definitions and REPEAT blocks stop the parse with CIRCUIT_TEXT_ERR_UNSUPPORTED
+ *
+ * Qubits are numbered in order of declaration, QASM registers are laid out one after another
+ * RZ angles are tagged with the bits of the angle as a 32 bit float, or zero for a zero angle,
+ * matching angle_to_tag on the Python side
+ * Gates that are not native to the instruction set are decomposed
+ *   sx = H S H, sxdg = H R H, cy = R_t CNOT S_t, swap = three CNOTs, t = rz(pi/4), tdg = rz(-pi/4)
+ */
+
+#define CIRCUIT_TEXT_QASM (0)
+#define CIRCUIT_TEXT_STIM (1)
+
+// Instructions passed to each call of parse_instruction_block
+#ifndef CIRCUIT_TEXT_WINDOW
+#define CIRCUIT_TEXT_WINDOW (1 << 14)
+#endif
+
+// Status codes
+#define CIRCUIT_TEXT_OK (0)
+#define CIRCUIT_TEXT_ERR_IO (1)
+#define CIRCUIT_TEXT_ERR_SYNTAX (2)
+#define CIRCUIT_TEXT_ERR_UNSUPPORTED (3)
+#define CIRCUIT_TEXT_ERR_QUBITS (4)
+
+/*
+ * circuit_text_register_t
+ * A QASM quantum register
+ */
+typedef struct circuit_text_register_t circuit_text_register_t;
+struct circuit_text_register_t
+{
+    char* name;
+    size_t offset; // First qubit of the register
+    size_t size;
+};
+
+typedef struct circuit_text_gate_t circuit_text_gate_t;
+
+/*
+ * circuit_text_parser_t
+ * State of a streaming parse
+ */
+typedef struct circuit_text_parser_t circuit_text_parser_t;
+struct circuit_text_parser_t
+{
+    FILE* fp; // Not owned by the parser
+    uint8_t format; // CIRCUIT_TEXT_QASM or CIRCUIT_TEXT_STIM
+    int status; // Status code, the parse stops at the first error
+    size_t line; // Line of the last statement read, counting from one
+    size_t next_line; // Line of the next character in the file
+    size_t n_qubits; // Qubits declared or used so far
+
+    // Text of the last statement read
+    char* buf;
+    size_t buf_len;
+    size_t buf_cap;
+
+    circuit_text_register_t* regs;
+    size_t n_regs;
+    size_t regs_cap;
+
+    // Statement being emitted, one application of the gate per group of targets
+    const circuit_text_gate_t* gate;
+    non_clifford_tag_t tag;
+    uint32_t* targets;
+    size_t targets_cap;
+    size_t n_apps;
+    size_t app; // Next application to emit
+    size_t op; // Next instruction of the decomposition of this application
+};
+
+/*
+ * circuit_text_parser_create
+ * Creates a parser over an open file
+ * :: fp : FILE* :: File to read from, closed by the caller
+ * :: format : const uint8_t :: CIRCUIT_TEXT_QASM or CIRCUIT_TEXT_STIM
+ */
+circuit_text_parser_t* circuit_text_parser_create(FILE* fp, const uint8_t format);
+
+/*
+ * circuit_text_parser_destroy
+ * Frees a parser
+ * :: parser : circuit_text_parser_t* :: Parser to free
+ */
+void circuit_text_parser_destroy(circuit_text_parser_t* parser);
+
+/*
+ * circuit_text_read_header
+ * Reads up to the first gate of the circuit
+ * :: parser : circuit_text_parser_t* :: The parser
+ * Returns the number of qubits declared so far, for Stim this counts QUBIT_COORDS and the targets of the first gate
+ */
+size_t circuit_text_read_header(circuit_text_parser_t* parser);
+
+/*
+ * circuit_text_read
+ * Reads the next block of instructions
+ * :: parser : circuit_text_parser_t* :: The parser
+ * :: instructions : instruction_stream_u* :: Block to write
+ * :: max_instructions : const size_t :: Length of the block
+ * Returns the number of instructions written, zero at the end of the file or on an error
+ */
+size_t circuit_text_read(
+    circuit_text_parser_t* parser,
+    instruction_stream_u* instructions,
+    const size_t max_instructions);
+
+/*
+ * circuit_text_parse
+ * Streams a text circuit into a widget
+ * :: wid : widget_t* :: Current widget
+ * :: parser : circuit_text_parser_t* :: The parser
+ * Instructions are passed to parse_instruction_block CIRCUIT_TEXT_WINDOW at a time
+ * Blocks that would use more qubits than the widget has stop the parse with CIRCUIT_TEXT_ERR_QUBITS
+ * Returns the number of instructions parsed
+ */
+size_t circuit_text_parse(widget_t* wid, circuit_text_parser_t* parser);
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef CPU_DISPATCH_H
+#define CPU_DISPATCH_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "tableau.h"
+
+/*
+ * Runtime instruction set dispatch
+ * The library is built for baseline x86-64, kernels for wider instruction sets are compiled
+ * with target attributes and selected when the library is loaded
+ *
+ * Hand written kernels are selected through the CPU_DISPATCH function pointer table
+ * Kernels that only differ by compiler flags use CPU_DISPATCH_CLONES, which lets the compiler
+ * emit one clone per instruction set along with an ifunc resolver
+ *
+ * The selection may be capped by setting CABALISER_ISA to one of scalar, avx2 or avx512
+ *
+ * The AVX2 and AVX-512 levels use the pdep/pext transposes unless pdep is microcoded on the
+ * host (AMD Zen1 and Zen2), in which case the shuffle transposes are used
+ * Setting CABALISER_TRANSPOSE to one of pdep or shuffle overrides this choice
+ */
+#define CPU_ISA_SCALAR (0)
+#define CPU_ISA_AVX2 (1) // AVX2, BMI1 and BMI2
+#define CPU_ISA_AVX512 (2) // AVX-512F in addition to the above
+
+#define CPU_ISA_ENV "CABALISER_ISA"
+
+#define CPU_TRANSPOSE_PDEP (0)
+#define CPU_TRANSPOSE_SHUFFLE (1)
+
+#define CPU_TRANSPOSE_ENV "CABALISER_TRANSPOSE"
+
+#if defined(__has_attribute)
+#if __has_attribute(target_clones)
+#define CPU_DISPATCH_CLONES __attribute__((target_clones("default", "avx2", "avx512f")))
+#endif
+#endif
+
+#ifndef CPU_DISPATCH_CLONES
+#define CPU_DISPATCH_CLONES
+#endif
+
+struct cpu_dispatch_table {
+    uint8_t isa;
+    const tableau_kernel_t* single_qubit_kernels; // Indexed by masked local Clifford opcodes
+    const tableau_two_qubit_kernel_t* two_qubit_kernels; // Indexed by masked non local opcodes
+    void (*transpose_64x64)(uint64_t* block_a[64], uint64_t* block_b[64]);
+    void (*transpose_64x64_inplace)(uint64_t* block[64]);
+    size_t (*ctz)(CHUNK_OBJ* slice, const size_t slice_len);
+    void (*transverse_hadamard)(CHUNK_OBJ* const* slices_x, CHUNK_OBJ* const* slices_z, const size_t offset, const CHUNK_OBJ mask, const size_t n_rows);
+};
+
+extern struct cpu_dispatch_table CPU_DISPATCH;
+
+/*
+ * cpu_dispatch_detect
+ * Returns the widest supported instruction set level on this host
+ */
+uint8_t cpu_dispatch_detect(void);
+
+/*
+ * cpu_dispatch_select
+ * Sets the dispatch table to the kernels for an instruction set level
+ * :: isa : const uint8_t :: Instruction set level, must be supported by the host
+ * Not thread safe, this should not be called while tableau operations are running
+ */
+void cpu_dispatch_select(const uint8_t isa);
+
+/*
+ * cpu_dispatch_transpose_detect
+ * Returns the preferred 64x64 transpose for the AVX2 and AVX-512 levels on this host
+ */
+uint8_t cpu_dispatch_transpose_detect(void);
+
+/*
+ * cpu_dispatch_select_transpose
+ * Sets the 64x64 transpose used by the AVX2 and AVX-512 levels, takes effect immediately
+ * if one of those levels is selected
+ * :: transpose : const uint8_t :: One of CPU_TRANSPOSE_PDEP or CPU_TRANSPOSE_SHUFFLE
+ * Not thread safe, this should not be called while tableau operations are running
+ */
+void cpu_dispatch_select_transpose(const uint8_t transpose);
+
+/*
+ * cpu_dispatch_isa_name
+ * Returns a printable name for an instruction set level
+ * :: isa : const uint8_t :: Instruction set level
+ */
+const char* cpu_dispatch_isa_name(const uint8_t isa);
+
+#endif
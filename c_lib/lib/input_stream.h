@@ -4,9 +4,15 @@
 
 #include "instructions.h"
 #include "tableau_operations.h"
+#include "tableau_fused_operations.h"
 #include "conditional_operations.h"
 #include "widget.h"
 
+// Number of instructions resolved before each chunk range replay
+#ifndef REPLAY_WINDOW
+#define REPLAY_WINDOW (1 << 14)
+#endif
+
 
 /*
  * parse_instruction_block
@@ -14,7 +20,11 @@
  * :: wid : widget_t* :: Current widget 
  * :: instructions : instruction_stream_u* :: Array of instructions 
  * :: n_instructions : const size_t :: Number of instructions in the stream 
- * This implementation may be replaced with a thread pool dispatcher
+ * With INGEST_CHUNK_REPLAY each window of REPLAY_WINDOW instructions is replayed over the tableau
+ * in a single parallel region, with INGEST_DISPATCH each tableau operation forks its own team
+ * INGEST_THREADED applies operations as INGEST_DISPATCH does, but jumps directly between inlined
+ * handlers rather than calling through instruction_switch, and runs of local Cliffords are
+ * folded into the queue in a single loop
  */
 void parse_instruction_block(
     widget_t* wid,
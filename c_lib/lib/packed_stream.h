@@ -0,0 +1,121 @@
+#ifndef PACKED_STREAM_H
+#define PACKED_STREAM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "instruction_table.h"
+#include "widget.h"
+
+/*
+ * Packed instruction streams
+ * instruction_stream_u is padded out to its largest member, so every instruction takes
+ * sizeof(instruction_stream_u) bytes regardless of its type
+ * The packed encoding stores each instruction as its opcode byte followed by its fields as
+ * LEB128 varints, seven bits per byte with the high bit set on every byte but the last
+ *
+ *   Local Clifford      : opcode, arg
+ *   Non local Clifford  : opcode, ctrl, zigzag(targ - ctrl)
+ *   RZ                  : opcode, arg, zigzag(tag - previous tag)
+ *   Conditional         : opcode, ctrl, zigzag(targ - ctrl)
+ *
+ * Two qubit gates are mostly local, so the target is stored relative to the control
+ * Tags are stored relative to the tag of the previous RZ in the stream, starting from zero
+ * Signed differences are zigzag coded so that small negative differences stay short
+ */
+
+// Longest encoding of a single instruction, an opcode and two five byte varints
+#define PACKED_STREAM_MAX_INSTRUCTION_BYTES (1 + 2 * 5)
+
+// Decoder status codes
+#define PACKED_STREAM_OK (0)
+#define PACKED_STREAM_ERR_TRUNCATED (1) // The buffer ends inside an instruction, or a varint is too long
+#define PACKED_STREAM_ERR_OPCODE (2) // An opcode of no known instruction type
+
+// Number of instructions decoded into each block passed to parse_instruction_block
+#ifndef PACKED_STREAM_WINDOW
+#define PACKED_STREAM_WINDOW (1 << 14)
+#endif
+
+/*
+ * packed_stream_decoder_t
+ * Position of a streaming decode within a packed buffer
+ * The previous tag is carried between calls, so a buffer may be decoded in any number of blocks
+ */
+typedef struct packed_stream_decoder_t packed_stream_decoder_t;
+struct packed_stream_decoder_t
+{
+    const uint8_t* bytes; // Packed buffer
+    size_t n_bytes; // Length of the packed buffer
+    size_t pos; // Next byte to decode
+    non_clifford_tag_t tag; // Tag of the last RZ decoded
+    int status; // Decoding stops at the first malformed instruction
+};
+
+/*
+ * packed_stream_bound
+ * Upper bound on the packed size of a stream
+ * :: n_instructions : const size_t :: Number of instructions
+ */
+static inline
+size_t packed_stream_bound(const size_t n_instructions)
+{
+    return n_instructions * PACKED_STREAM_MAX_INSTRUCTION_BYTES;
+}
+
+/*
+ * packed_stream_encode
+ * Packs an array of instructions
+ * :: instructions : const instruction_stream_u* :: Array of instructions
+ * :: n_instructions : const size_t :: Number of instructions
+ * :: bytes : uint8_t* :: Packed buffer, at least packed_stream_bound(n_instructions) bytes
+ * Returns the number of bytes written
+ */
+size_t packed_stream_encode(
+    const instruction_stream_u* instructions,
+    const size_t n_instructions,
+    uint8_t* bytes);
+
+/*
+ * packed_stream_decoder_init
+ * Starts a decode at the beginning of a packed buffer
+ * :: dec : packed_stream_decoder_t* :: Decoder to initialise
+ * :: bytes : const uint8_t* :: Packed buffer
+ * :: n_bytes : const size_t :: Length of the packed buffer
+ */
+void packed_stream_decoder_init(
+    packed_stream_decoder_t* dec,
+    const uint8_t* bytes,
+    const size_t n_bytes);
+
+/*
+ * packed_stream_decode
+ * Unpacks the next block of instructions
+ * :: dec : packed_stream_decoder_t* :: Decoder state
+ * :: instructions : instruction_stream_u* :: Array to write to
+ * :: max_instructions : const size_t :: Length of the array
+ * Returns the number of instructions written, zero once the buffer is exhausted
+ * A malformed instruction sets the status of the decoder and is not written, later calls return zero
+ */
+size_t packed_stream_decode(
+    packed_stream_decoder_t* dec,
+    instruction_stream_u* instructions,
+    const size_t max_instructions);
+
+/*
+ * parse_packed_block
+ * Parses a packed buffer of instructions
+ * :: wid : widget_t* :: Current widget
+ * :: bytes : const uint8_t* :: Packed buffer
+ * :: n_bytes : const size_t :: Length of the packed buffer
+ * Instructions are decoded PACKED_STREAM_WINDOW at a time and passed to parse_instruction_block,
+ * so only the packed buffer and a single window are held in memory
+ * Parsing stops at the first malformed instruction
+ * Returns the number of instructions parsed
+ */
+size_t parse_packed_block(
+    widget_t* wid,
+    const uint8_t* bytes,
+    const size_t n_bytes);
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef PEEPHOLE_H
+#define PEEPHOLE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "instruction_table.h"
+
+/*
+ * Clifford peephole simplification
+ * A pass over an instruction stream before it is parsed, removing gates that cancel
+ *
+ *   Two qubit gates : CNOT CNOT and CZ CZ on the same pair of qubits cancel
+ *   Local Cliffords : adjacent gates on a qubit are merged, pairs that multiply to the identity cancel
+ *
+ * Gates between a pair are skipped if they do not act on the pair or commute with the pair
+ *   CZ   : diagonal gates on either qubit, CZ sharing one qubit, CNOT controlled on either qubit
+ *   CNOT : diagonal gates on the control, X on the target,
+ *          CZ or CNOT sharing only the control, CNOT sharing only the target
+ * Paulis on the pair are pushed through the first gate of the pair, picking up a Pauli on the
+ * other qubit of the pair, the gates that are skipped over always commute with this Pauli
+ * so the picked up Paulis are written into the slots of the cancelled gates
+ *
+ * Searches are bounded by a window of PEEPHOLE_WINDOW instructions
+ * RZ and measurement conditioned instructions are never moved and stop searches on their qubits
+ */
+
+// Instructions searched ahead of each gate
+#ifndef PEEPHOLE_WINDOW
+#define PEEPHOLE_WINDOW (64)
+#endif
+
+// Passes over the stream, stopping early once a pass removes nothing
+#ifndef PEEPHOLE_MAX_PASSES
+#define PEEPHOLE_MAX_PASSES (4)
+#endif
+
+/*
+ * peephole_stats_t
+ * Work done by peephole_simplify
+ */
+typedef struct peephole_stats_t peephole_stats_t;
+struct peephole_stats_t
+{
+    size_t n_removed; // Instructions removed from the stream
+    size_t n_cancelled; // Pairs of two qubit gates cancelled
+    size_t n_merged; // Pairs of local Cliffords merged or cancelled
+    size_t n_pushed; // Paulis pushed through a cancelled pair
+};
+
+/*
+ * peephole_simplify
+ * Removes cancelling gates from an instruction stream
+ * :: instructions : instruction_stream_u* :: Array of instructions, simplified in place
+ * :: n_instructions : const size_t :: Number of instructions
+ * :: stats : peephole_stats_t* :: Accumulates the work done, may be NULL
+ * Kept instructions are compacted to the front of the array in their original order
+ * Returns the number of instructions kept
+ */
+size_t peephole_simplify(
+    instruction_stream_u* instructions,
+    const size_t n_instructions,
+    peephole_stats_t* stats);
+
+#endif
@@ -23,13 +23,30 @@ typedef uint8_t uint8_ta16 __attribute__((aligned(16)));
 typedef uint64_t uint64_ta64 ;//__attribute__((aligned(32))); 
 
 
+/*
+ * The simd transposes require AVX2 and BMI2
+ * They are compiled with a target attribute and are only called on supporting hosts,
+ * see cpu_dispatch.h. The chunk transposes are the portable fallback
+ */
+#define SIMD_TRANSPOSE_TARGET __attribute__((target("avx2,bmi2")))
+
 void simd_transpose_2x16(uint8_t** src, uint8_t** targ);
 void simd_transpose_64x64(uint64_t* src[64], uint64_t* targ[64]);
 void simd_transpose_64x64_inplace(uint64_t* src[64]);
 
+/*
+ * The shuffle transposes only require AVX2
+ * pdep and pext are microcoded on AMD Zen1 and Zen2, these are dispatched to on those hosts
+ */
+#define SHUFFLE_TRANSPOSE_TARGET __attribute__((target("avx2")))
+
+void shuffle_transpose_64x64(uint64_t* src[64], uint64_t* targ[64]);
+void shuffle_transpose_64x64_inplace(uint64_t* src[64]);
+
 
 void chunk_transpose_2x16(uint8_t** src, uint8_t** targ);
 void chunk_transpose_64x64(uint64_t* src[64], uint64_t* targ[64]);
+void chunk_transpose_64x64_inplace(uint64_t* src[64]);
 
 void transpose_naive(uint64_t** block, size_t size);
 
@@ -9,6 +9,52 @@
 
 typedef struct tableau_t tableau_t;
 
+#define CHUNK_OBJ uint64_t
+
+/*
+ * Chunk range kernels
+ * Apply an operation to the chunks [start, end) of the given slices 
+ * Slice pointer swaps are handled by the caller 
+ */
+typedef void (*tableau_kernel_t)(
+    CHUNK_OBJ* restrict slice_x,
+    CHUNK_OBJ* restrict slice_z,
+    CHUNK_OBJ* restrict slice_r,
+    const size_t start,
+    const size_t end);
+
+typedef void (*tableau_two_qubit_kernel_t)(
+    CHUNK_OBJ* restrict ctrl_slice_x,
+    CHUNK_OBJ* restrict ctrl_slice_z,
+    CHUNK_OBJ* restrict targ_slice_x,
+    CHUNK_OBJ* restrict targ_slice_z,
+    CHUNK_OBJ* restrict slice_r,
+    const size_t start,
+    const size_t end);
+
+/*
+ * Pivot strategies
+ * TABLEAU_PIVOT_FIRST takes the first row with a 1 in the pivot column, as tableau_X_diag_element
+ * TABLEAU_PIVOT_MARKOWITZ takes the lowest weight row of the first TABLEAU_PIVOT_CANDIDATES rows
+ * with a 1 in the pivot column, which reduces the fill added to the rows it is summed into
+ * Both strategies place the same hadamards and reach the same reduced tableau, they differ in
+ * the row sums needed to get there and in which rows the phases end up on
+ */
+#define TABLEAU_PIVOT_FIRST (0)
+#define TABLEAU_PIVOT_MARKOWITZ (1)
+#define TABLEAU_PIVOT_CANDIDATES (16)
+
+/*
+ * tableau_elim_stats_t
+ * Work done by an elimination, used to compare pivot strategies
+ */
+typedef struct tableau_elim_stats_t tableau_elim_stats_t;
+struct tableau_elim_stats_t
+{
+    size_t row_sums; // Rows added to other rows
+    size_t chunk_xors; // Chunks XORed for those row sums, including building the M4RM tables
+};
+
 #include "consts.h"
 #include "debug.h"
 #include "instructions.h"
@@ -28,13 +74,94 @@ typedef struct tableau_t tableau_t;
 #define SLICE_LEN_SIZE_T(n_qubits) ((n_qubits / (8 * sizeof(size_t))) + !!(n_qubits % sizeof(size_t)))
 
 
-#define CHUNK_OBJ uint64_t
-
 #define CHUNK_SIZE_BYTES (sizeof(CHUNK_OBJ))
 #define CHUNK_SIZE_BITS (CHUNK_SIZE_BYTES * BITS_TO_BYTE)
 #define CACHE_CHUNKS (CACHE_SIZE / CHUNK_SIZE_BYTES) 
 #define __CHUNK_CTZ __builtin_ctzll 
 
+/*
+ * Storage layouts
+ * TABLEAU_LAYOUT_SLICES stores each slice contiguously
+ * TABLEAU_LAYOUT_TILES stores the X and Z blocks as 64x64 bit tiles of 512 contiguous bytes,
+ * tile (i, j) holds chunk j of the slices for qubits 64i to 64i + 63 with one slice per row
+ *
+ * In the tiled layout consecutive chunks of a slice are TABLEAU_CHUNK_STRIDE chunks apart
+ * Slice pointers, TABLEAU_CHUNK and TABLEAU_FOR_EACH_CHUNK hide the layout from the kernels
+ * The phases use the same stride so that every slice is indexed identically
+ */
+#define TABLEAU_LAYOUT_SLICES (0)
+#define TABLEAU_LAYOUT_TILES (1)
+
+#ifndef TABLEAU_LAYOUT
+#define TABLEAU_LAYOUT TABLEAU_LAYOUT_SLICES
+#endif
+
+#define TABLEAU_TILE_CHUNKS (CHUNK_SIZE_BITS)
+
+#if TABLEAU_LAYOUT == TABLEAU_LAYOUT_TILES
+#define TABLEAU_CHUNK_STRIDE (TABLEAU_TILE_CHUNKS)
+#else
+#define TABLEAU_CHUNK_STRIDE (1)
+#endif
+
+// Chunk idx of a slice
+#define TABLEAU_CHUNK(slice, idx) ((slice)[(idx) * TABLEAU_CHUNK_STRIDE])
+
+// Iterates i over the offsets of the chunks [start, end) of a slice
+#define TABLEAU_FOR_EACH_CHUNK(i, start, end) \
+    for (size_t i = (start) * TABLEAU_CHUNK_STRIDE; i < (end) * TABLEAU_CHUNK_STRIDE; i += TABLEAU_CHUNK_STRIDE)
+
+/*
+ * Sparse slices
+ * In sparse mode the tableau keeps a bitmap for each qubit with one bit per chunk, a set bit
+ * marks a chunk in which the X or Z slice of that qubit may be non zero
+ * Every gate maps an all zero row to itself, so kernels only visit runs of occupied chunks
+ * A qubit occupying more than 1 / TABLEAU_SPARSE_DENSITY of the active chunks is swept densely
+ * Operations that write slices without maintaining the bitmaps, such as the transpose, leave
+ * sparse mode and the tableau is dense from then on
+ */
+#ifndef TABLEAU_SPARSE_DENSITY
+#define TABLEAU_SPARSE_DENSITY (8)
+#endif
+
+/*
+ * TABLEAU_COL_ELIM_ROWS
+ * Rows that tableau_rows_xor XORs a control row into in a single pass
+ */
+#define TABLEAU_COL_ELIM_ROWS (8)
+
+/*
+ * Allocation policy
+ * Slices are mapped anonymously and first touched in parallel, a page at a time
+ * Each page is written by the thread whose chunk ranges cover most of it, so pages within a slice
+ * land on the NUMA node of the thread that sweeps them
+ * Short slices share pages between threads, those pages are dealt out in turn and have no local owner
+ * TABLEAU_ALLOC_HUGEPAGE advises transparent huge pages for allocations of at least one huge page
+ * TABLEAU_ALLOC_HUGETLB maps from the reserved huge page pool, falling back if it is exhausted
+ * TABLEAU_ALLOC_INTERLEAVE interleaves pages over the allowed NUMA nodes instead of placing them locally
+ * Flags that could not be applied are left out of the alloc_applied field of the tableau
+ * The policy is read from CABALISER_TABLEAU_ALLOC as a comma separated list of hugepage, hugetlb
+ * and interleave when the library is loaded
+ */
+#define TABLEAU_ALLOC_HUGEPAGE (1 << 0)
+#define TABLEAU_ALLOC_HUGETLB (1 << 1)
+#define TABLEAU_ALLOC_INTERLEAVE (1 << 2)
+#define TABLEAU_ALLOC_DEFAULT (TABLEAU_ALLOC_HUGEPAGE)
+
+#define TABLEAU_ALLOC_ENV "CABALISER_TABLEAU_ALLOC"
+#define TABLEAU_HUGE_PAGE_SIZE (1ull << 21)
+#define TABLEAU_MAX_NUMA_NODES (1024)
+
+/*
+ * TABLEAU_PARALLEL_THRESHOLD
+ * Default slice length in chunks below which gate kernels run serially  
+ * Forking a team costs several microseconds, which is comparable to a serial sweep over a few 
+ * thousand chunks. This can be measured for a given host with tableau_calibrate_parallel_threshold
+ * and set for each widget with widget_set_parallel_threshold
+ */
+#ifndef TABLEAU_PARALLEL_THRESHOLD
+#define TABLEAU_PARALLEL_THRESHOLD (1 << 12)
+#endif
 
 struct aligned_chunk {
    CHUNK_OBJ components[CACHE_CHUNKS]; 
@@ -50,6 +177,14 @@ struct tableau_t {
     tableau_slice_p* slices_z; // Slice representation pointers 
     tableau_slice_p phases; // Phase terms
     bool orientation; // Row or column major order
+    size_t parallel_threshold; // Slice length in chunks below which kernels run serially
+    size_t n_blocks; // Tiles along each side of the X and Z blocks in the tiled layout
+    size_t active_len; // Chunks of each slice that may differ from the identity tableau 
+    CHUNK_OBJ* occupancy; // Occupied chunks of each qubit in sparse mode, NULL when dense
+    size_t occupancy_len; // Words of the occupancy bitmap for each qubit
+    size_t chunks_bytes; // Mapped size of the X and Z blocks
+    size_t phases_bytes; // Mapped size of the phases
+    uint8_t alloc_applied; // TABLEAU_ALLOC flags that took effect when mapping the X and Z blocks
 };
 
 /*
@@ -60,6 +195,53 @@ struct tableau_t {
  */
 tableau_t* tableau_create(const size_t n_qubits);
 
+/*
+ * tableau_set_alloc_policy
+ * tableau_get_alloc_policy
+ * Sets or gets the policy used to allocate new tableaus
+ * :: policy : const uint8_t :: Bitwise or of TABLEAU_ALLOC flags
+ */
+void tableau_set_alloc_policy(const uint8_t policy);
+uint8_t tableau_get_alloc_policy(void);
+
+/*
+ * tableau_grow
+ * Extends the tableau to a larger number of qubits
+ * :: tab : tableau_t* :: The tableau
+ * :: n_qubits : const size_t :: New number of qubits, not less than the current number
+ * The existing tableau is embedded in the top left of the new tableau, new qubits start in the
+ * Z_j state with zero phase
+ * Slice pointers are reset to their canonical order, the tableau pointer itself is unchanged
+ */
+void tableau_grow(tableau_t* tab, const size_t n_qubits);
+
+/*
+ * tableau_set_active_qubits
+ * Bounds the region of the tableau that kernels operate over
+ * :: tab : tableau_t* :: The tableau
+ * :: n_qubits : const size_t :: Number of qubits that may have been acted on
+ * Qubits past the bound must still be in the Z_j state with zero phase, so every row past the
+ * bound is zero in every active slice and gate kernels need only sweep the first active_len chunks
+ * A new tableau is entirely active
+ */
+void tableau_set_active_qubits(tableau_t* tab, const size_t n_qubits);
+
+/*
+ * tableau_sparse_enable
+ * Enters sparse mode, building the occupancy bitmaps from the current slices
+ * :: tab : tableau_t* :: The tableau
+ * Has no effect if the tableau is already sparse
+ */
+void tableau_sparse_enable(tableau_t* tab);
+
+/*
+ * tableau_sparse_disable
+ * Leaves sparse mode, after which every kernel sweeps the whole active region
+ * :: tab : tableau_t* :: The tableau
+ * Slices are always stored densely, so this only discards the occupancy bitmaps
+ */
+void tableau_sparse_disable(tableau_t* tab);
+
 
 /*
  * tableau_destroy 
@@ -90,8 +272,8 @@ void __inline_slice_set_bit(
     const uint8_t value)
 {
 
-    slice[index / CHUNK_SIZE_BITS] &= ~(1ull << (index % CHUNK_SIZE_BITS)); 
-    slice[index / CHUNK_SIZE_BITS] |= (1ull & value) << (index % CHUNK_SIZE_BITS); 
+    TABLEAU_CHUNK(slice, index / CHUNK_SIZE_BITS) &= ~(1ull << (index % CHUNK_SIZE_BITS)); 
+    TABLEAU_CHUNK(slice, index / CHUNK_SIZE_BITS) |= (1ull & value) << (index % CHUNK_SIZE_BITS); 
 
     return; 
 }
@@ -101,8 +283,8 @@ void __atomic_inline_slice_set_bit(
     const size_t index,
     const uint8_t value)
 {
-    __atomic_and_fetch(slice + (index / CHUNK_SIZE_BITS), ~(1ull << (index % CHUNK_SIZE_BITS)), __ATOMIC_ACQUIRE); 
-    __atomic_or_fetch(slice + (index / CHUNK_SIZE_BITS), (1ull & value) << (index % CHUNK_SIZE_BITS), __ATOMIC_RELEASE); 
+    __atomic_and_fetch(&TABLEAU_CHUNK(slice, index / CHUNK_SIZE_BITS), ~(1ull << (index % CHUNK_SIZE_BITS)), __ATOMIC_ACQUIRE); 
+    __atomic_or_fetch(&TABLEAU_CHUNK(slice, index / CHUNK_SIZE_BITS), (1ull & value) << (index % CHUNK_SIZE_BITS), __ATOMIC_RELEASE); 
 
     return; 
 }
@@ -121,7 +303,185 @@ uint8_t __inline_slice_get_bit(
     const size_t index)
 {
     CHUNK_OBJ mask = 1ull << (index % CHUNK_SIZE_BITS);
-    return !!(slice[index / CHUNK_SIZE_BITS] & mask); 
+    return !!(TABLEAU_CHUNK(slice, index / CHUNK_SIZE_BITS) & mask); 
+}
+
+/*
+ * __inline_tableau_active_qubits
+ * Number of qubits covered by the active chunk bound
+ * :: tab : const tableau_t* :: The tableau
+ * Qubits at or past this index are untouched
+ */
+static inline
+size_t __inline_tableau_active_qubits(const tableau_t* tab)
+{
+    const size_t n_active = tab->active_len * CHUNK_SIZE_BITS;
+    return (n_active < tab->n_qubits) ? n_active : tab->n_qubits;
+}
+
+/*
+ * __inline_tableau_occupancy
+ * Occupancy bitmap of a qubit in sparse mode
+ * :: tab : const tableau_t* :: The tableau
+ * :: qubit : const size_t :: The qubit
+ */
+static inline
+CHUNK_OBJ* __inline_tableau_occupancy(const tableau_t* tab, const size_t qubit)
+{
+    return tab->occupancy + qubit * tab->occupancy_len;
+}
+
+/*
+ * __inline_tableau_occupancy_union
+ * Marks the chunks occupied by either qubit as occupied by both
+ * :: tab : tableau_t* :: The tableau
+ * :: ctrl : const size_t :: First qubit
+ * :: targ : const size_t :: Second qubit
+ * Two qubit gates mix the rows of both qubits, the union bounds the occupancy after the gate
+ */
+static inline
+void __inline_tableau_occupancy_union(tableau_t* tab, const size_t ctrl, const size_t targ)
+{
+    CHUNK_OBJ* occ_ctrl = __inline_tableau_occupancy(tab, ctrl);
+    CHUNK_OBJ* occ_targ = __inline_tableau_occupancy(tab, targ);
+    const size_t n_words = tab->active_len / CHUNK_SIZE_BITS + !!(tab->active_len % CHUNK_SIZE_BITS);
+    for (size_t i = 0; i < n_words; i++)
+    {
+        const CHUNK_OBJ occ = occ_ctrl[i] | occ_targ[i];
+        occ_ctrl[i] = occ;
+        occ_targ[i] = occ;
+    }
+}
+
+/*
+ * __inline_tableau_occupancy_swap
+ * Exchanges the occupancy bitmaps of two qubits when their slices are exchanged
+ * :: tab : tableau_t* :: The tableau
+ * :: i : const size_t :: First qubit
+ * :: j : const size_t :: Second qubit
+ */
+static inline
+void __inline_tableau_occupancy_swap(tableau_t* tab, const size_t i, const size_t j)
+{
+    if (NULL == tab->occupancy)
+    {
+        return;
+    }
+
+    CHUNK_OBJ* occ_i = __inline_tableau_occupancy(tab, i);
+    CHUNK_OBJ* occ_j = __inline_tableau_occupancy(tab, j);
+    for (size_t k = 0; k < tab->occupancy_len; k++)
+    {
+        const CHUNK_OBJ tmp = occ_i[k];
+        occ_i[k] = occ_j[k];
+        occ_j[k] = tmp;
+    }
+}
+
+/*
+ * __inline_tableau_sparse
+ * Whether kernels acting on a qubit should only visit its occupied chunks
+ * :: tab : const tableau_t* :: The tableau
+ * :: qubit : const size_t :: The qubit
+ */
+static inline
+bool __inline_tableau_sparse(const tableau_t* tab, const size_t qubit)
+{
+    if (NULL == tab->occupancy)
+    {
+        return false;
+    }
+
+    const CHUNK_OBJ* occ = __inline_tableau_occupancy(tab, qubit);
+    const size_t n_words = tab->active_len / CHUNK_SIZE_BITS + !!(tab->active_len % CHUNK_SIZE_BITS);
+    size_t n_occupied = 0;
+    for (size_t i = 0; i < n_words; i++)
+    {
+        n_occupied += __builtin_popcountll(occ[i]);
+    }
+    return n_occupied * TABLEAU_SPARSE_DENSITY <= tab->active_len;
+}
+
+/*
+ * __inline_tableau_next_run
+ * Finds the next run of occupied chunks
+ * :: occ : const CHUNK_OBJ* :: Occupancy bitmap
+ * :: pos : size_t* :: First chunk to search from, set to one past the end of the run
+ * :: end : const size_t :: One past the last chunk to search
+ * :: run_start : size_t* :: Set to the first chunk of the run
+ * Returns false if there are no occupied chunks in [pos, end)
+ */
+static inline
+bool __inline_tableau_next_run(const CHUNK_OBJ* occ, size_t* pos, const size_t end, size_t* run_start)
+{
+    size_t i = *pos;
+    while (i < end)
+    {
+        const CHUNK_OBJ word = occ[i / CHUNK_SIZE_BITS] >> (i % CHUNK_SIZE_BITS);
+        if (word)
+        {
+            i += __CHUNK_CTZ(word);
+            break;
+        }
+        i += CHUNK_SIZE_BITS - (i % CHUNK_SIZE_BITS);
+    }
+
+    if (i >= end)
+    {
+        *pos = end;
+        return false;
+    }
+    *run_start = i;
+
+    while (i < end)
+    {
+        // Bits shifted in from the top read as occupied 
+        const CHUNK_OBJ word = ~occ[i / CHUNK_SIZE_BITS] >> (i % CHUNK_SIZE_BITS);
+        if (word)
+        {
+            i += __CHUNK_CTZ(word);
+            break;
+        }
+        i += CHUNK_SIZE_BITS - (i % CHUNK_SIZE_BITS);
+    }
+
+    *pos = (i < end) ? i : end;
+    return true;
+}
+
+/*
+ * __inline_tableau_chunk_range
+ * Splits the chunks of a slice into disjoint ranges, one per thread
+ * :: slice_len : const size_t :: Number of chunks in the slice
+ * :: thread : const size_t :: Index of this thread
+ * :: n_threads : const size_t :: Number of threads
+ * :: start : size_t* :: First chunk owned by this thread
+ * :: end : size_t* :: One past the last chunk owned by this thread
+ * Ranges are aligned to cache lines to avoid false sharing, trailing threads may receive an empty range
+ */
+static inline
+void __inline_tableau_chunk_range(
+    const size_t slice_len,
+    const size_t thread,
+    const size_t n_threads,
+    size_t* start,
+    size_t* end)
+{
+    const size_t n_lines = slice_len / CACHE_CHUNKS + !!(slice_len % CACHE_CHUNKS);
+    const size_t lines_per_thread = n_lines / n_threads + !!(n_lines % n_threads);
+
+    *start = thread * lines_per_thread * CACHE_CHUNKS;
+    *end = *start + lines_per_thread * CACHE_CHUNKS;
+
+    if (*start > slice_len)
+    {
+        *start = slice_len;
+    }
+    if (*end > slice_len)
+    {
+        *end = slice_len;
+    }
+    return;
 }
 
 /*
@@ -137,9 +497,16 @@ void tableau_print(const tableau_t* tab);
  * :: tab : tableau_t* :: Tableau to transpose
  * Flips the orientation field and the member fields
  * This flips the alignment of the cache lines
+ * Sizes that are not a multiple of 64 are zero padded to whole 64x64 blocks
  * TODO simd port swap based nlogn bitvector transpose 
  */
 void tableau_transpose(tableau_t* tab);
+
+/*
+ * tableau_transpose_naive
+ * Bit by bit transpose of the slice layout, used as a reference for regression testing
+ * :: tab : tableau_t* :: Tableau to transpose
+ */
 void tableau_transpose_naive(tableau_t* tab);
 
 /*
@@ -152,6 +519,30 @@ void tableau_transpose_naive(tableau_t* tab);
  */
 void tableau_slice_xor(tableau_t* tab, const size_t ctrl, const size_t targ);
 
+/*
+ * tableau_rows_xor
+ * Adds one row to a list of rows
+ * :: tab : tableau_t* :: Transposed tableau
+ * :: ctrl : const size_t :: Row to add
+ * :: targs : const size_t* :: Rows to add it to, these must not include ctrl
+ * :: n_targs : const size_t :: Number of target rows
+ * Rows are XORed in batches of TABLEAU_COL_ELIM_ROWS so that each control chunk is loaded once
+ * per batch, leading zero chunks of the control row are skipped
+ * Returns the number of chunks XORed
+ */
+size_t tableau_rows_xor(tableau_t* tab, const size_t ctrl, const size_t* targs, const size_t n_targs);
+
+/*
+ * tableau_col_elim_X
+ * Adds the pivot row to every row in a range with an X bit in the pivot column
+ * :: tab : tableau_t* :: Transposed tableau
+ * :: idx : const size_t :: Pivot row and column
+ * :: start : const size_t :: First row to eliminate
+ * :: end : const size_t :: One past the last row to eliminate, the range must not contain idx
+ * Returns the number of chunks XORed
+ */
+size_t tableau_col_elim_X(tableau_t* tab, const size_t idx, const size_t start, const size_t end);
+
 /*
  * tableau_slice_empty_x
  * Fast operation for checking if an x slice is empty
@@ -176,16 +567,35 @@ bool tableau_slice_empty_z(const tableau_t* tab, size_t idx);
  */
 size_t tableau_ctz(CHUNK_OBJ* slice, const size_t len);
 
+/*
+ * tableau_ctz_scalar
+ * Portable implementation of tableau_ctz
+ * tableau_ctz dispatches to this or to an instruction set specific version at runtime
+ */
+size_t tableau_ctz_scalar(CHUNK_OBJ* slice, const size_t len);
+
 /*
  * tableau_transverse_hadamard
  * Applies a hadamard when transposed 
  * :: tab : tableau_t*  :: Tableau object
  * :: c_que :  clifford_queue_t* :: Clifford queue 
  * :: i : const size_t :: Index to target 
- *
+ * Dispatches to the widest supported row kernel
  */
 void tableau_transverse_hadamard(tableau_t const* tab, const size_t targ);
 
+/*
+ * tableau_transverse_hadamard_scalar
+ * Portable row kernel of tableau_transverse_hadamard
+ * :: slices_x : CHUNK_OBJ* const* :: X slice of each row
+ * :: slices_z : CHUNK_OBJ* const* :: Z slice of each row
+ * :: offset : const size_t :: Offset of the chunk holding the column within each slice
+ * :: mask : const CHUNK_OBJ :: Bit of the column within that chunk
+ * :: n_rows : const size_t :: Number of rows
+ * Only rows whose X and Z bits differ are written
+ */
+void tableau_transverse_hadamard_scalar(CHUNK_OBJ* const* slices_x, CHUNK_OBJ* const* slices_z, const size_t offset, const CHUNK_OBJ mask, const size_t n_rows);
+
 /*
  * tableau_idx_swap_transverse 
  * Swaps indicies over both the X and Z slices  
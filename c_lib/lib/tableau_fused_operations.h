@@ -0,0 +1,102 @@
+#ifndef TABLEAU_FUSED_OPERATIONS_H
+#define TABLEAU_FUSED_OPERATIONS_H
+
+#include "omp.h"
+#include "tableau.h"
+#include "instructions.h"
+#include "instruction_table.h"
+
+/*
+ * Fused two qubit operations
+ * Flushing the queued local Cliffords on the control and target and then applying a CNOT or CZ
+ * costs three sweeps over the tableau. The fused kernels perform the entire update in a single
+ * pass over the X, Z and phase slices.
+ *
+ * One kernel is generated for each (ctrl Clifford, targ Clifford, two qubit gate) triple
+ * Kernels are indexed as FUSED_TWO_QUBIT_OPERATIONS[gate][ctrl_clifford][targ_clifford]
+ * with each index masked by INSTRUCTION_OPERATOR_MASK
+ *
+ * Unlike the unfused single qubit operations, Hadamard type Cliffords are resolved by
+ * writing the swapped values back rather than swapping slice pointers
+ *
+ * Each kernel acts on the chunk range [start, end) of the slices, the caller is responsible for
+ * distributing ranges between threads
+ */
+typedef void (*tableau_fused_operation_t)(
+    tableau_t*,
+    const size_t ctrl,
+    const size_t targ,
+    const size_t start,
+    const size_t end);
+
+extern const tableau_fused_operation_t FUSED_TWO_QUBIT_OPERATIONS[N_NON_LOCAL_CLIFFORDS][N_LOCAL_CLIFFORDS][N_LOCAL_CLIFFORDS];
+
+#define FUSED_TWO_QUBIT_OPERATION(gate, ctrl_cliff, targ_cliff) ( \
+    FUSED_TWO_QUBIT_OPERATIONS \
+        [(gate) & INSTRUCTION_OPERATOR_MASK] \
+        [(ctrl_cliff) & INSTRUCTION_OPERATOR_MASK] \
+        [(targ_cliff) & INSTRUCTION_OPERATOR_MASK])
+
+
+/*
+ * tableau_fused_instruction
+ * A resolved fused operation, used for deferred replay over the tableau
+ */
+struct tableau_fused_instruction
+{
+    tableau_fused_operation_t op;
+    uint32_t ctrl;
+    uint32_t targ;
+};
+
+
+/*
+ * tableau_fused_operation_apply
+ * Applies a fused operation over the entire tableau
+ * :: tab : tableau_t* :: The tableau to operate on
+ * :: op : tableau_fused_operation_t :: The fused kernel
+ * :: ctrl : const size_t :: The control qubit
+ * :: targ : const size_t :: The target qubit
+ * Acts in place on the tableau
+ */
+void tableau_fused_operation_apply(
+    tableau_t* tab,
+    tableau_fused_operation_t op,
+    const size_t ctrl,
+    const size_t targ);
+
+
+/*
+ * tableau_fused_two_qubit_operation
+ * Applies a pair of local Cliffords followed by a two qubit gate in a single pass
+ * :: tab : tableau_t* :: The tableau to operate on
+ * :: gate : const instruction_t :: Two qubit gate opcode, either _CNOT_ or _CZ_
+ * :: ctrl_cliff : const instruction_t :: Local Clifford applied to the control before the gate
+ * :: targ_cliff : const instruction_t :: Local Clifford applied to the target before the gate
+ * :: ctrl : const size_t :: The control qubit
+ * :: targ : const size_t :: The target qubit
+ * Acts in place on the tableau
+ */
+void tableau_fused_two_qubit_operation(
+    tableau_t* tab,
+    const instruction_t gate,
+    const instruction_t ctrl_cliff,
+    const instruction_t targ_cliff,
+    const size_t ctrl,
+    const size_t targ);
+
+
+/*
+ * tableau_fused_replay
+ * Replays a sequence of fused operations in a single parallel region
+ * :: tab : tableau_t* :: The tableau to operate on
+ * :: ops : const struct tableau_fused_instruction* :: Sequence of fused operations
+ * :: n_ops : const size_t :: Number of operations
+ * Each thread applies the whole sequence to a disjoint range of chunks
+ */
+void tableau_fused_replay(
+    tableau_t* tab,
+    const struct tableau_fused_instruction* ops,
+    const size_t n_ops);
+
+#endif
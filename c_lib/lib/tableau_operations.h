@@ -6,6 +6,7 @@
 #include "omp.h"
 #include "tableau.h"
 #include "instructions.h"
+#include "tableau_simd_operations.h"
 
 #define OPT_PRAGMA
 #ifndef OPT_PRAGMA
@@ -14,7 +15,6 @@
     #pragma GCC target("avx2,tune=native")
 #endif
 
-
 /*
  * tableau_remove_zero_X_columns
  * Uses hadamards to clear any zeroed X columns
@@ -55,6 +55,87 @@ void tableau_X_diag_element(tableau_t* tab, clifford_queue_t* c_que, const size_
 void tableau_X_diag_col_upper(tableau_t* tab, const size_t idx);
 void tableau_X_diag_col_lower(tableau_t* tab, const size_t idx);
 
+/*
+ * M4RM elimination
+ * Pivots are taken in blocks of TABLEAU_M4RM_BLOCK columns, the pivot search and the eliminations
+ * within a block are tracked on a small window of each row, the remaining rows are then updated
+ * once per block from TABLEAU_M4RM_TABLES tables holding every combination of TABLEAU_M4RM_BITS
+ * pivot rows
+ * Blocks must not straddle chunks
+ */
+#define TABLEAU_M4RM_BITS (8)
+#define TABLEAU_M4RM_TABLES (4)
+#define TABLEAU_M4RM_BLOCK (TABLEAU_M4RM_BITS * TABLEAU_M4RM_TABLES)
+
+/*
+ * TABLEAU_M4RM_INDEX_BUDGET
+ * Bit flips per row that a block may spend keeping its pivot index up to date
+ * Scanning the windows costs one test per row for each pivot, so past this budget the index
+ * costs more than it saves
+ * Sparse blocks find pivots and rows to eliminate from the index, dense blocks scan every row
+ */
+#define TABLEAU_M4RM_INDEX_BUDGET (TABLEAU_M4RM_BLOCK)
+
+/*
+ * Tiled elimination
+ * Each block is split into a panel task that finds its pivots on the windows and one update task
+ * per tile of TABLEAU_ELIM_TILE_LINES cache lines of chunks
+ * Tasks are ordered by their dependencies alone, the panel of a block only waits for the tile
+ * holding its columns, so it runs while the previous block is still updating the other tiles
+ * The rows of a tile are updated as further tasks of TABLEAU_ELIM_TILE_ROWS rows, which share
+ * the tables of the tile
+ * TABLEAU_ELIM_SLOTS blocks may be in flight, each holding its own pending row sums and tables
+ */
+#define TABLEAU_ELIM_SLOTS (3)
+#define TABLEAU_ELIM_TILE_LINES (4)
+#define TABLEAU_ELIM_TILE_ROWS (1024)
+
+/*
+ * Column elimination
+ * The elimination can also run on the column major tableau, where a row sum becomes a mask of
+ * rows XORed into every column with a bit set on the pivot row
+ * Columns are taken in blocks of TABLEAU_COL_ELIM_BLOCK, one per chunk of pivot rows, and the other
+ * columns are updated from TABLEAU_COL_ELIM_TABLES tables of TABLEAU_M4RM_BITS masks each
+ * Pivot rows are permuted into place at the end, one bit of every column for each row that moves
+ * Once more than one row in TABLEAU_COL_ELIM_TRANSPOSE moves it is cheaper to transpose the
+ * tableau and permute the slice pointers
+ */
+#define TABLEAU_COL_ELIM_BLOCK (CHUNK_SIZE_BITS)
+#define TABLEAU_COL_ELIM_TABLES (TABLEAU_COL_ELIM_BLOCK / TABLEAU_M4RM_BITS)
+#ifndef TABLEAU_COL_ELIM_TRANSPOSE
+#define TABLEAU_COL_ELIM_TRANSPOSE (12)
+#endif
+
+/*
+ * tableau_X_elim_upper
+ * tableau_X_elim_lower
+ * Blocked equivalents of calling tableau_X_diag_element followed by tableau_X_diag_col_upper
+ * or tableau_X_diag_col_lower for each of the first n_qubits columns in order
+ * :: tab : tableau_t* :: The transposed tableau to act on
+ * :: c_que : clifford_queue_t* :: The clifford queue
+ * :: n_qubits : const size_t :: Number of columns to eliminate
+ * :: pivot_mode : const uint8_t :: Pivot strategy, see TABLEAU_PIVOT_FIRST
+ * :: stats : tableau_elim_stats_t* :: Accumulates the work done, may be NULL
+ * Acts in place over the tableau, with TABLEAU_PIVOT_FIRST the tableau and queue match the
+ * column at a time elimination
+ */
+void tableau_X_elim_upper(tableau_t* tab, clifford_queue_t* c_que, const size_t n_qubits, const uint8_t pivot_mode, tableau_elim_stats_t* stats);
+void tableau_X_elim_lower(tableau_t* tab, clifford_queue_t* c_que, const size_t n_qubits, const uint8_t pivot_mode, tableau_elim_stats_t* stats);
+
+/*
+ * tableau_X_elim_cols
+ * Equivalent of tableau_X_elim_upper followed by tableau_X_elim_lower on the column major tableau
+ * :: tab : tableau_t* :: The tableau to act on, not transposed
+ * :: c_que : clifford_queue_t* :: The clifford queue
+ * :: n_qubits : const size_t :: Number of columns to eliminate
+ * :: stats : tableau_elim_stats_t* :: Accumulates the work done, may be NULL
+ * Chooses the same pivots as TABLEAU_PIVOT_FIRST, so the hadamards, phases and X and Z blocks
+ * match, up to a transpose
+ * Returns true if the tableau was transposed to permute its rows, otherwise the tableau is left
+ * column major, a decomposed stabiliser state is symmetric so either orientation reads the same
+ */
+bool tableau_X_elim_cols(tableau_t* tab, clifford_queue_t* c_que, const size_t n_qubits, tableau_elim_stats_t* stats);
+
 
 
 
@@ -95,6 +176,34 @@ void tableau_SHR(tableau_t* tab, const size_t targ);
 void tableau_CNOT(tableau_t* tab, const size_t ctrl, const size_t targ);
 void tableau_CZ(tableau_t* tab, const size_t ctrl, const size_t targ);
 
+
+/*
+ * Scalar chunk range kernels
+ * Indexed by the masked opcode, the identity entry is NULL
+ * See tableau_simd_operations.h for the vectorised equivalents
+ */
+extern const tableau_kernel_t TABLEAU_SCALAR_SINGLE_QUBIT_KERNELS[N_LOCAL_CLIFFORDS];
+extern const tableau_two_qubit_kernel_t TABLEAU_SCALAR_TWO_QUBIT_KERNELS[N_NON_LOCAL_CLIFFORDS];
+
+
+/*
+ * tableau_apply_local_cliffords
+ * Applies a local Clifford to each of the first n_qubits qubits
+ * :: tab : tableau_t* :: The tableau to operate on
+ * :: cliffords : const instruction_t* :: Local Clifford for each qubit 
+ * :: n_qubits : const size_t :: Number of qubits 
+ * Acts in place on the tableau, one team is used for all of the gates
+ */
+void tableau_apply_local_cliffords(tableau_t* tab, const instruction_t* cliffords, const size_t n_qubits);
+
+
+/*
+ * tableau_calibrate_parallel_threshold
+ * Measures the slice length at which a parallel kernel beats the serial kernel
+ * Returns the threshold in chunks, or SIZE_MAX if the parallel kernel was never faster
+ */
+size_t tableau_calibrate_parallel_threshold(void);
+
 #ifdef TABLEAU_OPERATIONS_SRC
 
   void (*SINGLE_QUBIT_OPERATIONS[N_LOCAL_CLIFFORDS])(tableau_t*, const size_t targ) = {
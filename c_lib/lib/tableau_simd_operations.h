@@ -0,0 +1,48 @@
+#ifndef TABLEAU_SIMD_OPERATIONS_H
+#define TABLEAU_SIMD_OPERATIONS_H
+
+#include <immintrin.h>
+
+#include "tableau.h"
+#include "instruction_table.h"
+
+/*
+ * Hand vectorised chunk range kernels
+ * Each of the 24 local Cliffords and the CNOT and CZ gates is written once in terms of
+ * XOR, AND, OR and ANDN and instantiated for 256 bit AVX2 and 512 bit AVX-512 registers
+ * Phases are updated with plain vector XORs, each kernel only touches the chunks [start, end)
+ * Chunks past the last full register are handled with scalar code
+ *
+ * Kernels are compiled with target attributes rather than build flags, the caller is
+ * responsible for checking that the host supports the instruction set
+ *
+ * Tables are indexed by the masked opcode, the identity entry is NULL
+ * Hadamard type kernels do not swap the X and Z slices, this is left to the caller
+ */
+extern const tableau_kernel_t TABLEAU_AVX2_SINGLE_QUBIT_KERNELS[N_LOCAL_CLIFFORDS];
+extern const tableau_two_qubit_kernel_t TABLEAU_AVX2_TWO_QUBIT_KERNELS[N_NON_LOCAL_CLIFFORDS];
+
+extern const tableau_kernel_t TABLEAU_AVX512_SINGLE_QUBIT_KERNELS[N_LOCAL_CLIFFORDS];
+extern const tableau_two_qubit_kernel_t TABLEAU_AVX512_TWO_QUBIT_KERNELS[N_NON_LOCAL_CLIFFORDS];
+
+/*
+ * tableau_ctz_avx2
+ * tableau_ctz_avx512
+ * Vectorised versions of tableau_ctz
+ * Whole registers of chunks are tested against zero before the first set chunk is searched
+ */
+size_t tableau_ctz_avx2(CHUNK_OBJ* slice, const size_t slice_len);
+size_t tableau_ctz_avx512(CHUNK_OBJ* slice, const size_t slice_len);
+
+/*
+ * tableau_transverse_hadamard_avx2
+ * tableau_transverse_hadamard_avx512
+ * Vectorised versions of tableau_transverse_hadamard_scalar
+ * The chunks holding the column are gathered through the slice pointers of four or eight rows
+ * at a time, AVX2 has no scatter so rows that change are written back one at a time
+ * Chunks are addressed by their offset alone, so these apply to both tableau layouts
+ */
+void tableau_transverse_hadamard_avx2(CHUNK_OBJ* const* slices_x, CHUNK_OBJ* const* slices_z, const size_t offset, const CHUNK_OBJ mask, const size_t n_rows);
+void tableau_transverse_hadamard_avx512(CHUNK_OBJ* const* slices_x, CHUNK_OBJ* const* slices_z, const size_t offset, const CHUNK_OBJ mask, const size_t n_rows);
+
+#endif
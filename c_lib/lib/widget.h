@@ -14,6 +14,20 @@
 
 #define WMAP_LOOKUP(widget, idx) (widget->q_map[idx])
 
+// Smallest tableau allocated by a widget, the tableau then doubles as qubits are allocated
+#define WIDGET_MIN_TABLEAU_QUBITS (CACHE_SIZE_BITS)
+
+// Ingestion modes for parse_instruction_block
+#define INGEST_DISPATCH (0)
+#define INGEST_CHUNK_REPLAY (1)
+#define INGEST_THREADED (2)
+
+// Decomposition modes for widget_decompose
+// DECOMPOSE_AUTO eliminates columns unless the pivot mode needs whole rows
+#define DECOMPOSE_AUTO (0)
+#define DECOMPOSE_TRANSPOSE (1)
+#define DECOMPOSE_COLUMNS (2)
+
 struct widget_t {
     size_t n_qubits;
     size_t n_initial_qubits;
@@ -22,6 +36,10 @@ struct widget_t {
     struct clifford_queue_t* queue;
     qubit_map_t* q_map;
     void* pauli_tracker;
+    uint8_t ingest_mode;
+    uint8_t pivot_mode;
+    uint8_t decompose_mode;
+    tableau_elim_stats_t elim_stats;
 };
 typedef struct widget_t widget_t;
 
@@ -36,6 +54,17 @@ typedef struct widget_t widget_t;
 widget_t* widget_create(const size_t initial_qubits, const size_t max_qubits);
 
 
+/*
+ * widget_reserve_qubits
+ * Ensures that the tableau holds at least a number of qubits
+ * :: wid : widget_t* :: The widget
+ * :: n_qubits : const size_t :: Number of qubits required, at most max_qubits
+ * The tableau grows geometrically up to max_qubits, so memory tracks the number of allocated
+ * qubits rather than the maximum
+ */
+void widget_reserve_qubits(widget_t* wid, const size_t n_qubits);
+
+
 /*
  * widget_destroy
  * Destructor for the widget object
@@ -63,6 +92,56 @@ size_t widget_get_n_qubits(const widget_t* wid);
 size_t widget_get_n_initial_qubits(const widget_t* wid);
 size_t widget_get_max_qubits(const widget_t* wid);
 
+/*
+ * widget_set_ingest_mode
+ * Selects how parse_instruction_block applies tableau operations
+ * :: wid : widget_t* :: The widget
+ * :: mode : const uint8_t :: One of INGEST_DISPATCH, INGEST_CHUNK_REPLAY or INGEST_THREADED
+ */
+void widget_set_ingest_mode(widget_t* wid, const uint8_t mode);
+
+/*
+ * widget_set_parallel_threshold
+ * Sets the slice length below which tableau kernels run serially
+ * :: wid : widget_t* :: The widget
+ * :: n_chunks : const size_t :: Threshold in chunks, see tableau_calibrate_parallel_threshold
+ */
+void widget_set_parallel_threshold(widget_t* wid, const size_t n_chunks);
+
+/*
+ * widget_set_sparse_slices
+ * Enables or disables sparse slice tracking on the widget's tableau
+ * :: wid : widget_t* :: The widget
+ * :: sparse : const bool :: Whether gate kernels should only visit occupied chunks
+ * See TABLEAU_SPARSE_DENSITY, the tableau becomes dense when it is decomposed
+ */
+void widget_set_sparse_slices(widget_t* wid, const bool sparse);
+
+/*
+ * widget_set_pivot_mode
+ * Selects the pivot strategy used when the widget is decomposed
+ * :: wid : widget_t* :: The widget
+ * :: mode : const uint8_t :: Either TABLEAU_PIVOT_FIRST or TABLEAU_PIVOT_MARKOWITZ
+ */
+void widget_set_pivot_mode(widget_t* wid, const uint8_t mode);
+
+/*
+ * widget_set_decompose_mode
+ * Selects how the widget is decomposed
+ * :: wid : widget_t* :: The widget
+ * :: mode : const uint8_t :: One of DECOMPOSE_AUTO, DECOMPOSE_TRANSPOSE or DECOMPOSE_COLUMNS
+ * DECOMPOSE_TRANSPOSE transposes the tableau and eliminates rows, DECOMPOSE_COLUMNS eliminates
+ * on the column major tableau, see tableau_X_elim_cols
+ */
+void widget_set_decompose_mode(widget_t* wid, const uint8_t mode);
+
+/*
+ * widget_get_elim_stats
+ * Work done by the elimination of the last call to widget_decompose
+ * :: wid : const widget_t* :: The widget
+ */
+tableau_elim_stats_t widget_get_elim_stats(const widget_t* wid);
+
 
 /*
  * widget_get_io_map
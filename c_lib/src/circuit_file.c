@@ -0,0 +1,385 @@
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "circuit_file.h"
+#include "packed_stream.h"
+#include "input_stream.h"
+#include "debug.h"
+
+// Raw records are parsed in place, so the file layout is the in memory layout
+_Static_assert(12 == sizeof(instruction_stream_u), "Raw circuit file records are 12 bytes");
+_Static_assert(CIRCUIT_FILE_HEADER_BYTES == sizeof(circuit_file_header_t), "Circuit file header size");
+
+/*
+ * circuit_file_raw_record
+ * Copies the fields used by an instruction into a zeroed record
+ * :: inst : const instruction_stream_u* :: The instruction
+ * Padding and unused fields of the union are not written to the file
+ */
+static instruction_stream_u circuit_file_raw_record(const instruction_stream_u* inst)
+{
+    instruction_stream_u rec;
+    memset(&rec, 0, sizeof(rec));
+    rec.instruction = inst->instruction;
+    switch (INSTRUCTION_TYPE(inst->instruction))
+    {
+        case INSTRUCTION_TYPE(LOCAL_CLIFFORD_MASK):
+            rec.single.arg = inst->single.arg;
+            break;
+        case INSTRUCTION_TYPE(RZ_MASK):
+            rec.rz.arg = inst->rz.arg;
+            rec.rz.tag = inst->rz.tag;
+            break;
+        default:
+            rec.multi.ctrl = inst->multi.ctrl;
+            rec.multi.targ = inst->multi.targ;
+    }
+    return rec;
+}
+
+/*
+ * circuit_file_write
+ * Writes a circuit file
+ * :: path : const char* :: File to create or truncate
+ * :: n_qubits : const size_t :: Initial qubits of the widget
+ * :: max_qubits : const size_t :: Maximum qubits of the widget
+ * :: instructions : const instruction_stream_u* :: Array of instructions
+ * :: n_instructions : const size_t :: Number of instructions
+ * :: encoding : const uint32_t :: CIRCUIT_FILE_ENCODING_RAW or CIRCUIT_FILE_ENCODING_PACKED
+ * Returns CIRCUIT_FILE_OK or CIRCUIT_FILE_ERR_IO
+ */
+int circuit_file_write(
+    const char* path,
+    const size_t n_qubits,
+    const size_t max_qubits,
+    const instruction_stream_u* instructions,
+    const size_t n_instructions,
+    const uint32_t encoding)
+{
+    assert((CIRCUIT_FILE_ENCODING_RAW == encoding) || (CIRCUIT_FILE_ENCODING_PACKED == encoding));
+
+    FILE* fp = fopen(path, "wb");
+    if (NULL == fp)
+    {
+        return CIRCUIT_FILE_ERR_IO;
+    }
+
+    circuit_file_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CIRCUIT_FILE_MAGIC, sizeof(CIRCUIT_FILE_MAGIC));
+    header.version = CIRCUIT_FILE_VERSION;
+    header.encoding = encoding;
+    header.n_qubits = n_qubits;
+    header.max_qubits = max_qubits;
+    header.n_instructions = n_instructions;
+
+    uint8_t* bytes = NULL;
+    if (CIRCUIT_FILE_ENCODING_PACKED == encoding)
+    {
+        // Tags are coded relative to the previous tag, so the stream is packed in one pass
+        bytes = malloc(packed_stream_bound(n_instructions) + 1);
+        NULL_CHECK(bytes);
+        header.n_bytes = packed_stream_encode(instructions, n_instructions, bytes);
+    }
+    else
+    {
+        header.n_bytes = n_instructions * sizeof(instruction_stream_u);
+    }
+
+    bool ok = (1 == fwrite(&header, sizeof(header), 1, fp));
+    if (CIRCUIT_FILE_ENCODING_PACKED == encoding)
+    {
+        ok = ok && (header.n_bytes == fwrite(bytes, 1, header.n_bytes, fp));
+        free(bytes);
+    }
+    else
+    {
+        instruction_stream_u* window = malloc(CIRCUIT_FILE_WINDOW * sizeof(instruction_stream_u));
+        NULL_CHECK(window);
+        for (size_t i = 0; ok && (i < n_instructions); i += CIRCUIT_FILE_WINDOW)
+        {
+            const size_t n = (i + CIRCUIT_FILE_WINDOW < n_instructions) ? CIRCUIT_FILE_WINDOW : n_instructions - i;
+            for (size_t j = 0; j < n; j++)
+            {
+                window[j] = circuit_file_raw_record(instructions + i + j);
+            }
+            ok = (n == fwrite(window, sizeof(instruction_stream_u), n, fp));
+        }
+        free(window);
+    }
+
+    ok = (0 == fclose(fp)) && ok;
+    return ok ? CIRCUIT_FILE_OK : CIRCUIT_FILE_ERR_IO;
+}
+
+/*
+ * circuit_file_open
+ * Maps a circuit file and checks its header
+ * :: path : const char* :: File to open
+ * :: status : int* :: Written with a status code, may be NULL
+ * Returns NULL if the file cannot be mapped or is not a circuit file
+ */
+circuit_file_t* circuit_file_open(const char* path, int* status)
+{
+    int err = CIRCUIT_FILE_OK;
+    int* const err_ptr = (NULL != status) ? status : &err;
+    *err_ptr = CIRCUIT_FILE_ERR_IO;
+
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        return NULL;
+    }
+
+    struct stat st;
+    if (0 != fstat(fd, &st))
+    {
+        close(fd);
+        return NULL;
+    }
+    if ((size_t)st.st_size < CIRCUIT_FILE_HEADER_BYTES)
+    {
+        *err_ptr = CIRCUIT_FILE_ERR_FORMAT;
+        close(fd);
+        return NULL;
+    }
+
+    uint8_t* map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (MAP_FAILED == map)
+    {
+        close(fd);
+        return NULL;
+    }
+    madvise(map, st.st_size, MADV_SEQUENTIAL);
+
+    circuit_file_t* file = malloc(sizeof(circuit_file_t));
+    NULL_CHECK(file);
+    file->fd = fd;
+    file->map = map;
+    file->map_len = st.st_size;
+    file->released = 0;
+    memcpy(&file->header, map, sizeof(circuit_file_header_t));
+
+    const circuit_file_header_t* header = &file->header;
+    const bool valid = (0 == memcmp(header->magic, CIRCUIT_FILE_MAGIC, sizeof(CIRCUIT_FILE_MAGIC)))
+        && (CIRCUIT_FILE_VERSION == header->version)
+        && (header->n_qubits <= header->max_qubits)
+        && (header->n_bytes <= file->map_len - CIRCUIT_FILE_HEADER_BYTES)
+        && (((CIRCUIT_FILE_ENCODING_RAW == header->encoding)
+                && (header->n_bytes == header->n_instructions * sizeof(instruction_stream_u)))
+            || (CIRCUIT_FILE_ENCODING_PACKED == header->encoding));
+    if (!valid)
+    {
+        circuit_file_close(file);
+        *err_ptr = CIRCUIT_FILE_ERR_FORMAT;
+        return NULL;
+    }
+
+    *err_ptr = CIRCUIT_FILE_OK;
+    return file;
+}
+
+/*
+ * circuit_file_close
+ * Unmaps and closes a circuit file
+ * :: file : circuit_file_t* :: File to close
+ */
+void circuit_file_close(circuit_file_t* file)
+{
+    munmap(file->map, file->map_len);
+    close(file->fd);
+    free(file);
+}
+
+/*
+ * circuit_file_widget_create
+ * Creates a widget sized by the header of a circuit file
+ * :: file : const circuit_file_t* :: The circuit file
+ */
+widget_t* circuit_file_widget_create(const circuit_file_t* file)
+{
+    return widget_create(file->header.n_qubits, file->header.max_qubits);
+}
+
+/*
+ * circuit_file_advise
+ * Requests the read ahead of the next windows and releases the pages that have been parsed
+ * :: file : circuit_file_t* :: The circuit file
+ * :: consumed : const size_t :: Offset into the file that has been parsed
+ * :: window_bytes : const size_t :: Length of a window
+ */
+static void circuit_file_advise(circuit_file_t* file, const size_t consumed, const size_t window_bytes)
+{
+    const size_t page = sysconf(_SC_PAGESIZE);
+
+    // Only pages consumed since the last window are released
+    const size_t released = (consumed / page) * page;
+    if (released > file->released)
+    {
+        madvise(file->map + file->released, released - file->released, MADV_DONTNEED);
+        file->released = released;
+    }
+
+    if (consumed < file->map_len)
+    {
+        const size_t ahead = CIRCUIT_FILE_READ_AHEAD * window_bytes;
+        const size_t len = (consumed + ahead < file->map_len) ? ahead : file->map_len - consumed;
+        madvise(file->map + released, consumed - released + len, MADV_WILLNEED);
+    }
+}
+
+/*
+ * circuit_file_check_window
+ * Checks a window of records before it is parsed
+ * :: wid : const widget_t* :: Current widget
+ * :: instructions : const instruction_stream_u* :: Window of records
+ * :: n_instructions : const size_t :: Length of the window
+ * Returns CIRCUIT_FILE_OK, CIRCUIT_FILE_ERR_FORMAT or CIRCUIT_FILE_ERR_QUBITS
+ */
+static int circuit_file_check_window(
+    const widget_t* wid,
+    const instruction_stream_u* instructions,
+    const size_t n_instructions)
+{
+    // Records address qubits through the qubit map
+    const size_t n_mapped = wid->n_initial_qubits;
+    size_t n_rz = 0;
+    for (size_t i = 0; i < n_instructions; i++)
+    {
+        const instruction_stream_u* inst = instructions + i;
+        const instruction_t opcode = inst->instruction;
+        switch (INSTRUCTION_TYPE(opcode))
+        {
+            case INSTRUCTION_TYPE(LOCAL_CLIFFORD_MASK):
+                if ((opcode & INSTRUCTION_OPERATOR_MASK) >= N_LOCAL_CLIFFORD_INSTRUCTIONS)
+                {
+                    return CIRCUIT_FILE_ERR_FORMAT;
+                }
+                if (inst->single.arg >= n_mapped)
+                {
+                    return CIRCUIT_FILE_ERR_QUBITS;
+                }
+                break;
+            case INSTRUCTION_TYPE(NON_LOCAL_CLIFFORD_MASK):
+                if ((_CNOT_ != opcode) && (_CZ_ != opcode))
+                {
+                    return CIRCUIT_FILE_ERR_FORMAT;
+                }
+                if ((inst->multi.ctrl >= n_mapped) || (inst->multi.targ >= n_mapped))
+                {
+                    return CIRCUIT_FILE_ERR_QUBITS;
+                }
+                break;
+            case INSTRUCTION_TYPE(RZ_MASK):
+                if (_RZ_ != opcode)
+                {
+                    return CIRCUIT_FILE_ERR_FORMAT;
+                }
+                if (inst->rz.arg >= n_mapped)
+                {
+                    return CIRCUIT_FILE_ERR_QUBITS;
+                }
+                n_rz++;
+                break;
+            case INSTRUCTION_TYPE(MEASUREMENT_CONDITIONED_MASK):
+                if ((opcode & INSTRUCTION_OP_MASK) > (_MCZ_ & INSTRUCTION_OP_MASK))
+                {
+                    return CIRCUIT_FILE_ERR_FORMAT;
+                }
+                if ((inst->cond.ctrl >= n_mapped) || (inst->cond.targ >= n_mapped))
+                {
+                    return CIRCUIT_FILE_ERR_QUBITS;
+                }
+                break;
+            default:
+                return CIRCUIT_FILE_ERR_FORMAT;
+        }
+    }
+
+    // Each RZ teleports onto a new qubit
+    if (wid->n_qubits + n_rz > wid->max_qubits)
+    {
+        return CIRCUIT_FILE_ERR_QUBITS;
+    }
+    return CIRCUIT_FILE_OK;
+}
+
+/*
+ * circuit_file_parse
+ * Streams the instructions of a circuit file into a widget
+ * :: wid : widget_t* :: Current widget
+ * :: file : circuit_file_t* :: The circuit file
+ * :: status : int* :: Written with a status code, may be NULL
+ * Raw records are parsed in place, packed records are decoded into a single window
+ * Returns the number of instructions parsed
+ */
+size_t circuit_file_parse(widget_t* wid, circuit_file_t* file, int* status)
+{
+    int err = CIRCUIT_FILE_OK;
+    int* const err_ptr = (NULL != status) ? status : &err;
+    *err_ptr = CIRCUIT_FILE_OK;
+
+    const uint8_t* records = file->map + CIRCUIT_FILE_HEADER_BYTES;
+    const size_t n_bytes = file->header.n_bytes;
+    size_t n_parsed = 0;
+
+    if (CIRCUIT_FILE_ENCODING_RAW == file->header.encoding)
+    {
+        const size_t window_bytes = CIRCUIT_FILE_WINDOW * sizeof(instruction_stream_u);
+        for (size_t i = 0; i < file->header.n_instructions; i += CIRCUIT_FILE_WINDOW)
+        {
+            const size_t n = (i + CIRCUIT_FILE_WINDOW < file->header.n_instructions) ? CIRCUIT_FILE_WINDOW : file->header.n_instructions - i;
+            circuit_file_advise(file, CIRCUIT_FILE_HEADER_BYTES + i * sizeof(instruction_stream_u), window_bytes);
+
+            // The mapping is read only, parse_instruction_block does not write to the stream
+            instruction_stream_u* window = (instruction_stream_u*)(records + i * sizeof(instruction_stream_u));
+            *err_ptr = circuit_file_check_window(wid, window, n);
+            if (CIRCUIT_FILE_OK != *err_ptr)
+            {
+                break;
+            }
+            parse_instruction_block(wid, window, n);
+            n_parsed += n;
+        }
+    }
+    else
+    {
+        instruction_stream_u* window = malloc(CIRCUIT_FILE_WINDOW * sizeof(instruction_stream_u));
+        NULL_CHECK(window);
+
+        packed_stream_decoder_t dec;
+        packed_stream_decoder_init(&dec, records, n_bytes);
+
+        // Packed windows are shorter than raw windows, so this reads further ahead
+        const size_t window_bytes = CIRCUIT_FILE_WINDOW * sizeof(instruction_stream_u);
+        for (;;)
+        {
+            circuit_file_advise(file, CIRCUIT_FILE_HEADER_BYTES + dec.pos, window_bytes);
+            const size_t n = packed_stream_decode(&dec, window, CIRCUIT_FILE_WINDOW);
+
+            // A window that stops at a malformed record is not parsed
+            *err_ptr = (PACKED_STREAM_OK == dec.status) ? circuit_file_check_window(wid, window, n) : CIRCUIT_FILE_ERR_FORMAT;
+            if ((0 == n) || (CIRCUIT_FILE_OK != *err_ptr))
+            {
+                break;
+            }
+            parse_instruction_block(wid, window, n);
+            n_parsed += n;
+        }
+
+        free(window);
+        if ((CIRCUIT_FILE_OK == *err_ptr) && (n_parsed != file->header.n_instructions))
+        {
+            *err_ptr = CIRCUIT_FILE_ERR_FORMAT;
+        }
+    }
+
+    if (CIRCUIT_FILE_OK != *err_ptr)
+    {
+        DPRINT(DEBUG_1, "Circuit file error %d after %lu instructions\n", *err_ptr, n_parsed);
+    }
+    return n_parsed;
+}
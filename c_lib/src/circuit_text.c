@@ -0,0 +1,841 @@
+#include <ctype.h>
+#include <math.h>
+#include <strings.h>
+
+#include "circuit_text.h"
+#include "input_stream.h"
+#include "debug.h"
+
+// Qubits an instruction of a gate decomposition acts on
+#define CIRCUIT_TEXT_Q0 (0)
+#define CIRCUIT_TEXT_Q1 (1)
+#define CIRCUIT_TEXT_Q01 (2)
+#define CIRCUIT_TEXT_Q10 (3)
+
+#define CIRCUIT_TEXT_MAX_OPS (3)
+
+// Angles smaller than this are tagged as zero
+#define CIRCUIT_TEXT_ZERO_ANGLE (1e-12)
+
+struct circuit_text_op_t
+{
+    instruction_t opcode;
+    uint8_t role; // CIRCUIT_TEXT_Q0, CIRCUIT_TEXT_Q1, CIRCUIT_TEXT_Q01 or CIRCUIT_TEXT_Q10
+};
+
+/*
+ * circuit_text_gate_t
+ * A gate of a text format and its decomposition into instructions
+ */
+struct circuit_text_gate_t
+{
+    const char* name;
+    uint8_t arity; // Qubits per application
+    uint8_t angle; // 1 if the gate takes an angle, 2 if the angle is fixed by the gate
+    double fixed_angle;
+    uint8_t n_ops;
+    struct circuit_text_op_t ops[CIRCUIT_TEXT_MAX_OPS];
+};
+
+#define GATE_1(name, opcode) {name, 1, 0, 0, 1, {{opcode, CIRCUIT_TEXT_Q0}}}
+#define GATE_HXH(name, opcode) {name, 1, 0, 0, 3, {{_H_, CIRCUIT_TEXT_Q0}, {opcode, CIRCUIT_TEXT_Q0}, {_H_, CIRCUIT_TEXT_Q0}}}
+#define GATE_2(name, opcode) {name, 2, 0, 0, 1, {{opcode, CIRCUIT_TEXT_Q01}}}
+#define GATE_CY(name) {name, 2, 0, 0, 3, {{_R_, CIRCUIT_TEXT_Q1}, {_CNOT_, CIRCUIT_TEXT_Q01}, {_S_, CIRCUIT_TEXT_Q1}}}
+#define GATE_SWAP(name) {name, 2, 0, 0, 3, {{_CNOT_, CIRCUIT_TEXT_Q01}, {_CNOT_, CIRCUIT_TEXT_Q10}, {_CNOT_, CIRCUIT_TEXT_Q01}}}
+#define GATE_RZ(name) {name, 1, 1, 0, 1, {{_RZ_, CIRCUIT_TEXT_Q0}}}
+#define GATE_RZ_FIXED(name, angle) {name, 1, 2, angle, 1, {{_RZ_, CIRCUIT_TEXT_Q0}}}
+
+static const circuit_text_gate_t QASM_GATES[] = {
+    {"id", 1, 0, 0, 0, {{0}}},
+    GATE_1("x", _X_),
+    GATE_1("y", _Y_),
+    GATE_1("z", _Z_),
+    GATE_1("h", _H_),
+    GATE_1("s", _S_),
+    GATE_1("sdg", _R_),
+    GATE_HXH("sx", _S_),
+    GATE_HXH("sxdg", _R_),
+    GATE_2("cx", _CNOT_),
+    GATE_2("CX", _CNOT_),
+    GATE_2("cz", _CZ_),
+    GATE_CY("cy"),
+    GATE_SWAP("swap"),
+    GATE_RZ_FIXED("t", M_PI / 4),
+    GATE_RZ_FIXED("tdg", -M_PI / 4),
+    GATE_RZ("rz"),
+    GATE_RZ("u1"),
+    GATE_RZ("p"),
+};
+
+static const circuit_text_gate_t STIM_GATES[] = {
+    {"I", 1, 0, 0, 0, {{0}}},
+    GATE_1("X", _X_),
+    GATE_1("Y", _Y_),
+    GATE_1("Z", _Z_),
+    GATE_1("H", _H_),
+    GATE_1("H_XZ", _H_),
+    GATE_1("S", _S_),
+    GATE_1("SQRT_Z", _S_),
+    GATE_1("S_DAG", _R_),
+    GATE_1("SQRT_Z_DAG", _R_),
+    GATE_HXH("SQRT_X", _S_),
+    GATE_HXH("SQRT_X_DAG", _R_),
+    GATE_2("CX", _CNOT_),
+    GATE_2("CNOT", _CNOT_),
+    GATE_2("ZCX", _CNOT_),
+    GATE_CY("CY"),
+    GATE_CY("ZCY"),
+    GATE_2("CZ", _CZ_),
+    GATE_2("ZCZ", _CZ_),
+    GATE_SWAP("SWAP"),
+};
+
+#define N_QASM_GATES (sizeof(QASM_GATES) / sizeof(circuit_text_gate_t))
+#define N_STIM_GATES (sizeof(STIM_GATES) / sizeof(circuit_text_gate_t))
+
+/*
+ * circuit_text_angle_tag
+ * Tags an angle with the bits of the angle as a 32 bit float
+ * :: angle : const double :: The angle
+ */
+static non_clifford_tag_t circuit_text_angle_tag(const double angle)
+{
+    if (fabs(angle) < CIRCUIT_TEXT_ZERO_ANGLE)
+    {
+        return 0;
+    }
+    const float f = (float)angle;
+    non_clifford_tag_t tag;
+    memcpy(&tag, &f, sizeof(tag));
+    return tag;
+}
+
+/*
+ * circuit_text_error
+ * Stops the parse
+ * :: parser : circuit_text_parser_t* :: The parser
+ * :: status : const int :: Status code
+ * Returns false
+ */
+static bool circuit_text_error(circuit_text_parser_t* parser, const int status)
+{
+    parser->status = status;
+    parser->n_apps = 0;
+    parser->app = 0;
+    DPRINT(DEBUG_1, "Circuit text error %d on line %zu\n", status, parser->line);
+    return false;
+}
+
+/*
+ * circuit_text_parser_create
+ * Creates a parser over an open file
+ * :: fp : FILE* :: File to read from, closed by the caller
+ * :: format : const uint8_t :: CIRCUIT_TEXT_QASM or CIRCUIT_TEXT_STIM
+ */
+circuit_text_parser_t* circuit_text_parser_create(FILE* fp, const uint8_t format)
+{
+    assert((CIRCUIT_TEXT_QASM == format) || (CIRCUIT_TEXT_STIM == format));
+    circuit_text_parser_t* parser = calloc(1, sizeof(circuit_text_parser_t));
+    NULL_CHECK(parser);
+    parser->fp = fp;
+    parser->format = format;
+    parser->status = CIRCUIT_TEXT_OK;
+    parser->next_line = 1;
+    return parser;
+}
+
+/*
+ * circuit_text_parser_destroy
+ * Frees a parser and its buffers
+ * :: parser : circuit_text_parser_t* :: Parser to free
+ */
+void circuit_text_parser_destroy(circuit_text_parser_t* parser)
+{
+    for (size_t i = 0; i < parser->n_regs; i++)
+    {
+        free(parser->regs[i].name);
+    }
+    free(parser->regs);
+    free(parser->targets);
+    free(parser->buf);
+    free(parser);
+}
+
+/*
+ * circuit_text_push_char
+ * Appends a character to the statement buffer
+ */
+static inline
+void __inline_circuit_text_push_char(circuit_text_parser_t* parser, const char c)
+{
+    if (parser->buf_len + 1 >= parser->buf_cap)
+    {
+        parser->buf_cap = (parser->buf_cap > 0) ? 2 * parser->buf_cap : 256;
+        parser->buf = realloc(parser->buf, parser->buf_cap);
+        NULL_CHECK(parser->buf);
+    }
+    parser->buf[parser->buf_len++] = c;
+}
+
+/*
+ * circuit_text_read_statement
+ * Reads the next statement into the statement buffer without its terminator or comments
+ * :: parser : circuit_text_parser_t* :: The parser
+ * QASM statements end at a semicolon and may span lines, Stim statements end at a newline
+ * Returns false at the end of the file if nothing was read
+ */
+static bool circuit_text_read_statement(circuit_text_parser_t* parser)
+{
+    const bool qasm = (CIRCUIT_TEXT_QASM == parser->format);
+    const int terminator = qasm ? ';' : '\n';
+    FILE* fp = parser->fp;
+
+    parser->buf_len = 0;
+    parser->line = 0;
+    bool comment = false;
+    bool any = false;
+    int c;
+    while (EOF != (c = getc_unlocked(fp)))
+    {
+        any = true;
+        if ('\n' == c)
+        {
+            parser->next_line++;
+            comment = false;
+        }
+        if (comment && ('\n' != c))
+        {
+            continue;
+        }
+        if (c == terminator)
+        {
+            break;
+        }
+
+        if (qasm && ('/' == c))
+        {
+            const int next = getc_unlocked(fp);
+            if ('/' == next)
+            {
+                comment = true;
+                continue;
+            }
+            ungetc(next, fp);
+        }
+        else if (!qasm && ('#' == c))
+        {
+            comment = true;
+            continue;
+        }
+
+        if ((0 == parser->line) && !isspace(c))
+        {
+            parser->line = parser->next_line;
+        }
+        __inline_circuit_text_push_char(parser, (char)c);
+    }
+
+    if (ferror(fp))
+    {
+        return circuit_text_error(parser, CIRCUIT_TEXT_ERR_IO);
+    }
+    __inline_circuit_text_push_char(parser, '\0');
+    parser->buf_len--;
+    return any;
+}
+
+/*
+ * Cursor helpers over the statement buffer
+ * Each skips leading whitespace and advances the cursor past what it reads
+ */
+static inline
+const char* __inline_circuit_text_skip(const char* p)
+{
+    while (isspace((unsigned char)*p))
+    {
+        p++;
+    }
+    return p;
+}
+
+static inline
+bool __inline_circuit_text_accept(const char** p, const char c)
+{
+    *p = __inline_circuit_text_skip(*p);
+    if (c == **p)
+    {
+        (*p)++;
+        return true;
+    }
+    return false;
+}
+
+static inline
+size_t __inline_circuit_text_ident(const char** p, const char** start)
+{
+    *p = __inline_circuit_text_skip(*p);
+    *start = *p;
+    while (isalnum((unsigned char)**p) || ('_' == **p))
+    {
+        (*p)++;
+    }
+    return *p - *start;
+}
+
+static inline
+bool __inline_circuit_text_uint(const char** p, uint64_t* value)
+{
+    *p = __inline_circuit_text_skip(*p);
+    if (!isdigit((unsigned char)**p))
+    {
+        return false;
+    }
+    char* end;
+    *value = strtoull(*p, &end, 10);
+    *p = end;
+    return *value <= UINT32_MAX;
+}
+
+static inline
+bool __inline_circuit_text_ident_eq(const char* start, const size_t len, const char* name)
+{
+    return (strlen(name) == len) && (0 == strncmp(start, name, len));
+}
+
+static inline
+bool __inline_circuit_text_ident_caseeq(const char* start, const size_t len, const char* name)
+{
+    return (strlen(name) == len) && (0 == strncasecmp(start, name, len));
+}
+
+static bool circuit_text_expr(const char** p, double* value);
+
+/*
+ * circuit_text_primary
+ * QASM parameter expressions, numbers, pi, signs, parentheses and the four arithmetic operators
+ */
+static bool circuit_text_primary(const char** p, double* value)
+{
+    if (__inline_circuit_text_accept(p, '-'))
+    {
+        const bool ok = circuit_text_primary(p, value);
+        *value = -*value;
+        return ok;
+    }
+    if (__inline_circuit_text_accept(p, '+'))
+    {
+        return circuit_text_primary(p, value);
+    }
+    if (__inline_circuit_text_accept(p, '('))
+    {
+        return circuit_text_expr(p, value) && __inline_circuit_text_accept(p, ')');
+    }
+
+    const char* start;
+    const size_t len = __inline_circuit_text_ident(p, &start);
+    if (__inline_circuit_text_ident_eq(start, len, "pi"))
+    {
+        *value = M_PI;
+        return true;
+    }
+    *p = start;
+
+    char* end;
+    *value = strtod(start, &end);
+    if ((end == start) || isalpha((unsigned char)*start))
+    {
+        return false;
+    }
+    *p = end;
+    return true;
+}
+
+static bool circuit_text_term(const char** p, double* value)
+{
+    if (!circuit_text_primary(p, value))
+    {
+        return false;
+    }
+    for (;;)
+    {
+        double rhs;
+        if (__inline_circuit_text_accept(p, '*'))
+        {
+            if (!circuit_text_primary(p, &rhs))
+            {
+                return false;
+            }
+            *value *= rhs;
+        }
+        else if (__inline_circuit_text_accept(p, '/'))
+        {
+            if (!circuit_text_primary(p, &rhs))
+            {
+                return false;
+            }
+            *value /= rhs;
+        }
+        else
+        {
+            return true;
+        }
+    }
+}
+
+static bool circuit_text_expr(const char** p, double* value)
+{
+    if (!circuit_text_term(p, value))
+    {
+        return false;
+    }
+    for (;;)
+    {
+        double rhs;
+        if (__inline_circuit_text_accept(p, '+'))
+        {
+            if (!circuit_text_term(p, &rhs))
+            {
+                return false;
+            }
+            *value += rhs;
+        }
+        else if (__inline_circuit_text_accept(p, '-'))
+        {
+            if (!circuit_text_term(p, &rhs))
+            {
+                return false;
+            }
+            *value -= rhs;
+        }
+        else
+        {
+            return true;
+        }
+    }
+}
+
+/*
+ * circuit_text_reserve_targets
+ * Grows the target buffer
+ */
+static void circuit_text_reserve_targets(circuit_text_parser_t* parser, const size_t n_targets)
+{
+    if (n_targets > parser->targets_cap)
+    {
+        parser->targets_cap = (2 * parser->targets_cap > n_targets) ? 2 * parser->targets_cap : n_targets;
+        parser->targets = realloc(parser->targets, parser->targets_cap * sizeof(uint32_t));
+        NULL_CHECK(parser->targets);
+    }
+}
+
+/*
+ * circuit_text_find_gate
+ * Looks up a gate by name
+ */
+static const circuit_text_gate_t* circuit_text_find_gate(
+    const circuit_text_gate_t* gates,
+    const size_t n_gates,
+    const char* start,
+    const size_t len,
+    const bool ignore_case)
+{
+    for (size_t i = 0; i < n_gates; i++)
+    {
+        const bool eq = ignore_case
+            ? __inline_circuit_text_ident_caseeq(start, len, gates[i].name)
+            : __inline_circuit_text_ident_eq(start, len, gates[i].name);
+        if (eq)
+        {
+            return gates + i;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * circuit_text_qasm_qreg
+ * Declares a QASM register
+ */
+static bool circuit_text_qasm_qreg(circuit_text_parser_t* parser, const char* p)
+{
+    const char* start;
+    const size_t len = __inline_circuit_text_ident(&p, &start);
+    uint64_t size;
+    if ((0 == len)
+        || !__inline_circuit_text_accept(&p, '[')
+        || !__inline_circuit_text_uint(&p, &size)
+        || !__inline_circuit_text_accept(&p, ']')
+        || ('\0' != *__inline_circuit_text_skip(p)))
+    {
+        return circuit_text_error(parser, CIRCUIT_TEXT_ERR_SYNTAX);
+    }
+
+    if (parser->n_regs == parser->regs_cap)
+    {
+        parser->regs_cap = (parser->regs_cap > 0) ? 2 * parser->regs_cap : 4;
+        parser->regs = realloc(parser->regs, parser->regs_cap * sizeof(circuit_text_register_t));
+        NULL_CHECK(parser->regs);
+    }
+    circuit_text_register_t* reg = parser->regs + parser->n_regs++;
+    reg->name = strndup(start, len);
+    NULL_CHECK(reg->name);
+    reg->offset = parser->n_qubits;
+    reg->size = size;
+    parser->n_qubits += size;
+    return true;
+}
+
+/*
+ * circuit_text_qasm_statement
+ * Parses a QASM statement, setting up the applications of a gate
+ * :: parser : circuit_text_parser_t* :: The parser
+ * Returns false on an error
+ */
+static bool circuit_text_qasm_statement(circuit_text_parser_t* parser)
+{
+    const char* p = parser->buf;
+    const char* start;
+    const size_t len = __inline_circuit_text_ident(&p, &start);
+    if (0 == len)
+    {
+        return ('\0' == *__inline_circuit_text_skip(p)) || circuit_text_error(parser, CIRCUIT_TEXT_ERR_SYNTAX);
+    }
+
+    if (__inline_circuit_text_ident_eq(start, len, "OPENQASM")
+        || __inline_circuit_text_ident_eq(start, len, "include")
+        || __inline_circuit_text_ident_eq(start, len, "creg")
+        || __inline_circuit_text_ident_eq(start, len, "barrier"))
+    {
+        return true;
+    }
+    if (__inline_circuit_text_ident_eq(start, len, "qreg"))
+    {
+        return circuit_text_qasm_qreg(parser, p);
+    }
+
+    const circuit_text_gate_t* gate = circuit_text_find_gate(QASM_GATES, N_QASM_GATES, start, len, false);
+    if (NULL == gate)
+    {
+        return circuit_text_error(parser, CIRCUIT_TEXT_ERR_UNSUPPORTED);
+    }
+
+    double angle = gate->fixed_angle;
+    if (1 == gate->angle)
+    {
+        if (!__inline_circuit_text_accept(&p, '(') || !circuit_text_expr(&p, &angle) || !__inline_circuit_text_accept(&p, ')'))
+        {
+            return circuit_text_error(parser, CIRCUIT_TEXT_ERR_SYNTAX);
+        }
+    }
+
+    // Arguments are single qubits or whole registers
+    size_t offsets[2];
+    size_t sizes[2];
+    bool whole[2];
+    size_t n_apps = 1;
+    for (size_t i = 0; i < gate->arity; i++)
+    {
+        if ((i > 0) && !__inline_circuit_text_accept(&p, ','))
+        {
+            return circuit_text_error(parser, CIRCUIT_TEXT_ERR_SYNTAX);
+        }
+        const size_t reg_len = __inline_circuit_text_ident(&p, &start);
+        const circuit_text_register_t* reg = NULL;
+        for (size_t j = 0; j < parser->n_regs; j++)
+        {
+            if (__inline_circuit_text_ident_eq(start, reg_len, parser->regs[j].name))
+            {
+                reg = parser->regs + j;
+            }
+        }
+        if (NULL == reg)
+        {
+            return circuit_text_error(parser, CIRCUIT_TEXT_ERR_SYNTAX);
+        }
+
+        uint64_t idx = 0;
+        whole[i] = !__inline_circuit_text_accept(&p, '[');
+        if (!whole[i] && (!__inline_circuit_text_uint(&p, &idx) || !__inline_circuit_text_accept(&p, ']')))
+        {
+            return circuit_text_error(parser, CIRCUIT_TEXT_ERR_SYNTAX);
+        }
+        if (!whole[i] && (idx >= reg->size))
+        {
+            return circuit_text_error(parser, CIRCUIT_TEXT_ERR_QUBITS);
+        }
+        offsets[i] = reg->offset + idx;
+        sizes[i] = reg->size;
+
+        if (whole[i])
+        {
+            if ((n_apps > 1) && (n_apps != reg->size))
+            {
+                return circuit_text_error(parser, CIRCUIT_TEXT_ERR_SYNTAX);
+            }
+            n_apps = reg->size;
+        }
+    }
+    if ('\0' != *__inline_circuit_text_skip(p))
+    {
+        return circuit_text_error(parser, CIRCUIT_TEXT_ERR_SYNTAX);
+    }
+    for (size_t i = 0; i < gate->arity; i++)
+    {
+        if (whole[i] && (sizes[i] != n_apps))
+        {
+            return circuit_text_error(parser, CIRCUIT_TEXT_ERR_SYNTAX);
+        }
+    }
+
+    circuit_text_reserve_targets(parser, n_apps * gate->arity);
+    for (size_t app = 0; app < n_apps; app++)
+    {
+        for (size_t i = 0; i < gate->arity; i++)
+        {
+            parser->targets[app * gate->arity + i] = offsets[i] + (whole[i] ? app : 0);
+        }
+        if ((2 == gate->arity) && (parser->targets[2 * app] == parser->targets[2 * app + 1]))
+        {
+            return circuit_text_error(parser, CIRCUIT_TEXT_ERR_SYNTAX);
+        }
+    }
+
+    parser->gate = gate;
+    parser->tag = circuit_text_angle_tag(angle);
+    parser->n_apps = n_apps;
+    return true;
+}
+
+/*
+ * circuit_text_stim_statement
+ * Parses a Stim statement, setting up the applications of a gate
+ * :: parser : circuit_text_parser_t* :: The parser
+ * Returns false on an error
+ */
+static bool circuit_text_stim_statement(circuit_text_parser_t* parser)
+{
+    const char* p = parser->buf;
+    const char* start;
+    const size_t len = __inline_circuit_text_ident(&p, &start);
+    if (0 == len)
+    {
+        return ('\0' == *__inline_circuit_text_skip(p)) || circuit_text_error(parser, CIRCUIT_TEXT_ERR_SYNTAX);
+    }
+
+    const bool declares = __inline_circuit_text_ident_caseeq(start, len, "QUBIT_COORDS");
+    if (__inline_circuit_text_ident_caseeq(start, len, "TICK")
+        || __inline_circuit_text_ident_caseeq(start, len, "DETECTOR")
+        || __inline_circuit_text_ident_caseeq(start, len, "SHIFT_COORDS")
+        || __inline_circuit_text_ident_caseeq(start, len, "OBSERVABLE_INCLUDE"))
+    {
+        return true;
+    }
+
+    const circuit_text_gate_t* gate = NULL;
+    if (!declares)
+    {
+        gate = circuit_text_find_gate(STIM_GATES, N_STIM_GATES, start, len, true);
+        if (NULL == gate)
+        {
+            return circuit_text_error(parser, CIRCUIT_TEXT_ERR_UNSUPPORTED);
+        }
+    }
+
+    // Coordinates are skipped, gates do not take arguments
+    if (__inline_circuit_text_accept(&p, '('))
+    {
+        if (!declares)
+        {
+            return circuit_text_error(parser, CIRCUIT_TEXT_ERR_SYNTAX);
+        }
+        while (('\0' != *p) && (')' != *p))
+        {
+            p++;
+        }
+        if (!__inline_circuit_text_accept(&p, ')'))
+        {
+            return circuit_text_error(parser, CIRCUIT_TEXT_ERR_SYNTAX);
+        }
+    }
+
+    size_t n_targets = 0;
+    for (p = __inline_circuit_text_skip(p); '\0' != *p; p = __inline_circuit_text_skip(p))
+    {
+        uint64_t target;
+        if (('!' == *p) || (0 == strncmp(p, "rec[", 4)) || (0 == strncmp(p, "sweep[", 6)))
+        {
+            // Inverted targets, measurement records and sweep bits
+            return circuit_text_error(parser, CIRCUIT_TEXT_ERR_UNSUPPORTED);
+        }
+        if (!__inline_circuit_text_uint(&p, &target) || (UINT32_MAX == target)
+            || !(isspace((unsigned char)*p) || ('\0' == *p)))
+        {
+            return circuit_text_error(parser, CIRCUIT_TEXT_ERR_SYNTAX);
+        }
+        circuit_text_reserve_targets(parser, n_targets + 1);
+        parser->targets[n_targets++] = target;
+        if (target >= parser->n_qubits)
+        {
+            parser->n_qubits = target + 1;
+        }
+    }
+    if (declares)
+    {
+        return true;
+    }
+
+    if (0 != n_targets % gate->arity)
+    {
+        return circuit_text_error(parser, CIRCUIT_TEXT_ERR_SYNTAX);
+    }
+    if (2 == gate->arity)
+    {
+        for (size_t i = 0; i < n_targets; i += 2)
+        {
+            if (parser->targets[i] == parser->targets[i + 1])
+            {
+                return circuit_text_error(parser, CIRCUIT_TEXT_ERR_SYNTAX);
+            }
+        }
+    }
+
+    parser->gate = gate;
+    parser->tag = 0;
+    parser->n_apps = n_targets / gate->arity;
+    return true;
+}
+
+/*
+ * circuit_text_next_statement
+ * Reads statements until one with at least one application of a gate
+ * :: parser : circuit_text_parser_t* :: The parser
+ * Returns false at the end of the file or on an error
+ */
+static bool circuit_text_next_statement(circuit_text_parser_t* parser)
+{
+    parser->n_apps = 0;
+    parser->app = 0;
+    parser->op = 0;
+    while (CIRCUIT_TEXT_OK == parser->status)
+    {
+        if (!circuit_text_read_statement(parser))
+        {
+            return false;
+        }
+        const bool ok = (CIRCUIT_TEXT_QASM == parser->format)
+            ? circuit_text_qasm_statement(parser)
+            : circuit_text_stim_statement(parser);
+        if (!ok)
+        {
+            return false;
+        }
+        if ((parser->n_apps > 0) && (parser->gate->n_ops > 0))
+        {
+            return true;
+        }
+        parser->n_apps = 0;
+    }
+    return false;
+}
+
+/*
+ * circuit_text_read_header
+ * Reads up to the first gate of the circuit
+ * :: parser : circuit_text_parser_t* :: The parser
+ * The first gate is held and emitted by the next call to circuit_text_read
+ */
+size_t circuit_text_read_header(circuit_text_parser_t* parser)
+{
+    if ((parser->app == parser->n_apps) && (CIRCUIT_TEXT_OK == parser->status))
+    {
+        circuit_text_next_statement(parser);
+    }
+    return parser->n_qubits;
+}
+
+/*
+ * circuit_text_read
+ * Reads the next block of instructions
+ * :: parser : circuit_text_parser_t* :: The parser
+ * :: instructions : instruction_stream_u* :: Block to write
+ * :: max_instructions : const size_t :: Length of the block
+ * Statements may be split across blocks
+ */
+size_t circuit_text_read(
+    circuit_text_parser_t* parser,
+    instruction_stream_u* instructions,
+    const size_t max_instructions)
+{
+    size_t n = 0;
+    while (n < max_instructions)
+    {
+        if (parser->app == parser->n_apps)
+        {
+            if (!circuit_text_next_statement(parser))
+            {
+                break;
+            }
+        }
+
+        const circuit_text_gate_t* gate = parser->gate;
+        const uint32_t* targets = parser->targets + parser->app * gate->arity;
+        const struct circuit_text_op_t* op = gate->ops + parser->op;
+        instruction_stream_u* inst = instructions + n++;
+        switch (op->role)
+        {
+            case CIRCUIT_TEXT_Q0:
+            case CIRCUIT_TEXT_Q1:
+                inst->rz.opcode = op->opcode;
+                inst->rz.arg = targets[op->role];
+                inst->rz.tag = (_RZ_ == op->opcode) ? parser->tag : 0;
+                break;
+            default:
+                inst->multi.opcode = op->opcode;
+                inst->multi.ctrl = targets[CIRCUIT_TEXT_Q10 == op->role];
+                inst->multi.targ = targets[CIRCUIT_TEXT_Q01 == op->role];
+        }
+
+        if (++parser->op == gate->n_ops)
+        {
+            parser->op = 0;
+            parser->app++;
+        }
+    }
+    return n;
+}
+
+/*
+ * circuit_text_parse
+ * Streams a text circuit into a widget
+ * :: wid : widget_t* :: Current widget
+ * :: parser : circuit_text_parser_t* :: The parser
+ * Instructions are passed to parse_instruction_block CIRCUIT_TEXT_WINDOW at a time
+ * Blocks that would use more qubits than the widget has stop the parse with CIRCUIT_TEXT_ERR_QUBITS
+ * Returns the number of instructions parsed
+ */
+size_t circuit_text_parse(widget_t* wid, circuit_text_parser_t* parser)
+{
+    instruction_stream_u* window = malloc(CIRCUIT_TEXT_WINDOW * sizeof(instruction_stream_u));
+    NULL_CHECK(window);
+
+    size_t n_parsed = 0;
+    size_t n;
+    while ((n = circuit_text_read(parser, window, CIRCUIT_TEXT_WINDOW)))
+    {
+        size_t n_rz = 0;
+        for (size_t i = 0; i < n; i++)
+        {
+            n_rz += (_RZ_ == window[i].instruction);
+        }
+        if ((parser->n_qubits > wid->n_initial_qubits) || (wid->n_qubits + n_rz > wid->max_qubits))
+        {
+            circuit_text_error(parser, CIRCUIT_TEXT_ERR_QUBITS);
+            break;
+        }
+        parse_instruction_block(wid, window, n);
+        n_parsed += n;
+    }
+
+    free(window);
+    return n_parsed;
+}
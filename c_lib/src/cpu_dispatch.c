@@ -0,0 +1,202 @@
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "cpu_dispatch.h"
+#include "tableau_operations.h"
+#include "tableau_simd_operations.h"
+#include "simd_transpose.h"
+
+static const char* CPU_ISA_NAMES[] = {"scalar", "avx2", "avx512"};
+static const char* CPU_TRANSPOSE_NAMES[] = {"pdep", "shuffle"};
+
+static uint8_t cpu_transpose = CPU_TRANSPOSE_PDEP;
+
+/*
+ * Scalar defaults so that the table is valid before the constructor has run
+ */
+struct cpu_dispatch_table CPU_DISPATCH = {
+    CPU_ISA_SCALAR,
+    TABLEAU_SCALAR_SINGLE_QUBIT_KERNELS,
+    TABLEAU_SCALAR_TWO_QUBIT_KERNELS,
+    chunk_transpose_64x64,
+    chunk_transpose_64x64_inplace,
+    tableau_ctz_scalar,
+    tableau_transverse_hadamard_scalar
+};
+
+
+/*
+ * cpu_dispatch_detect
+ * Returns the widest supported instruction set level on this host
+ */
+uint8_t cpu_dispatch_detect(void)
+{
+    __builtin_cpu_init();
+
+    if (!(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi") && __builtin_cpu_supports("bmi2")))
+    {
+        return CPU_ISA_SCALAR;
+    }
+
+    if (!__builtin_cpu_supports("avx512f"))
+    {
+        return CPU_ISA_AVX2;
+    }
+
+    return CPU_ISA_AVX512;
+}
+
+
+/*
+ * cpu_dispatch_transpose_detect
+ * Returns the preferred 64x64 transpose for the AVX2 and AVX-512 levels on this host
+ * pdep and pext are microcoded on family 17h, Zen3 onwards execute them in hardware
+ */
+uint8_t cpu_dispatch_transpose_detect(void)
+{
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_is("amdfam17h"))
+    {
+        return CPU_TRANSPOSE_SHUFFLE;
+    }
+    return CPU_TRANSPOSE_PDEP;
+}
+
+
+/*
+ * cpu_dispatch_set_transpose
+ * Points the transpose entries of the dispatch table at the kernels for the current level
+ */
+static void cpu_dispatch_set_transpose(void)
+{
+    if (CPU_ISA_SCALAR == CPU_DISPATCH.isa)
+    {
+        CPU_DISPATCH.transpose_64x64 = chunk_transpose_64x64;
+        CPU_DISPATCH.transpose_64x64_inplace = chunk_transpose_64x64_inplace;
+    }
+    else if (CPU_TRANSPOSE_SHUFFLE == cpu_transpose)
+    {
+        CPU_DISPATCH.transpose_64x64 = shuffle_transpose_64x64;
+        CPU_DISPATCH.transpose_64x64_inplace = shuffle_transpose_64x64_inplace;
+    }
+    else
+    {
+        CPU_DISPATCH.transpose_64x64 = simd_transpose_64x64;
+        CPU_DISPATCH.transpose_64x64_inplace = simd_transpose_64x64_inplace;
+    }
+}
+
+
+/*
+ * cpu_dispatch_select_transpose
+ * Sets the 64x64 transpose used by the AVX2 and AVX-512 levels
+ * :: transpose : const uint8_t :: One of CPU_TRANSPOSE_PDEP or CPU_TRANSPOSE_SHUFFLE
+ */
+void cpu_dispatch_select_transpose(const uint8_t transpose)
+{
+    assert(transpose <= CPU_TRANSPOSE_SHUFFLE);
+
+    cpu_transpose = transpose;
+    cpu_dispatch_set_transpose();
+    DPRINT(DEBUG_1, "Selected %s transpose\n", CPU_TRANSPOSE_NAMES[transpose]);
+}
+
+
+/*
+ * cpu_dispatch_select
+ * Sets the dispatch table to the kernels for an instruction set level
+ * :: isa : const uint8_t :: Instruction set level, must be supported by the host
+ */
+void cpu_dispatch_select(const uint8_t isa)
+{
+    assert(isa <= cpu_dispatch_detect());
+
+    CPU_DISPATCH.isa = isa;
+    switch (isa)
+    {
+        case CPU_ISA_AVX512:
+            CPU_DISPATCH.single_qubit_kernels = TABLEAU_AVX512_SINGLE_QUBIT_KERNELS;
+            CPU_DISPATCH.two_qubit_kernels = TABLEAU_AVX512_TWO_QUBIT_KERNELS;
+            CPU_DISPATCH.ctz = tableau_ctz_avx512;
+            CPU_DISPATCH.transverse_hadamard = tableau_transverse_hadamard_avx512;
+            break;
+        case CPU_ISA_AVX2:
+            CPU_DISPATCH.single_qubit_kernels = TABLEAU_AVX2_SINGLE_QUBIT_KERNELS;
+            CPU_DISPATCH.two_qubit_kernels = TABLEAU_AVX2_TWO_QUBIT_KERNELS;
+            CPU_DISPATCH.ctz = tableau_ctz_avx2;
+            CPU_DISPATCH.transverse_hadamard = tableau_transverse_hadamard_avx2;
+            break;
+        default:
+            CPU_DISPATCH.single_qubit_kernels = TABLEAU_SCALAR_SINGLE_QUBIT_KERNELS;
+            CPU_DISPATCH.two_qubit_kernels = TABLEAU_SCALAR_TWO_QUBIT_KERNELS;
+            CPU_DISPATCH.ctz = tableau_ctz_scalar;
+            CPU_DISPATCH.transverse_hadamard = tableau_transverse_hadamard_scalar;
+            break;
+    }
+    cpu_dispatch_set_transpose();
+
+#if TABLEAU_LAYOUT == TABLEAU_LAYOUT_TILES
+    // Vectorised slice kernels assume that the chunks of a slice are contiguous
+    CPU_DISPATCH.single_qubit_kernels = TABLEAU_SCALAR_SINGLE_QUBIT_KERNELS;
+    CPU_DISPATCH.two_qubit_kernels = TABLEAU_SCALAR_TWO_QUBIT_KERNELS;
+    CPU_DISPATCH.ctz = tableau_ctz_scalar;
+#endif
+    DPRINT(DEBUG_1, "Selected %s kernels\n", cpu_dispatch_isa_name(isa));
+}
+
+
+/*
+ * cpu_dispatch_isa_name
+ * Returns a printable name for an instruction set level
+ * :: isa : const uint8_t :: Instruction set level
+ */
+const char* cpu_dispatch_isa_name(const uint8_t isa)
+{
+    assert(isa <= CPU_ISA_AVX512);
+    return CPU_ISA_NAMES[isa];
+}
+
+
+/*
+ * cpu_dispatch_init
+ * Selects the widest supported kernels when the library is loaded
+ * The selection is capped by the CABALISER_ISA environment variable if it is set
+ * The transpose is chosen by the host unless CABALISER_TRANSPOSE is set
+ */
+static void __attribute__((constructor)) cpu_dispatch_init(void)
+{
+    uint8_t isa = cpu_dispatch_detect();
+
+    const char* env_isa = getenv(CPU_ISA_ENV);
+    if (NULL != env_isa)
+    {
+        for (uint8_t i = CPU_ISA_SCALAR; i < isa; i++)
+        {
+            if (0 == strcmp(env_isa, CPU_ISA_NAMES[i]))
+            {
+                isa = i;
+                break;
+            }
+        }
+    }
+
+    uint8_t transpose = cpu_dispatch_transpose_detect();
+
+    const char* env_transpose = getenv(CPU_TRANSPOSE_ENV);
+    if (NULL != env_transpose)
+    {
+        for (uint8_t i = CPU_TRANSPOSE_PDEP; i <= CPU_TRANSPOSE_SHUFFLE; i++)
+        {
+            if (0 == strcmp(env_transpose, CPU_TRANSPOSE_NAMES[i]))
+            {
+                transpose = i;
+                break;
+            }
+        }
+    }
+
+    cpu_transpose = transpose;
+    cpu_dispatch_select(isa);
+}
@@ -21,6 +21,36 @@ void __inline_local_clifford_gate(
     return;
 } 
 
+/*
+ * local_clifford_run
+ * Applies a run of consecutive local Clifford operations to the widget
+ * :: wid : widget_t* :: The widget
+ * :: instructions : instruction_stream_u* :: Array of instructions
+ * :: start : size_t :: First instruction of the run, which must be a local Clifford
+ * :: n_instructions : const size_t :: Number of instructions in the stream
+ * Returns the index of the first instruction after the run
+ */
+static inline
+size_t __inline_local_clifford_run(
+    widget_t* wid,
+    instruction_stream_u* instructions,
+    size_t start,
+    const size_t n_instructions)
+{
+    instruction_t* table = wid->queue->table;
+    const qubit_map_t* q_map = wid->q_map;
+    do
+    {
+        const struct single_qubit_instruction* inst = &instructions[start].single;
+        const size_t target = q_map[inst->arg];
+        table[target] = LOCAL_CLIFFORD_LEFT(inst->opcode, table[target]);
+        PAULI_TRACKER_LOCAL(inst->opcode)(wid->pauli_tracker, target);
+        start++;
+    } while ((start < n_instructions)
+        && (INSTRUCTION_TYPE(LOCAL_CLIFFORD_MASK) == INSTRUCTION_TYPE(instructions[start].instruction)));
+    return start;
+}
+
 /*
  * apply_local_cliffords
  * Empties the local clifford table and applies the local cliffords
@@ -29,19 +59,50 @@ void __inline_local_clifford_gate(
  */
 void apply_local_cliffords(widget_t* wid)
 {
+    tableau_apply_local_cliffords(wid->tableau, wid->queue->table, wid->n_qubits);
     for (size_t i = 0; i < wid->n_qubits; i++)
     {
-        SINGLE_QUBIT_OPERATIONS[wid->queue->table[i] & INSTRUCTION_OPERATOR_MASK](wid->tableau, i);
         wid->queue->table[i] = _I_; 
     }
 }
 
+/*
+ * non_local_clifford_op
+ * Resolves a non-local Clifford operation into a fused tableau operation
+ * :: wid : widget_t* :: The widget
+ * :: inst : two_qubit_instruction_t* :: The non-local Clifford operation 
+ * Empties the queued local Cliffords on both qubits and updates the Pauli tracker
+ * The returned operation must be applied to the tableau before any later operation on these qubits
+ */
+static inline
+struct tableau_fused_instruction __inline_non_local_clifford_op(
+    widget_t* wid,
+    struct two_qubit_instruction* inst)
+{
+    struct tableau_fused_instruction op;
+    op.ctrl = wid->q_map[inst->ctrl]; 
+    op.targ = wid->q_map[inst->targ]; 
+
+    // The queued cliffords are merged with the gate into a single pass over the tableau 
+    op.op = FUSED_TWO_QUBIT_OPERATION(
+        inst->opcode,
+        wid->queue->table[op.ctrl],
+        wid->queue->table[op.targ]);
+    wid->queue->table[op.ctrl] = _I_;
+    wid->queue->table[op.targ] = _I_;
+
+    // Pauli Correction Tracking
+    PAULI_TRACKER_NON_LOCAL(inst->opcode)(wid->pauli_tracker, op.ctrl, op.targ);
+
+    return op;
+} 
+
 /*
  * non_local_clifford_gate
  * Applies a non-local Clifford operation to the widget
  * Local in this context implies a single qubit operation
  * :: wid : widget_t* :: The widget
- * :: inst : single_qubit_instruction_t* :: The local Clifford operation 
+ * :: inst : two_qubit_instruction_t* :: The non-local Clifford operation 
  * Acts in place on the widget, should only update one entry in the local Clifford table 
  */
 static inline
@@ -49,62 +110,68 @@ void __inline_non_local_clifford_gate(
     widget_t* wid,
     struct two_qubit_instruction* inst)
 {
-    // First pass dump the tables and implement the instruction
-    size_t ctrl = wid->q_map[inst->ctrl]; 
-    size_t targ = wid->q_map[inst->targ]; 
-
-    // Execute the queued cliffords 
-    // TODO : Merge these operations with CX/CZ gates to cut runtime to one third 
-    SINGLE_QUBIT_OPERATIONS[wid->queue->table[ctrl] & INSTRUCTION_OPERATOR_MASK](wid->tableau, ctrl);
-    wid->queue->table[ctrl] = _I_;
-
-    SINGLE_QUBIT_OPERATIONS[wid->queue->table[targ] & INSTRUCTION_OPERATOR_MASK](wid->tableau, targ);
-    wid->queue->table[targ] = _I_;
-    TWO_QUBIT_OPERATIONS[inst->opcode & INSTRUCTION_OPERATOR_MASK](wid->tableau, ctrl, targ);
-
-    // Pauli Correction Tracking
-    PAULI_TRACKER_NON_LOCAL(inst->opcode)(wid->pauli_tracker, ctrl, targ);
-
+    struct tableau_fused_instruction op = __inline_non_local_clifford_op(wid, inst);
+    tableau_fused_operation_apply(wid->tableau, op.op, op.ctrl, op.targ);
     return;
 } 
 
 /*
- * rz_gate 
- * Implements an rz gate as a terminating operation
+ * rz_op 
+ * Resolves an rz gate into a fused tableau operation
  * :: wid : widget_t* :: The widget in question 
  * :: inst : rz_instruction* :: The rz instruction indicating an angle 
- * Teleports an RZ operation, allocating a new qubit in the process
+ * Allocates the teleported qubit and updates the measurement tags and Pauli tracker 
  * Compilation fails if the number of qubits exceeds some maximum 
  */
 static inline
-void __inline_rz_gate(
+struct tableau_fused_instruction __inline_rz_op(
     widget_t* wid,
     struct rz_instruction* inst) 
 {
     
     // This could be handled with a better return
     assert(wid->n_qubits < wid->max_qubits);
+    widget_reserve_qubits(wid, wid->n_qubits + 1);
 
-    const size_t ctrl = WMAP_LOOKUP(wid, inst->arg);
-    const size_t targ = wid->n_qubits; 
+    struct tableau_fused_instruction op;
+    op.ctrl = WMAP_LOOKUP(wid, inst->arg);
+    op.targ = wid->n_qubits; 
 
-    wid->queue->non_cliffords[ctrl] = inst->tag;
+    wid->queue->non_cliffords[op.ctrl] = inst->tag;
     wid->q_map[inst->arg] = wid->n_qubits;
 
-    SINGLE_QUBIT_OPERATIONS[wid->queue->table[ctrl] & INSTRUCTION_OPERATOR_MASK](wid->tableau, ctrl);
-    wid->queue->table[ctrl] = _I_;
-
-    SINGLE_QUBIT_OPERATIONS[wid->queue->table[targ] & INSTRUCTION_OPERATOR_MASK](wid->tableau, targ);
-    wid->queue->table[targ] = _I_;
-
-    tableau_CNOT(wid->tableau, ctrl, targ);
+    op.op = FUSED_TWO_QUBIT_OPERATION(
+        _CNOT_,
+        wid->queue->table[op.ctrl],
+        wid->queue->table[op.targ]);
+    wid->queue->table[op.ctrl] = _I_;
+    wid->queue->table[op.targ] = _I_;
 
     // Propagate tracked Pauli corrections 
-    pauli_track_z(wid->pauli_tracker, ctrl, targ);
+    pauli_track_z(wid->pauli_tracker, op.ctrl, op.targ);
 
     // Number of qubits increases by one
     wid->n_qubits += 1;  
+    tableau_set_active_qubits(wid->tableau, wid->n_qubits);
+
+    return op;
+}
 
+/*
+ * rz_gate 
+ * Implements an rz gate as a terminating operation
+ * :: wid : widget_t* :: The widget in question 
+ * :: inst : rz_instruction* :: The rz instruction indicating an angle 
+ * Teleports an RZ operation, allocating a new qubit in the process
+ * Compilation fails if the number of qubits exceeds some maximum 
+ */
+static inline
+void __inline_rz_gate(
+    widget_t* wid,
+    struct rz_instruction* inst) 
+{
+    struct tableau_fused_instruction op = __inline_rz_op(wid, inst);
+    tableau_fused_operation_apply(wid->tableau, op.op, op.ctrl, op.targ);
     return;
 }
 
@@ -157,14 +224,14 @@ void (*instruction_switch[N_INSTRUCTION_TYPES])(widget_t*, void*) = {
 };
 
 /*
- * parse_instruction_block
- * Parses a block of instructions 
+ * parse_instruction_block_dispatch
+ * Parses a block of instructions, applying each tableau operation as it is reached
  * :: wid : widget_t* :: Current widget 
  * :: instructions : instruction_stream_u* :: Array of instructions 
  * :: n_instructions : const size_t :: Number of instructions in the stream 
- * This implementation may be replaced with a thread pool dispatcher
  */
-void parse_instruction_block(
+static
+void parse_instruction_block_dispatch(
     widget_t* wid,
     instruction_stream_u* instructions,
     const size_t n_instructions)
@@ -179,6 +246,142 @@ void parse_instruction_block(
     return;
 }
 
+/*
+ * parse_instruction_block_threaded
+ * Parses a block of instructions, applying each tableau operation as it is reached
+ * :: wid : widget_t* :: Current widget 
+ * :: instructions : instruction_stream_u* :: Array of instructions 
+ * :: n_instructions : const size_t :: Number of instructions in the stream 
+ * Each handler jumps directly to the handler of the next instruction, so the handlers are inlined
+ * and each has its own indirect branch to predict
+ */
+static
+void parse_instruction_block_threaded(
+    widget_t* wid,
+    instruction_stream_u* instructions,
+    const size_t n_instructions)
+{
+    static const void* handlers[N_INSTRUCTION_TYPES] = {
+        &&invalid, // 0x00
+        &&local_clifford, // 0x01
+        &&non_local_clifford, // 0x02
+        &&invalid, // 0x03
+        &&rz, // 0x04
+        &&invalid, // 0x05
+        &&conditional, // 0x06
+        &&invalid, // 0x07
+    };
+    size_t i = 0;
+
+    #define THREADED_DISPATCH() \
+        if (i >= n_instructions) { return; } \
+        goto *handlers[INSTRUCTION_TYPE(instructions[i].instruction)];
+
+    THREADED_DISPATCH();
+
+    local_clifford:
+        i = __inline_local_clifford_run(wid, instructions, i, n_instructions);
+        THREADED_DISPATCH();
+
+    non_local_clifford:
+        __inline_non_local_clifford_gate(wid, &instructions[i++].multi);
+        THREADED_DISPATCH();
+
+    rz:
+        __inline_rz_gate(wid, &instructions[i++].rz);
+        THREADED_DISPATCH();
+
+    conditional:
+        __inline_conditional_instruction(wid, &instructions[i++].cond);
+        THREADED_DISPATCH();
+
+    invalid:
+        // instruction_switch has no handler for these either
+        assert(false);
+        i++;
+        THREADED_DISPATCH();
+
+    #undef THREADED_DISPATCH
+}
+
+/*
+ * parse_instruction_block_replay
+ * Parses a block of instructions, deferring tableau operations to a chunk range replay
+ * :: wid : widget_t* :: Current widget 
+ * :: instructions : instruction_stream_u* :: Array of instructions 
+ * :: n_instructions : const size_t :: Number of instructions in the stream 
+ * The widget bookkeeping for a window of instructions is resolved serially, the resulting tableau
+ * operations are then replayed inside a single parallel region 
+ */
+static
+void parse_instruction_block_replay(
+    widget_t* wid,
+    instruction_stream_u* instructions,
+    const size_t n_instructions)
+{
+    const size_t window = n_instructions < REPLAY_WINDOW ? n_instructions : REPLAY_WINDOW;
+    struct tableau_fused_instruction* ops = malloc(window * sizeof(struct tableau_fused_instruction));
+    NULL_CHECK(ops);
+
+    for (size_t i = 0; i < n_instructions; i += window)
+    {
+        const size_t window_end = (i + window < n_instructions) ? i + window : n_instructions;
+        size_t n_ops = 0;
+
+        for (size_t j = i; j < window_end;)
+        {
+            instruction_stream_u* inst = instructions + j++;
+            switch (INSTRUCTION_TYPE(inst->instruction))
+            {
+                case INSTRUCTION_TYPE(LOCAL_CLIFFORD_MASK):
+                    j = __inline_local_clifford_run(wid, instructions, j - 1, window_end);
+                    break;
+                case INSTRUCTION_TYPE(NON_LOCAL_CLIFFORD_MASK):
+                    ops[n_ops++] = __inline_non_local_clifford_op(wid, &inst->multi);
+                    break;
+                case INSTRUCTION_TYPE(RZ_MASK):
+                    ops[n_ops++] = __inline_rz_op(wid, &inst->rz);
+                    break;
+                case INSTRUCTION_TYPE(MEASUREMENT_CONDITIONED_MASK):
+                    __inline_conditional_instruction(wid, &inst->cond);
+                    break;
+            }
+        }
+        tableau_fused_replay(wid->tableau, ops, n_ops);
+    }
+
+    free(ops);
+    return;
+}
+
+/*
+ * parse_instruction_block
+ * Parses a block of instructions 
+ * :: wid : widget_t* :: Current widget 
+ * :: instructions : instruction_stream_u* :: Array of instructions 
+ * :: n_instructions : const size_t :: Number of instructions in the stream 
+ * The ingestion strategy is selected by the widget's ingest mode
+ */
+void parse_instruction_block(
+    widget_t* wid,
+    instruction_stream_u* instructions,
+    const size_t n_instructions)
+{
+    if (INGEST_CHUNK_REPLAY == wid->ingest_mode)
+    {
+        parse_instruction_block_replay(wid, instructions, n_instructions);
+    }
+    else if (INGEST_THREADED == wid->ingest_mode)
+    {
+        parse_instruction_block_threaded(wid, instructions, n_instructions);
+    }
+    else
+    {
+        parse_instruction_block_dispatch(wid, instructions, n_instructions);
+    }
+    return;
+}
+
 /*
  * teleport_input
  * Sets the widget up to accept teleported inputs
@@ -192,9 +395,11 @@ void teleport_input(widget_t* wid, size_t n_input_qubits)
 {
     // Check that we have sufficient memory for this operation
     assert(wid->max_qubits >= wid->n_initial_qubits + n_input_qubits);
+    widget_reserve_qubits(wid, wid->n_qubits + n_input_qubits);
 
     // Double the number of initial qubits 
     wid->n_qubits += n_input_qubits;
+    tableau_set_active_qubits(wid->tableau, wid->n_qubits);
     
     // This could be replaced with a different tableau preparation step
     for (size_t i = 0; i < n_input_qubits; i++)
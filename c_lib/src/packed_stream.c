@@ -0,0 +1,227 @@
+#include "packed_stream.h"
+#include "input_stream.h"
+#include "debug.h"
+
+/*
+ * __inline_packed_put_varint
+ * Writes a LEB128 varint
+ * :: bytes : uint8_t* :: Packed buffer
+ * :: pos : size_t :: Position to write to
+ * :: value : uint64_t :: Value to write
+ * Returns the position after the varint
+ */
+static inline
+size_t __inline_packed_put_varint(uint8_t* bytes, size_t pos, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        bytes[pos++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    bytes[pos++] = (uint8_t)value;
+    return pos;
+}
+
+/*
+ * __inline_packed_get_varint
+ * Reads a LEB128 varint
+ * :: dec : packed_stream_decoder_t* :: Decoder state, the position is advanced past the varint
+ * :: value : uint64_t* :: Written with the value read
+ * Returns false if the buffer ends inside the varint or it is longer than five bytes
+ */
+static inline
+bool __inline_packed_get_varint(packed_stream_decoder_t* dec, uint64_t* value)
+{
+    // Single byte values are the common case for local circuits
+    if (dec->pos >= dec->n_bytes)
+    {
+        return false;
+    }
+    uint8_t byte = dec->bytes[dec->pos++];
+    *value = byte & 0x7f;
+    for (size_t shift = 7; byte & 0x80; shift += 7)
+    {
+        if ((dec->pos >= dec->n_bytes) || (shift > 28))
+        {
+            return false;
+        }
+        byte = dec->bytes[dec->pos++];
+        *value |= (uint64_t)(byte & 0x7f) << shift;
+    }
+    return true;
+}
+
+/*
+ * __inline_packed_zigzag
+ * __inline_packed_unzigzag
+ * Maps signed differences to unsigned values with small magnitudes first, 0, -1, 1, -2, ...
+ */
+static inline
+uint64_t __inline_packed_zigzag(const int64_t value)
+{
+    return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+static inline
+int64_t __inline_packed_unzigzag(const uint64_t value)
+{
+    return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+/*
+ * packed_stream_encode
+ * Packs an array of instructions
+ * :: instructions : const instruction_stream_u* :: Array of instructions
+ * :: n_instructions : const size_t :: Number of instructions
+ * :: bytes : uint8_t* :: Packed buffer, at least packed_stream_bound(n_instructions) bytes
+ * Returns the number of bytes written
+ */
+size_t packed_stream_encode(
+    const instruction_stream_u* instructions,
+    const size_t n_instructions,
+    uint8_t* bytes)
+{
+    size_t pos = 0;
+    non_clifford_tag_t tag = 0;
+    for (size_t i = 0; i < n_instructions; i++)
+    {
+        const instruction_stream_u* inst = instructions + i;
+        bytes[pos++] = inst->instruction;
+        switch (INSTRUCTION_TYPE(inst->instruction))
+        {
+            case INSTRUCTION_TYPE(LOCAL_CLIFFORD_MASK):
+                pos = __inline_packed_put_varint(bytes, pos, inst->single.arg);
+                break;
+            case INSTRUCTION_TYPE(NON_LOCAL_CLIFFORD_MASK):
+                pos = __inline_packed_put_varint(bytes, pos, inst->multi.ctrl);
+                pos = __inline_packed_put_varint(bytes, pos,
+                    __inline_packed_zigzag((int64_t)inst->multi.targ - (int64_t)inst->multi.ctrl));
+                break;
+            case INSTRUCTION_TYPE(RZ_MASK):
+                pos = __inline_packed_put_varint(bytes, pos, inst->rz.arg);
+                pos = __inline_packed_put_varint(bytes, pos,
+                    __inline_packed_zigzag((int64_t)inst->rz.tag - (int64_t)tag));
+                tag = inst->rz.tag;
+                break;
+            case INSTRUCTION_TYPE(MEASUREMENT_CONDITIONED_MASK):
+                pos = __inline_packed_put_varint(bytes, pos, inst->cond.ctrl);
+                pos = __inline_packed_put_varint(bytes, pos,
+                    __inline_packed_zigzag((int64_t)inst->cond.targ - (int64_t)inst->cond.ctrl));
+                break;
+            default:
+                // Not parsed by parse_instruction_block either
+                assert(false);
+        }
+    }
+    return pos;
+}
+
+/*
+ * packed_stream_decoder_init
+ * Starts a decode at the beginning of a packed buffer
+ * :: dec : packed_stream_decoder_t* :: Decoder to initialise
+ * :: bytes : const uint8_t* :: Packed buffer
+ * :: n_bytes : const size_t :: Length of the packed buffer
+ */
+void packed_stream_decoder_init(
+    packed_stream_decoder_t* dec,
+    const uint8_t* bytes,
+    const size_t n_bytes)
+{
+    dec->bytes = bytes;
+    dec->n_bytes = n_bytes;
+    dec->pos = 0;
+    dec->tag = 0;
+    dec->status = PACKED_STREAM_OK;
+}
+
+/*
+ * packed_stream_decode
+ * Unpacks the next block of instructions
+ * :: dec : packed_stream_decoder_t* :: Decoder state
+ * :: instructions : instruction_stream_u* :: Array to write to
+ * :: max_instructions : const size_t :: Length of the array
+ * Returns the number of instructions written, zero once the buffer is exhausted
+ */
+size_t packed_stream_decode(
+    packed_stream_decoder_t* dec,
+    instruction_stream_u* instructions,
+    const size_t max_instructions)
+{
+    size_t n = 0;
+    for (; (n < max_instructions) && (dec->pos < dec->n_bytes) && (PACKED_STREAM_OK == dec->status); n++)
+    {
+        instruction_stream_u* inst = instructions + n;
+        const instruction_t opcode = dec->bytes[dec->pos++];
+        uint64_t first = 0;
+        uint64_t second = 0;
+        bool ok = __inline_packed_get_varint(dec, &first);
+        switch (INSTRUCTION_TYPE(opcode))
+        {
+            case INSTRUCTION_TYPE(LOCAL_CLIFFORD_MASK):
+                inst->single.opcode = opcode;
+                inst->single.arg = first;
+                break;
+            case INSTRUCTION_TYPE(NON_LOCAL_CLIFFORD_MASK):
+                ok = ok && __inline_packed_get_varint(dec, &second);
+                inst->multi.opcode = opcode;
+                inst->multi.ctrl = first;
+                inst->multi.targ = inst->multi.ctrl + __inline_packed_unzigzag(second);
+                break;
+            case INSTRUCTION_TYPE(RZ_MASK):
+                ok = ok && __inline_packed_get_varint(dec, &second);
+                inst->rz.opcode = opcode;
+                inst->rz.arg = first;
+                dec->tag += __inline_packed_unzigzag(second);
+                inst->rz.tag = dec->tag;
+                break;
+            case INSTRUCTION_TYPE(MEASUREMENT_CONDITIONED_MASK):
+                ok = ok && __inline_packed_get_varint(dec, &second);
+                inst->cond.opcode = opcode;
+                inst->cond.ctrl = first;
+                inst->cond.targ = inst->cond.ctrl + __inline_packed_unzigzag(second);
+                break;
+            default:
+                dec->status = PACKED_STREAM_ERR_OPCODE;
+                return n;
+        }
+        if (!ok)
+        {
+            dec->status = PACKED_STREAM_ERR_TRUNCATED;
+            return n;
+        }
+    }
+    return n;
+}
+
+/*
+ * parse_packed_block
+ * Parses a packed buffer of instructions
+ * :: wid : widget_t* :: Current widget
+ * :: bytes : const uint8_t* :: Packed buffer
+ * :: n_bytes : const size_t :: Length of the packed buffer
+ * Instructions are decoded PACKED_STREAM_WINDOW at a time and passed to parse_instruction_block
+ * Returns the number of instructions parsed
+ */
+size_t parse_packed_block(
+    widget_t* wid,
+    const uint8_t* bytes,
+    const size_t n_bytes)
+{
+    instruction_stream_u* window = malloc(PACKED_STREAM_WINDOW * sizeof(instruction_stream_u));
+    NULL_CHECK(window);
+
+    packed_stream_decoder_t dec;
+    packed_stream_decoder_init(&dec, bytes, n_bytes);
+
+    size_t n_instructions = 0;
+    size_t n_decoded;
+    while ((n_decoded = packed_stream_decode(&dec, window, PACKED_STREAM_WINDOW)))
+    {
+        parse_instruction_block(wid, window, n_decoded);
+        n_instructions += n_decoded;
+    }
+
+    free(window);
+    return n_instructions;
+}
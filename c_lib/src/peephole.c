@@ -0,0 +1,344 @@
+#include "peephole.h"
+#include "instructions.h"
+#include "debug.h"
+
+// Paulis as x and z bits, bit 0 is x and bit 1 is z
+#define PEEPHOLE_PAULI_X (0x1)
+#define PEEPHOLE_PAULI_Z (0x2)
+
+static const instruction_t PEEPHOLE_PAULI_OPCODES[4] = {_NOP_, _X_, _Z_, _Y_};
+
+/*
+ * __inline_peephole_is_pauli
+ * Checks if an opcode is a Pauli gate
+ * :: opcode : const instruction_t :: The opcode
+ */
+static inline
+bool __inline_peephole_is_pauli(const instruction_t opcode)
+{
+    return (_X_ == opcode) || (_Y_ == opcode) || (_Z_ == opcode);
+}
+
+/*
+ * __inline_peephole_is_diagonal
+ * Checks if an opcode is a local Clifford that is diagonal in the computational basis
+ * :: opcode : const instruction_t :: The opcode
+ */
+static inline
+bool __inline_peephole_is_diagonal(const instruction_t opcode)
+{
+    return (_I_ == opcode) || (_Z_ == opcode) || (_S_ == opcode) || (_R_ == opcode);
+}
+
+/*
+ * __inline_peephole_acts_on
+ * Checks if an instruction acts on a qubit
+ * :: inst : const instruction_stream_u* :: The instruction
+ * :: qubit : const uint32_t :: The qubit
+ */
+static inline
+bool __inline_peephole_acts_on(const instruction_stream_u* inst, const uint32_t qubit)
+{
+    switch (INSTRUCTION_TYPE(inst->instruction))
+    {
+        case INSTRUCTION_TYPE(LOCAL_CLIFFORD_MASK):
+            return qubit == inst->single.arg;
+        case INSTRUCTION_TYPE(RZ_MASK):
+            return qubit == inst->rz.arg;
+        default:
+            if (_NOP_ == inst->instruction)
+            {
+                return false;
+            }
+            return (qubit == inst->multi.ctrl) || (qubit == inst->multi.targ);
+    }
+}
+
+/*
+ * __inline_peephole_local_commutes
+ * Checks if a local Clifford commutes with a two qubit gate
+ * :: opcode : const instruction_t :: The local Clifford
+ * :: qubit : const uint32_t :: Qubit of the local Clifford
+ * :: gate : const struct two_qubit_instruction* :: The two qubit gate, acting on the qubit
+ */
+static inline
+bool __inline_peephole_local_commutes(
+    const instruction_t opcode,
+    const uint32_t qubit,
+    const struct two_qubit_instruction* gate)
+{
+    if (__inline_peephole_is_diagonal(opcode))
+    {
+        return (_CZ_ == gate->opcode) || (qubit == gate->ctrl);
+    }
+    return (_X_ == opcode) && (_CNOT_ == gate->opcode) && (qubit == gate->targ);
+}
+
+/*
+ * __inline_peephole_gates_commute
+ * Checks if two distinct two qubit gates that share at least one qubit commute
+ * :: gate : const struct two_qubit_instruction* :: The first gate
+ * :: other : const struct two_qubit_instruction* :: The second gate
+ */
+static inline
+bool __inline_peephole_gates_commute(
+    const struct two_qubit_instruction* gate,
+    const struct two_qubit_instruction* other)
+{
+    const bool shares_ctrl = (gate->ctrl == other->ctrl) || (gate->ctrl == other->targ);
+    const bool shares_targ = (gate->targ == other->ctrl) || (gate->targ == other->targ);
+    if (shares_ctrl && shares_targ)
+    {
+        return false;
+    }
+
+    // The shared qubit of each gate
+    const uint32_t shared = shares_ctrl ? gate->ctrl : gate->targ;
+    const bool gate_z = (_CZ_ == gate->opcode) || (shared == gate->ctrl);
+    const bool other_z = (_CZ_ == other->opcode) || (shared == other->ctrl);
+
+    // Both gates are diagonal on the shared qubit, or both are CNOT targets on it
+    return (gate_z && other_z) || (!gate_z && !other_z);
+}
+
+/*
+ * __inline_peephole_pushed_pauli
+ * Pauli picked up on the other qubit when a Pauli is pushed through a two qubit gate
+ * :: opcode : const instruction_t :: The Pauli
+ * :: qubit : const uint32_t :: Qubit of the Pauli
+ * :: gate : const struct two_qubit_instruction* :: The two qubit gate, acting on the qubit
+ * Returns the picked up Pauli as x and z bits
+ */
+static inline
+uint8_t __inline_peephole_pushed_pauli(
+    const instruction_t opcode,
+    const uint32_t qubit,
+    const struct two_qubit_instruction* gate)
+{
+    const bool has_x = (_X_ == opcode) || (_Y_ == opcode);
+    const bool has_z = (_Z_ == opcode) || (_Y_ == opcode);
+    if (_CZ_ == gate->opcode)
+    {
+        return has_x ? PEEPHOLE_PAULI_Z : 0;
+    }
+    if (qubit == gate->ctrl)
+    {
+        return has_x ? PEEPHOLE_PAULI_X : 0;
+    }
+    return has_z ? PEEPHOLE_PAULI_Z : 0;
+}
+
+/*
+ * __inline_peephole_set_pauli
+ * Overwrites an instruction with a Pauli, or with a no-op for the identity
+ * :: inst : instruction_stream_u* :: The instruction slot
+ * :: pauli : const uint8_t :: The Pauli as x and z bits
+ * :: qubit : const uint32_t :: Qubit of the Pauli
+ * Returns 1 if the slot was emptied
+ */
+static inline
+size_t __inline_peephole_set_pauli(instruction_stream_u* inst, const uint8_t pauli, const uint32_t qubit)
+{
+    inst->single.opcode = PEEPHOLE_PAULI_OPCODES[pauli];
+    inst->single.arg = qubit;
+    return 0 == pauli;
+}
+
+/*
+ * peephole_non_local
+ * Searches for a two qubit gate that cancels against the gate at a position
+ * :: instructions : instruction_stream_u* :: Array of instructions
+ * :: idx : const size_t :: Position of the two qubit gate
+ * :: n_instructions : const size_t :: Number of instructions
+ * :: stats : peephole_stats_t* :: Accumulates the work done
+ * Cancelled slots are overwritten with picked up Paulis or no-ops
+ * Returns the number of slots emptied
+ */
+static size_t peephole_non_local(
+    instruction_stream_u* instructions,
+    const size_t idx,
+    const size_t n_instructions,
+    peephole_stats_t* stats)
+{
+    const struct two_qubit_instruction gate = instructions[idx].multi;
+    const size_t end = (idx + PEEPHOLE_WINDOW < n_instructions) ? idx + PEEPHOLE_WINDOW + 1 : n_instructions;
+
+    // Paulis picked up on each qubit of the gate
+    uint8_t pushed_ctrl = 0;
+    uint8_t pushed_targ = 0;
+    size_t n_pushed = 0;
+
+    for (size_t i = idx + 1; i < end; i++)
+    {
+        instruction_stream_u* inst = instructions + i;
+        if (!__inline_peephole_acts_on(inst, gate.ctrl) && !__inline_peephole_acts_on(inst, gate.targ))
+        {
+            continue;
+        }
+
+        switch (INSTRUCTION_TYPE(inst->instruction))
+        {
+            case INSTRUCTION_TYPE(LOCAL_CLIFFORD_MASK):
+            {
+                const uint32_t qubit = inst->single.arg;
+                if (__inline_peephole_is_pauli(inst->single.opcode))
+                {
+                    const uint8_t pauli = __inline_peephole_pushed_pauli(inst->single.opcode, qubit, &gate);
+                    if (qubit == gate.ctrl)
+                    {
+                        pushed_targ ^= pauli;
+                    }
+                    else
+                    {
+                        pushed_ctrl ^= pauli;
+                    }
+                    n_pushed += (0 != pauli);
+                    continue;
+                }
+                if (__inline_peephole_local_commutes(inst->single.opcode, qubit, &gate))
+                {
+                    continue;
+                }
+                return 0;
+            }
+            case INSTRUCTION_TYPE(NON_LOCAL_CLIFFORD_MASK):
+            {
+                const struct two_qubit_instruction* other = &inst->multi;
+                const bool same_pair = (gate.ctrl == other->ctrl) && (gate.targ == other->targ);
+                const bool swapped_pair = (gate.ctrl == other->targ) && (gate.targ == other->ctrl);
+                if ((gate.opcode == other->opcode) && (same_pair || ((_CZ_ == gate.opcode) && swapped_pair)))
+                {
+                    size_t n_emptied = __inline_peephole_set_pauli(instructions + idx, pushed_ctrl, gate.ctrl);
+                    n_emptied += __inline_peephole_set_pauli(inst, pushed_targ, gate.targ);
+                    stats->n_cancelled++;
+                    stats->n_pushed += n_pushed;
+                    return n_emptied;
+                }
+                if (__inline_peephole_gates_commute(&gate, other))
+                {
+                    continue;
+                }
+                return 0;
+            }
+            default:
+                // RZ and measurement conditioned instructions are barriers
+                return 0;
+        }
+    }
+    return 0;
+}
+
+/*
+ * peephole_local
+ * Merges the local Clifford at a position into the next local Clifford on its qubit
+ * :: instructions : instruction_stream_u* :: Array of instructions
+ * :: idx : const size_t :: Position of the local Clifford
+ * :: n_instructions : const size_t :: Number of instructions
+ * :: stats : peephole_stats_t* :: Accumulates the work done
+ * Merges are only made if the product is itself a single instruction
+ * Returns the number of slots emptied
+ */
+static size_t peephole_local(
+    instruction_stream_u* instructions,
+    const size_t idx,
+    const size_t n_instructions,
+    peephole_stats_t* stats)
+{
+    const struct single_qubit_instruction gate = instructions[idx].single;
+    if (_I_ == gate.opcode)
+    {
+        instructions[idx].instruction = _NOP_;
+        return 1;
+    }
+
+    const size_t end = (idx + PEEPHOLE_WINDOW < n_instructions) ? idx + PEEPHOLE_WINDOW + 1 : n_instructions;
+    for (size_t i = idx + 1; i < end; i++)
+    {
+        instruction_stream_u* inst = instructions + i;
+        if (!__inline_peephole_acts_on(inst, gate.arg))
+        {
+            continue;
+        }
+
+        switch (INSTRUCTION_TYPE(inst->instruction))
+        {
+            case INSTRUCTION_TYPE(LOCAL_CLIFFORD_MASK):
+            {
+                const instruction_t product = LOCAL_CLIFFORD_LEFT(inst->single.opcode, gate.opcode);
+                if ((product & INSTRUCTION_OPERATOR_MASK) >= N_LOCAL_CLIFFORD_INSTRUCTIONS)
+                {
+                    return 0;
+                }
+                instructions[idx].instruction = _NOP_;
+                inst->single.opcode = (_I_ == product) ? _NOP_ : product;
+                stats->n_merged++;
+                return 1 + (_I_ == product);
+            }
+            case INSTRUCTION_TYPE(NON_LOCAL_CLIFFORD_MASK):
+                if (__inline_peephole_local_commutes(gate.opcode, gate.arg, &inst->multi))
+                {
+                    continue;
+                }
+                return 0;
+            default:
+                return 0;
+        }
+    }
+    return 0;
+}
+
+/*
+ * peephole_simplify
+ * Removes cancelling gates from an instruction stream
+ * :: instructions : instruction_stream_u* :: Array of instructions, simplified in place
+ * :: n_instructions : const size_t :: Number of instructions
+ * :: stats : peephole_stats_t* :: Accumulates the work done, may be NULL
+ * Kept instructions are compacted to the front of the array in their original order
+ * Returns the number of instructions kept
+ */
+size_t peephole_simplify(
+    instruction_stream_u* instructions,
+    const size_t n_instructions,
+    peephole_stats_t* stats)
+{
+    peephole_stats_t local_stats = {0};
+    peephole_stats_t* st = (NULL != stats) ? stats : &local_stats;
+
+    size_t n = n_instructions;
+    for (size_t pass = 0; pass < PEEPHOLE_MAX_PASSES; pass++)
+    {
+        size_t n_emptied = 0;
+        for (size_t i = 0; i < n; i++)
+        {
+            switch (INSTRUCTION_TYPE(instructions[i].instruction))
+            {
+                case INSTRUCTION_TYPE(LOCAL_CLIFFORD_MASK):
+                    n_emptied += peephole_local(instructions, i, n, st);
+                    break;
+                case INSTRUCTION_TYPE(NON_LOCAL_CLIFFORD_MASK):
+                    n_emptied += peephole_non_local(instructions, i, n, st);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        if (0 == n_emptied)
+        {
+            break;
+        }
+
+        size_t kept = 0;
+        for (size_t i = 0; i < n; i++)
+        {
+            if (_NOP_ != instructions[i].instruction)
+            {
+                instructions[kept++] = instructions[i];
+            }
+        }
+        assert(kept + n_emptied == n);
+        st->n_removed += n_emptied;
+        n = kept;
+    }
+    return n;
+}
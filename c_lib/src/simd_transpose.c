@@ -1,7 +1,7 @@
 #include "simd_transpose.h"
 
 // Transposes two blocks
-static inline
+static inline SIMD_TRANSPOSE_TARGET
 void __inline_simd_transpose_2x16(uint8_t** src, uint8_t** targ)
 {
     __m256i msrc = _mm256_set_epi16(
@@ -203,12 +203,14 @@ void __inline_simd_transpose_2x16(uint8_t** src, uint8_t** targ)
 
     return;
 }
+SIMD_TRANSPOSE_TARGET
 void simd_transpose_2x16(uint8_t** src, uint8_t** targ)
 {
     __inline_simd_transpose_2x16(src, targ); 
 }
 
 
+SIMD_TRANSPOSE_TARGET
 void simd_transpose_64x64(uint64_t* block_a[64], uint64_t* block_b[64])
 {
      uint64_t src_block[64] = {0};
@@ -253,6 +255,7 @@ void simd_transpose_64x64(uint64_t* block_a[64], uint64_t* block_b[64])
  
     return;
 }
+SIMD_TRANSPOSE_TARGET
 void simd_transpose_64x64_inplace(uint64_t* block_a[64])
 {
      uint64_t targ_block[64] = {0};
@@ -283,6 +286,130 @@ void simd_transpose_64x64_inplace(uint64_t* block_a[64])
 }
 
 
+/*
+ * Shuffle transposes
+ * pdep and pext are microcoded on Zen1 and Zen2, these kernels only use byte shuffles,
+ * unpacks and movemask so they run at full rate on any AVX2 host
+ *
+ * Each group of eight rows is byte transposed so that every 64 bit word holds an 8x8 block
+ * with one row per byte, movemask then reads one bit from each byte to emit eight rows
+ * of the transposed blocks at a time
+ */
+
+// Byte transposes eight rows, each 64 bit word of the outputs is an 8x8 bit block
+static inline SHUFFLE_TRANSPOSE_TARGET
+void __inline_shuffle_transpose_8x8(const uint64_t* rows, __m256i* lo, __m256i* hi)
+{
+    __m256i a = _mm256_loadu_si256((const __m256i*)rows);
+    __m256i b = _mm256_loadu_si256((const __m256i*)(rows + 4));
+
+    // Interleave the bytes of the two rows in each lane
+    const __m256i interleave = _mm256_setr_epi8(
+        0, 8, 1, 9, 2, 10, 3, 11, 4, 12, 5, 13, 6, 14, 7, 15,
+        0, 8, 1, 9, 2, 10, 3, 11, 4, 12, 5, 13, 6, 14, 7, 15);
+    a = _mm256_shuffle_epi8(a, interleave);
+    b = _mm256_shuffle_epi8(b, interleave);
+
+    // Rows 0, 1 and 4, 5 against rows 2, 3 and 6, 7
+    const __m256i r_0145 = _mm256_permute2x128_si256(a, b, 0x20);
+    const __m256i r_2367 = _mm256_permute2x128_si256(a, b, 0x31);
+
+    // Four rows per 32 bit word, bytes 0 to 3 in the low words and 4 to 7 in the high words
+    const __m256i w_lo = _mm256_unpacklo_epi16(r_0145, r_2367);
+    const __m256i w_hi = _mm256_unpackhi_epi16(r_0145, r_2367);
+
+    // Pair rows 0 to 3 with rows 4 to 7
+    const __m256i w_lo_swap = _mm256_permute4x64_epi64(w_lo, 0x4e);
+    const __m256i w_hi_swap = _mm256_permute4x64_epi64(w_hi, 0x4e);
+
+    *lo = _mm256_permute2x128_si256(
+        _mm256_unpacklo_epi32(w_lo, w_lo_swap),
+        _mm256_unpackhi_epi32(w_lo, w_lo_swap),
+        0x20);
+    *hi = _mm256_permute2x128_si256(
+        _mm256_unpacklo_epi32(w_hi, w_hi_swap),
+        _mm256_unpackhi_epi32(w_hi, w_hi_swap),
+        0x20);
+}
+
+// Transposes the four 8x8 blocks in a register into byte row_group of the target rows
+static inline SHUFFLE_TRANSPOSE_TARGET
+void __inline_shuffle_transpose_movemask(__m256i blocks, uint8_t* targ, const size_t col_group, const size_t row_group)
+{
+    for (size_t bit = 0; bit < 8; bit++)
+    {
+        // The sign bit of each byte is bit 7 - i of that byte
+        const uint32_t col = _mm256_movemask_epi8(_mm256_slli_epi64(blocks, bit));
+        const size_t row = 8 * col_group + 7 - bit;
+        for (size_t i = 0; i < 4; i++)
+        {
+            targ[8 * (row + 8 * i) + row_group] = col >> (8 * i);
+        }
+    }
+}
+
+static inline SHUFFLE_TRANSPOSE_TARGET
+void __inline_shuffle_transpose_64x64(const uint64_t src[64], uint64_t targ[64])
+{
+    for (size_t row_group = 0; row_group < 8; row_group++)
+    {
+        __m256i lo;
+        __m256i hi;
+        __inline_shuffle_transpose_8x8(src + 8 * row_group, &lo, &hi);
+        __inline_shuffle_transpose_movemask(lo, (uint8_t*)targ, 0, row_group);
+        __inline_shuffle_transpose_movemask(hi, (uint8_t*)targ, 4, row_group);
+    }
+}
+
+SHUFFLE_TRANSPOSE_TARGET
+void shuffle_transpose_64x64(uint64_t* block_a[64], uint64_t* block_b[64])
+{
+    uint64_t src_block[64];
+    uint64_t targ_a[64];
+    uint64_t targ_b[64];
+
+    for (size_t i = 0; i < 64; i++)
+    {
+        src_block[i] = *block_a[i];
+    }
+    __inline_shuffle_transpose_64x64(src_block, targ_b);
+
+    for (size_t i = 0; i < 64; i++)
+    {
+        src_block[i] = *block_b[i];
+    }
+    __inline_shuffle_transpose_64x64(src_block, targ_a);
+
+    for (size_t i = 0; i < 64; i++)
+    {
+        *block_a[i] = targ_a[i];
+        *block_b[i] = targ_b[i];
+    }
+
+    return;
+}
+
+SHUFFLE_TRANSPOSE_TARGET
+void shuffle_transpose_64x64_inplace(uint64_t* block_a[64])
+{
+    uint64_t src_block[64];
+    uint64_t targ_block[64];
+
+    for (size_t i = 0; i < 64; i++)
+    {
+        src_block[i] = *block_a[i];
+    }
+    __inline_shuffle_transpose_64x64(src_block, targ_block);
+
+    for (size_t i = 0; i < 64; i++)
+    {
+        *block_a[i] = targ_block[i];
+    }
+
+    return;
+}
+
+
 /*
  * Scalar implementation of the simd transpose
  * Used for regression testing
@@ -354,6 +481,35 @@ chunk_transpose_64x64(uint64_t* block_a[64], uint64_t* block_b[64])
 }
 
 
+void __attribute__((noinline))
+chunk_transpose_64x64_inplace(uint64_t* block_a[64])
+{
+     uint64_t targ_block[64] = {0};
+    
+     uint64_t* src_ptr[16];
+     uint64_t* targ_ptr[16] = {NULL};
+
+    for (size_t col = 0; col < 4; col++) 
+    {
+        for (size_t row = 0; row < 4; row++)  
+        {
+            for (size_t i = 0; i < 16; i++)
+            {
+                targ_ptr[i] = (uint64_t*)(((uint16_t*)(targ_block + i + 16 * row)) + col);
+                src_ptr[i] = (uint64_t*)(((uint16_t*)(block_a[i + 16 * col])) + row); 
+            }
+            chunk_transpose_2x16((uint8_t**)src_ptr, (uint8_t**)targ_ptr);
+        }
+    }
+
+    for (size_t i = 0; i < 64; i++)
+    {
+        memcpy(block_a[i], targ_block + i, 8); 
+    } 
+ 
+    return;
+}
+
 
 static inline
 uint8_t __inline_get_bit(
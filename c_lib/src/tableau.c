@@ -1,4 +1,19 @@
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "omp.h"
 #include "tableau.h"
+#include "cpu_dispatch.h"
+
+#ifndef MPOL_INTERLEAVE
+#define MPOL_INTERLEAVE (3) // See linux/mempolicy.h
+#endif
+#ifndef MPOL_F_MEMS_ALLOWED
+#define MPOL_F_MEMS_ALLOWED (1 << 2)
+#endif
+
+static uint8_t TABLEAU_ALLOC_POLICY = TABLEAU_ALLOC_DEFAULT;
 
 /*
  * slice_set_bit
@@ -36,6 +51,215 @@ uint8_t slice_get_bit(
 }
 
 
+/*
+ * tableau_set_alloc_policy
+ * tableau_get_alloc_policy
+ * Sets or gets the policy used to allocate new tableaus
+ * :: policy : const uint8_t :: Bitwise or of TABLEAU_ALLOC flags
+ */
+void tableau_set_alloc_policy(const uint8_t policy)
+{
+    TABLEAU_ALLOC_POLICY = policy;
+}
+uint8_t tableau_get_alloc_policy(void)
+{
+    return TABLEAU_ALLOC_POLICY;
+}
+
+/*
+ * tableau_alloc_policy_init
+ * Reads the allocation policy from the environment when the library is loaded
+ */
+static void __attribute__((constructor)) tableau_alloc_policy_init(void)
+{
+    const char* env_policy = getenv(TABLEAU_ALLOC_ENV);
+    if (NULL == env_policy)
+    {
+        return;
+    }
+
+    uint8_t policy = 0;
+    policy |= (NULL != strstr(env_policy, "hugepage")) * TABLEAU_ALLOC_HUGEPAGE;
+    policy |= (NULL != strstr(env_policy, "hugetlb")) * TABLEAU_ALLOC_HUGETLB;
+    policy |= (NULL != strstr(env_policy, "interleave")) * TABLEAU_ALLOC_INTERLEAVE;
+    tableau_set_alloc_policy(policy);
+}
+
+/*
+ * tableau_alloc_size
+ * Rounds an allocation up to a whole number of pages
+ * :: n_bytes : const size_t :: Requested size
+ * Allocations of at least one huge page are rounded to huge pages
+ */
+static size_t tableau_alloc_size(const size_t n_bytes)
+{
+    const size_t page_size = (n_bytes >= TABLEAU_HUGE_PAGE_SIZE) ? TABLEAU_HUGE_PAGE_SIZE : (size_t)sysconf(_SC_PAGESIZE);
+    const size_t n_pages = n_bytes / page_size + !!(n_bytes % page_size);
+    return (n_pages ? n_pages : 1) * page_size;
+}
+
+/*
+ * tableau_page_size
+ * Size of the pages backing a mapping from tableau_alloc
+ * :: n_bytes : const size_t :: Size of the mapping
+ * :: applied : const uint8_t :: TABLEAU_ALLOC flags that took effect for the mapping
+ */
+static size_t tableau_page_size(const size_t n_bytes, const uint8_t applied)
+{
+    if ((applied & (TABLEAU_ALLOC_HUGEPAGE | TABLEAU_ALLOC_HUGETLB)) && (0 == n_bytes % TABLEAU_HUGE_PAGE_SIZE))
+    {
+        return TABLEAU_HUGE_PAGE_SIZE;
+    }
+    return (size_t)sysconf(_SC_PAGESIZE);
+}
+
+/*
+ * tableau_interleave
+ * Interleaves the pages of a mapping over the NUMA nodes that this process may allocate from
+ * :: ptr : void* :: Start of the mapping
+ * :: n_bytes : const size_t :: Size of the mapping
+ * Returns true if the policy was applied
+ */
+static bool tableau_interleave(void* ptr, const size_t n_bytes)
+{
+    #if defined(SYS_mbind) && defined(SYS_get_mempolicy)
+    // Large enough for any kernel, bits past the nodes the kernel supports are left clear
+    unsigned long node_mask[TABLEAU_MAX_NUMA_NODES / (8 * sizeof(unsigned long))] = {0};
+    const unsigned long max_node = TABLEAU_MAX_NUMA_NODES;
+
+    int mode = 0;
+    long err_code = syscall(SYS_get_mempolicy, &mode, node_mask, max_node, NULL, MPOL_F_MEMS_ALLOWED);
+    if (0 == err_code)
+    {
+        // mbind reads one fewer bit than it is told
+        err_code = syscall(SYS_mbind, ptr, n_bytes, MPOL_INTERLEAVE, node_mask, max_node + 1, 0);
+    }
+    DPRINT(DEBUG_2, "\tInterleave policy %s\n", err_code ? "failed" : "applied");
+    return (0 == err_code);
+    #else
+    (void)ptr;
+    (void)n_bytes;
+    return false;
+    #endif
+}
+
+/*
+ * tableau_alloc
+ * Maps zeroed memory for a tableau according to the allocation policy
+ * :: n_bytes : const size_t :: Size of the mapping, see tableau_alloc_size
+ * :: applied : uint8_t* :: Written with the TABLEAU_ALLOC flags that took effect
+ * Pages are not touched here, see tableau_first_touch
+ */
+static void* tableau_alloc(const size_t n_bytes, uint8_t* applied)
+{
+    void* ptr = MAP_FAILED;
+    *applied = 0;
+
+    #ifdef MAP_HUGETLB
+    if ((TABLEAU_ALLOC_POLICY & TABLEAU_ALLOC_HUGETLB) && (0 == n_bytes % TABLEAU_HUGE_PAGE_SIZE))
+    {
+        ptr = mmap(NULL, n_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        DPRINT(DEBUG_2, "\tHuge page pool mapping %s\n", (MAP_FAILED == ptr) ? "failed" : "succeeded");
+        *applied |= (MAP_FAILED != ptr) * TABLEAU_ALLOC_HUGETLB;
+    }
+    #endif
+
+    if (MAP_FAILED == ptr)
+    {
+        ptr = mmap(NULL, n_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        assert(MAP_FAILED != ptr);
+
+        #ifdef MADV_HUGEPAGE
+        if ((TABLEAU_ALLOC_POLICY & TABLEAU_ALLOC_HUGEPAGE) && (0 == n_bytes % TABLEAU_HUGE_PAGE_SIZE))
+        {
+            *applied |= (0 == madvise(ptr, n_bytes, MADV_HUGEPAGE)) * TABLEAU_ALLOC_HUGEPAGE;
+        }
+        #endif
+    }
+
+    if (TABLEAU_ALLOC_POLICY & TABLEAU_ALLOC_INTERLEAVE)
+    {
+        *applied |= tableau_interleave(ptr, n_bytes) * TABLEAU_ALLOC_INTERLEAVE;
+    }
+
+    return ptr;
+}
+
+/*
+ * tableau_first_touch
+ * Zeroes a mapping one page at a time, each page written by the thread whose chunks fill most of it
+ * :: ptr : void* :: Start of the mapping
+ * :: n_bytes : const size_t :: Size of the mapping
+ * :: page_size : const size_t :: Size of the pages backing the mapping
+ * :: chunk_bytes : const size_t :: Distance between consecutive chunks of a slice
+ * :: row_chunks : const size_t :: Chunks between the start of consecutive slices, or tile rows
+ * :: slice_len : const size_t :: Chunks of each slice that are split over threads
+ * Threads own the chunk ranges given by __inline_tableau_chunk_range, so pages that lie within a slice,
+ * or within a row of tiles, land on the node of the thread that sweeps them
+ * Ties, such as pages that hold whole slices, are dealt out to the threads in turn
+ */
+static void tableau_first_touch(
+    void* ptr,
+    const size_t n_bytes,
+    const size_t page_size,
+    const size_t chunk_bytes,
+    const size_t row_chunks,
+    const size_t slice_len)
+{
+    const size_t n_pages = n_bytes / page_size;
+
+    // Ownership is constant over a cache line of a slice, or over a tile
+    const size_t step = (chunk_bytes > CACHE_SIZE) ? chunk_bytes : CACHE_SIZE;
+
+    size_t* owners = malloc(n_pages * sizeof(size_t));
+    NULL_CHECK(owners);
+
+    #pragma omp parallel
+    {
+        const size_t thread = omp_get_thread_num();
+        const size_t n_threads = omp_get_num_threads();
+        size_t start, end;
+        __inline_tableau_chunk_range(slice_len, 0, n_threads, &start, &end);
+        const size_t thread_chunks = (end > start) ? end - start : 1;
+
+        size_t* counts = malloc(n_threads * sizeof(size_t));
+        NULL_CHECK(counts);
+
+        #pragma omp for
+        for (size_t page = 0; page < n_pages; page++)
+        {
+            memset(counts, 0, n_threads * sizeof(size_t));
+            for (size_t offset = page * page_size; offset < (page + 1) * page_size; offset += step)
+            {
+                const size_t chunk = (offset / chunk_bytes) % row_chunks;
+                if (chunk < slice_len)
+                {
+                    counts[chunk / thread_chunks]++;
+                }
+            }
+
+            owners[page] = page % n_threads;
+            for (size_t i = 0; i < n_threads; i++)
+            {
+                if (counts[i] > counts[owners[page]])
+                {
+                    owners[page] = i;
+                }
+            }
+        }
+        free(counts);
+
+        for (size_t page = 0; page < n_pages; page++)
+        {
+            if (owners[page] == thread)
+            {
+                memset((uint8_t*)ptr + page * page_size, 0, page_size);
+            }
+        }
+    }
+    free(owners);
+}
+
 /*
  * tableau_create 
  * Constructor class for tableau  
@@ -55,28 +279,35 @@ tableau_t* tableau_create(const size_t n_qubits)
     slice_len_bytes = slice_len_cache * CACHE_SIZE; 
     assert(slice_len_sized * sizeof(size_t) <= slice_len_bytes);
 
-    // Construct memaligned bitmap
-    void* tableau_bitmap = NULL;
-    const size_t tableau_bytes = slice_len_bytes * n_qubits * 2;
-    int err_code = posix_memalign(&tableau_bitmap, CACHE_SIZE, tableau_bytes); 
-    assert(0 == err_code);
+    // Each tile holds one chunk for each of 64 slices
+    const size_t n_blocks = n_qubits / TABLEAU_TILE_CHUNKS + !!(n_qubits % TABLEAU_TILE_CHUNKS);
+
+#if TABLEAU_LAYOUT == TABLEAU_LAYOUT_TILES
+    const size_t block_bytes = n_blocks * n_blocks * TABLEAU_TILE_CHUNKS * CHUNK_SIZE_BYTES;
+    const size_t phase_bytes = n_blocks * TABLEAU_TILE_CHUNKS * CHUNK_SIZE_BYTES;
+#else
+    const size_t block_bytes = slice_len_bytes * n_qubits;
+    const size_t phase_bytes = slice_len_bytes;
+#endif
 
-    // Set map to all zeros
-    memset(tableau_bitmap, 0x00, tableau_bytes);
+    // Mapped memory is zeroed, pages are first touched below 
+    const size_t tableau_bytes = tableau_alloc_size(block_bytes * 2);
+    uint8_t alloc_applied = 0;
+    void* tableau_bitmap = tableau_alloc(tableau_bytes, &alloc_applied);
     DPRINT(DEBUG_2, "\tAllocated %ld bytes for tableau\n", tableau_bytes);
     DPRINT(DEBUG_2, "\t\t Slices: %lu bytes, %lu cache chunks, %lu size_t chunks\n", slice_len_bytes, slice_len_cache, slice_len_sized);
 
     // Construct start of X and Z segments 
     void* z_start = tableau_bitmap;
-    void* x_start = (uint8_t*)tableau_bitmap + slice_len_bytes * n_qubits; 
+    void* x_start = (uint8_t*)tableau_bitmap + block_bytes; 
     
     // Slice tracking pointers 
     void* slice_ptrs_z = malloc(sizeof(void*) * n_qubits); 
     void* slice_ptrs_x = malloc(sizeof(void*) * n_qubits); 
 
-    void* phases = NULL;
-    err_code = posix_memalign(&phases, CACHE_SIZE, slice_len_bytes); 
-    memset(phases, 0x00, slice_len_bytes);
+    const size_t phases_bytes = tableau_alloc_size(phase_bytes);
+    uint8_t phases_applied = 0;
+    void* phases = tableau_alloc(phases_bytes, &phases_applied);
 
     // Create the tableau struct and assign variables   
     tableau_t* tab = malloc(sizeof(tableau_t)); 
@@ -87,21 +318,175 @@ tableau_t* tableau_create(const size_t n_qubits)
     tab->slices_z = slice_ptrs_z;
     tab->orientation = COL_MAJOR;
     tab->phases = phases;
+    tab->parallel_threshold = TABLEAU_PARALLEL_THRESHOLD;
+    tab->n_blocks = n_blocks;
+    tab->active_len = slice_len_sized;
+    tab->occupancy = NULL;
+    tab->occupancy_len = slice_len_sized / CHUNK_SIZE_BITS + !!(slice_len_sized % CHUNK_SIZE_BITS);
+    tab->chunks_bytes = tableau_bytes;
+    tab->phases_bytes = phases_bytes;
+    tab->alloc_applied = alloc_applied;
 
     #pragma omp parallel for  
     for (size_t i = 0; i < n_qubits; i++)
     {   
-        uint8_t* ptr_z = z_start + (i * slice_len_bytes);
-        uint8_t* ptr_x = x_start + (i * slice_len_bytes);
+#if TABLEAU_LAYOUT == TABLEAU_LAYOUT_TILES
+        const size_t slice_offset = ((i / TABLEAU_TILE_CHUNKS) * n_blocks * TABLEAU_TILE_CHUNKS + (i % TABLEAU_TILE_CHUNKS)) * CHUNK_SIZE_BYTES;
+#else
+        const size_t slice_offset = i * slice_len_bytes;
+#endif
+        tab->slices_z[i] = (tableau_slice_p)((uint8_t*)z_start + slice_offset); 
+        tab->slices_x[i] = (tableau_slice_p)((uint8_t*)x_start + slice_offset); 
+    }
 
-        tab->slices_z[i] = (tableau_slice_p)ptr_z; 
-        // One write per cache line entry, should be collision free 
-        slice_set_bit(tab->slices_z[i], i, 1); 
-        tab->slices_x[i] = (tableau_slice_p)ptr_x; 
+#if TABLEAU_LAYOUT == TABLEAU_LAYOUT_TILES
+    const size_t chunk_bytes = TABLEAU_TILE_CHUNKS * CHUNK_SIZE_BYTES;
+    const size_t row_chunks = n_blocks;
+#else
+    const size_t chunk_bytes = CHUNK_SIZE_BYTES;
+    const size_t row_chunks = slice_len_bytes / CHUNK_SIZE_BYTES;
+#endif
+    tableau_first_touch(tableau_bitmap, tableau_bytes, tableau_page_size(tableau_bytes, tab->alloc_applied), chunk_bytes, row_chunks, slice_len_sized);
+    tableau_first_touch(phases, phases_bytes, tableau_page_size(phases_bytes, phases_applied), chunk_bytes, row_chunks, slice_len_sized);
+
+    #pragma omp parallel for
+    for (size_t i = 0; i < n_qubits; i++)
+    {
+        TABLEAU_CHUNK(tab->slices_z[i], i / CHUNK_SIZE_BITS) = 1ull << (i % CHUNK_SIZE_BITS);
     }
     return tab;
 }
 
+/*
+ * tableau_grow
+ * Extends the tableau to a larger number of qubits
+ * :: tab : tableau_t* :: The tableau
+ * :: n_qubits : const size_t :: New number of qubits, not less than the current number
+ * The existing tableau is embedded in the top left of the new tableau, new qubits start in the
+ * Z_j state with zero phase
+ * Slice pointers are reset to their canonical order, the tableau pointer itself is unchanged
+ */
+void tableau_grow(tableau_t* tab, const size_t n_qubits)
+{
+    assert(n_qubits >= tab->n_qubits);
+    if (n_qubits == tab->n_qubits)
+    {
+        return;
+    }
+
+    DPRINT(DEBUG_1, "Growing tableau from %lu to %lu qubits\n", tab->n_qubits, n_qubits);
+
+    tableau_t* grown = tableau_create(n_qubits);
+
+    // Only the active region differs from the identity tableau constructed above 
+    const size_t n_active = __inline_tableau_active_qubits(tab);
+    #pragma omp parallel for
+    for (size_t i = 0; i < n_active; i++)
+    {
+        for (size_t j = 0; j < tab->active_len; j++)
+        {
+            TABLEAU_CHUNK(grown->slices_x[i], j) = TABLEAU_CHUNK(tab->slices_x[i], j);
+            TABLEAU_CHUNK(grown->slices_z[i], j) = TABLEAU_CHUNK(tab->slices_z[i], j);
+        }
+    }
+    for (size_t j = 0; j < tab->active_len; j++)
+    {
+        TABLEAU_CHUNK(grown->phases, j) = TABLEAU_CHUNK(tab->phases, j);
+    }
+
+    free(tab->slices_x);
+    free(tab->slices_z);
+    munmap(tab->chunks, tab->chunks_bytes);
+    munmap(tab->phases, tab->phases_bytes);
+
+    tab->n_qubits = grown->n_qubits;
+    tab->slice_len = grown->slice_len;
+    tab->chunks = grown->chunks;
+    tab->slices_x = grown->slices_x;
+    tab->slices_z = grown->slices_z;
+    tab->phases = grown->phases;
+    tab->n_blocks = grown->n_blocks;
+    tab->occupancy_len = grown->occupancy_len;
+    tab->chunks_bytes = grown->chunks_bytes;
+    tab->phases_bytes = grown->phases_bytes;
+    tab->alloc_applied = grown->alloc_applied;
+
+    // Only the shell of the new tableau is freed
+    free(grown);
+
+    // Bitmaps are sized by the slice length, so they are rebuilt
+    if (NULL != tab->occupancy)
+    {
+        tableau_sparse_disable(tab);
+        tableau_sparse_enable(tab);
+    }
+    return;
+}
+
+
+/*
+ * tableau_sparse_enable
+ * Enters sparse mode, building the occupancy bitmaps from the current slices
+ * :: tab : tableau_t* :: The tableau
+ * Has no effect if the tableau is already sparse
+ */
+void tableau_sparse_enable(tableau_t* tab)
+{
+    if (NULL != tab->occupancy)
+    {
+        return;
+    }
+
+    tab->occupancy = calloc(tab->n_qubits * tab->occupancy_len, sizeof(CHUNK_OBJ));
+    NULL_CHECK(tab->occupancy);
+
+    // Untouched qubits are also scanned so that raising the active bound needs no update
+    #pragma omp parallel for
+    for (size_t i = 0; i < tab->n_qubits; i++)
+    {
+        CHUNK_OBJ* occ = __inline_tableau_occupancy(tab, i);
+        for (size_t j = 0; j < tab->slice_len; j++)
+        {
+            if (TABLEAU_CHUNK(tab->slices_x[i], j) | TABLEAU_CHUNK(tab->slices_z[i], j))
+            {
+                occ[j / CHUNK_SIZE_BITS] |= 1ull << (j % CHUNK_SIZE_BITS);
+            }
+        }
+    }
+    return;
+}
+
+
+/*
+ * tableau_sparse_disable
+ * Leaves sparse mode, after which every kernel sweeps the whole active region
+ * :: tab : tableau_t* :: The tableau
+ * Slices are always stored densely, so this only discards the occupancy bitmaps
+ */
+void tableau_sparse_disable(tableau_t* tab)
+{
+    free(tab->occupancy);
+    tab->occupancy = NULL;
+    return;
+}
+
+
+/*
+ * tableau_set_active_qubits
+ * Bounds the region of the tableau that kernels operate over
+ * :: tab : tableau_t* :: The tableau
+ * :: n_qubits : const size_t :: Number of qubits that may have been acted on
+ * Qubits past the bound must still be in the Z_j state with zero phase, so every row past the
+ * bound is zero in every active slice and gate kernels need only sweep the first active_len chunks
+ */
+void tableau_set_active_qubits(tableau_t* tab, const size_t n_qubits)
+{
+    assert(n_qubits <= tab->n_qubits);
+    const size_t active_len = n_qubits / CHUNK_SIZE_BITS + !!(n_qubits % CHUNK_SIZE_BITS);
+    tab->active_len = (active_len < tab->slice_len) ? active_len : tab->slice_len;
+}
+
+
 /*
  * tableau_set_n_qubits
  * Truncates the tableau to a set number of qubits
@@ -114,6 +499,10 @@ void tableau_set_n_qubits(tableau_t* tab, const size_t n_qubits)
 {
     tab->n_qubits = n_qubits; 
     tab->slice_len = SLICE_LEN_SIZE_T(n_qubits); 
+    if (tab->active_len > tab->slice_len)
+    {
+        tab->active_len = tab->slice_len;
+    }
 }
 
 
@@ -129,8 +518,9 @@ void tableau_destroy(tableau_t* tab)
 
     free(tab->slices_x);
     free(tab->slices_z);
-    free(tab->chunks);
-    free(tab->phases);
+    munmap(tab->chunks, tab->chunks_bytes);
+    munmap(tab->phases, tab->phases_bytes);
+    free(tab->occupancy);
     free(tab);
     return;
 }
@@ -146,145 +536,378 @@ void tableau_destroy(tableau_t* tab)
  */
 void tableau_transverse_hadamard(tableau_t const* tab, const size_t targ)
 { 
-    uint8_t bit_x = 0;
-    uint8_t bit_z = 0;
-    // TODO Vectorise this
+    CPU_DISPATCH.transverse_hadamard(
+        tab->slices_x,
+        tab->slices_z,
+        (targ / CHUNK_SIZE_BITS) * TABLEAU_CHUNK_STRIDE,
+        1ull << (targ % CHUNK_SIZE_BITS),
+        __inline_tableau_active_qubits(tab));
+    return;
+}
 
-    #ifdef __GNUC__
-    #ifndef __clang__    
-    #pragma GCC ivdep  
-    #endif
-    #endif
-    for (size_t i = 0; i < tab->n_qubits; i++)
+/*
+ * tableau_transverse_hadamard_scalar
+ * Portable row kernel of tableau_transverse_hadamard
+ * The bits are swapped by XORing their difference into both slices
+ */
+void tableau_transverse_hadamard_scalar(CHUNK_OBJ* const* slices_x, CHUNK_OBJ* const* slices_z, const size_t offset, const CHUNK_OBJ mask, const size_t n_rows)
+{
+    for (size_t i = 0; i < n_rows; i++)
     {
-        bit_z = __inline_slice_get_bit(tab->slices_z[i], targ); 
-        bit_x = __inline_slice_get_bit(tab->slices_x[i], targ); 
-
-        __inline_slice_set_bit(tab->slices_z[i], targ, bit_x); 
-        __inline_slice_set_bit(tab->slices_x[i], targ, bit_z); 
+        const CHUNK_OBJ differ = (slices_x[i][offset] ^ slices_z[i][offset]) & mask;
+        slices_x[i][offset] ^= differ;
+        slices_z[i][offset] ^= differ;
     }
-
     return;
 }
 
-void tableau_col_elim_X(tableau_t const* tab, const size_t idx)
+/*
+ * tableau_col_elim_batch
+ * XORs the chunks [start, end) of a pivot slice into a full batch of target slices
+ * Each pivot chunk is loaded once and stored to every target
+ * Cloned for each instruction set, see cpu_dispatch.h
+ */
+static CPU_DISPATCH_CLONES
+void tableau_col_elim_batch(
+    const CHUNK_OBJ* restrict pivot,
+    CHUNK_OBJ* const* targs,
+    const size_t start,
+    const size_t end)
+{
+    #pragma omp simd
+    TABLEAU_FOR_EACH_CHUNK(i, start, end)
+    {
+        const CHUNK_OBJ chunk = pivot[i];
+        for (size_t row = 0; row < TABLEAU_COL_ELIM_ROWS; row++)
+        {
+            targs[row][i] ^= chunk;
+        }
+    }
+}
+
+/*
+ * tableau_rows_xor
+ * Adds one row to a list of rows
+ * :: tab : tableau_t* :: Transposed tableau
+ * :: ctrl : const size_t :: Row to add
+ * :: targs : const size_t* :: Rows to add it to, these must not include ctrl
+ * :: n_targs : const size_t :: Number of target rows
+ * Targets are taken in batches of TABLEAU_COL_ELIM_ROWS, chunks before the first non zero chunk of
+ * the control row are skipped, and each thread XORs its own range of chunks as in the gate kernels
+ * Phases are not summed, see tableau_slice_xor
+ * Returns the number of chunks XORed
+ */
+size_t tableau_rows_xor(tableau_t* tab, const size_t ctrl, const size_t* targs, const size_t n_targs)
 {
-    #define VECTOR_COLLECT 8 
-    size_t collected = 0;   
-    size_t* rows = {0}; 
-    DEBUG_CHECK(ROW_MAJOR == tab->orientation);
+    const size_t x_first = tableau_ctz(tab->slices_x[ctrl], tab->active_len);
+    const size_t z_first = tableau_ctz(tab->slices_z[ctrl], tab->active_len);
+    const size_t x_start = (CTZ_SENTINEL == x_first) ? tab->active_len : x_first / CHUNK_SIZE_BITS;
+    const size_t z_start = (CTZ_SENTINEL == z_first) ? tab->active_len : z_first / CHUNK_SIZE_BITS;
+    if ((0 == n_targs) || ((tab->active_len == x_start) && (tab->active_len == z_start)))
+    {
+        return 0;
+    }
 
-    for (size_t j = 0; j < idx;)
+    #pragma omp parallel if (n_targs * tab->active_len >= tab->parallel_threshold)
     {
-        // Collect Rows
-        while ((j < idx) && (VECTOR_COLLECT > collected))
+        size_t start, end;
+        __inline_tableau_chunk_range(tab->active_len, omp_get_thread_num(), omp_get_num_threads(), &start, &end);
+        const size_t x_chunk = (x_start > start) ? x_start : start;
+        const size_t z_chunk = (z_start > start) ? z_start : start;
+
+        CHUNK_OBJ* targs_x[TABLEAU_COL_ELIM_ROWS];
+        CHUNK_OBJ* targs_z[TABLEAU_COL_ELIM_ROWS];
+        size_t batch = 0;
+        for (; batch + TABLEAU_COL_ELIM_ROWS <= n_targs; batch += TABLEAU_COL_ELIM_ROWS)
         {
-            if (__inline_slice_get_bit(tab->slices_x[j], idx))
+            for (size_t row = 0; row < TABLEAU_COL_ELIM_ROWS; row++)
             {
-                rows[collected] = j;  
-                collected++;
+                targs_x[row] = tab->slices_x[targs[batch + row]];
+                targs_z[row] = tab->slices_z[targs[batch + row]];
             }
-            j++;
+
+            // Apply to X and Z separately to double cache lifetime
+            tableau_col_elim_batch(tab->slices_x[ctrl], targs_x, x_chunk, end);
+            tableau_col_elim_batch(tab->slices_z[ctrl], targs_z, z_chunk, end);
         }
-        // Rowsum 
-        // TODO Multithread this 
-        if (collected > 0)
+
+        // Trailing rows are handled one at a time
+        for (; batch < n_targs; batch++)
         {
-            // Assume elements left of the targeted chunk are already zeroed by previous elim operations 
-            // Apply to X and Z chunks separately to double cache lifetime 
-            // Z elements
-            for (size_t jdx = idx / CHUNK_SIZE_BITS; jdx < SLICE_LEN_CACHE(tab->n_qubits); jdx++)
+            CHUNK_OBJ* slice_x = tab->slices_x[targs[batch]];
+            CHUNK_OBJ* slice_z = tab->slices_z[targs[batch]];
+
+            #pragma omp simd
+            TABLEAU_FOR_EACH_CHUNK(i, x_chunk, end)
             {
-                // TODO Vectorise  and distribute this loop
-                for  (size_t col_idx = 0; col_idx < collected; col_idx += 1)
-                {
-                    tab->slices_z[rows[col_idx]][jdx] ^= tab->slices_z[idx][jdx];   
-                } 
-            }        
-             
-            // X elements 
-            for (size_t jdx = idx / CHUNK_SIZE_BITS; jdx < SLICE_LEN_CACHE(tab->n_qubits); jdx++)
+                slice_x[i] ^= tab->slices_x[ctrl][i];
+            }
+            #pragma omp simd
+            TABLEAU_FOR_EACH_CHUNK(i, z_chunk, end)
             {
-                for  (size_t col_idx = 0; col_idx < collected; col_idx += 1)
-                {
-                    tab->slices_x[rows[col_idx]][jdx] ^= tab->slices_z[idx][jdx];   
-                } 
-            }         
-        }  
-    }   
+                slice_z[i] ^= tab->slices_z[ctrl][i];
+            }
+        }
+    }
+    return n_targs * (2 * tab->active_len - x_start - z_start);
 }
 
 /*
- * tableau_transpose
- * Transposes the tableau
+ * tableau_col_elim_X
+ * Adds the pivot row to every row in a range with an X bit in the pivot column
+ * :: tab : tableau_t* :: Transposed tableau
+ * :: idx : const size_t :: Pivot row and column
+ * :: start : const size_t :: First row to eliminate
+ * :: end : const size_t :: One past the last row to eliminate, the range must not contain idx
+ * Rows are collected before they are XORed together, see tableau_rows_xor
+ * Returns the number of chunks XORed
  */
-void tableau_transpose_slices(tableau_t* tab, uint64_t** slices); 
-void tableau_transpose(tableau_t* tab)
+size_t tableau_col_elim_X(tableau_t* tab, const size_t idx, const size_t start, const size_t end)
 {
+    assert((idx < start) || (idx >= end));
+    if (end <= start)
+    {
+        return 0;
+    }
 
-    if (tab->n_qubits < 64)
+    size_t* rows = malloc((end - start) * sizeof(size_t));
+    NULL_CHECK(rows);
+    size_t collected = 0;
+    for (size_t j = start; j < end; j++)
     {
-        tableau_transpose_naive(tab);
-        return;
+        rows[collected] = j;
+        collected += __inline_slice_get_bit(tab->slices_x[j], idx);
     }
 
-    tableau_transpose_slices(tab, tab->slices_x);
-    tableau_transpose_slices(tab, tab->slices_z);
+    const size_t n_xors = tableau_rows_xor(tab, idx, rows, collected);
+    free(rows);
+    return n_xors;
 }
-void tableau_transpose_slices(tableau_t* tab, uint64_t** slices) 
+
+#if TABLEAU_LAYOUT == TABLEAU_LAYOUT_TILES
+/*
+ * __inline_tableau_tile
+ * Gets the first chunk of a tile
+ * :: block : CHUNK_OBJ* :: Start of the X or Z tiles
+ * :: n_blocks : const size_t :: Tiles along each side of the block
+ * :: row : const size_t :: Tile index along the qubits 
+ * :: col : const size_t :: Tile index along the chunks of each slice
+ */
+static inline
+CHUNK_OBJ* __inline_tableau_tile(CHUNK_OBJ* block, const size_t n_blocks, const size_t row, const size_t col)
 {
-    const size_t chunk_elements =  tab->n_qubits / (8 * sizeof(uint64_t)); 
-    const size_t remainder_elements = tab->n_qubits % 64; 
+    return block + (row * n_blocks + col) * TABLEAU_TILE_CHUNKS;
+}
 
+/*
+ * tableau_canonicalise_slices
+ * Moves slice contents so that every slice pointer refers to its own row of the tiles
+ * :: tab : tableau_t* :: The tableau
+ * Hadamard type gates and index swaps permute the slice pointers, while the tile transpose 
+ * requires slice i of the X block to be row i of the X tiles
+ * Pointers are treated as a permutation over the 2n rows and each cycle is moved through a single
+ * temporary slice
+ */
+void tableau_canonicalise_slices(tableau_t* tab)
+{
+    const size_t n_qubits = tab->n_qubits;
+    const size_t block_chunks = tab->n_blocks * tab->n_blocks * TABLEAU_TILE_CHUNKS;
+    CHUNK_OBJ* z_start = (CHUNK_OBJ*)tab->chunks;
+    CHUNK_OBJ* x_start = z_start + block_chunks;
 
-    uint64_t* src_ptr[64] = {NULL};
-    uint64_t* targ_ptr[64] = {NULL};
- 
-    for (size_t col = 0; col < chunk_elements; col++) 
+    // Rows [0, n) are X slices, rows [n, 2n) are Z slices
+    #define CANONICAL_ROW(row) (((row) < n_qubits ? x_start : z_start) + \
+        (((row) % n_qubits) / TABLEAU_TILE_CHUNKS) * tab->n_blocks * TABLEAU_TILE_CHUNKS + \
+        (((row) % n_qubits) % TABLEAU_TILE_CHUNKS))
+
+    // perm[row] is the row whose canonical position currently holds the contents of row
+    size_t* perm = malloc(2 * n_qubits * sizeof(size_t));
+    uint8_t* moved = calloc(2 * n_qubits, sizeof(uint8_t));
+    for (size_t row = 0; row < 2 * n_qubits; row++)
     {
-        for (size_t row = col + 1; row < chunk_elements; row++) 
+        CHUNK_OBJ* ptr = (row < n_qubits) ? tab->slices_x[row] : tab->slices_z[row - n_qubits];
+        const bool is_z = (ptr < x_start);
+        const size_t offset = ptr - (is_z ? z_start : x_start);
+        const size_t qubit = (offset / (tab->n_blocks * TABLEAU_TILE_CHUNKS)) * TABLEAU_TILE_CHUNKS + offset % TABLEAU_TILE_CHUNKS;
+        assert(qubit < n_qubits);
+        perm[row] = qubit + is_z * n_qubits;
+    }
+
+    CHUNK_OBJ* tmp = malloc(tab->n_blocks * sizeof(CHUNK_OBJ));
+    for (size_t start = 0; start < 2 * n_qubits; start++)
+    {
+        if (moved[start] || (perm[start] == start))
+        {
+            continue;
+        }
+
+        CHUNK_OBJ* dst = CANONICAL_ROW(start);
+        for (size_t j = 0; j < tab->n_blocks; j++)
         {
-             // TODO Vectorise this
-            for (size_t i = 0; i < 64; i++)
+            tmp[j] = TABLEAU_CHUNK(dst, j);
+        }
+
+        size_t row = start;
+        while (perm[row] != start)
+        {
+            CHUNK_OBJ* src = CANONICAL_ROW(perm[row]);
+            for (size_t j = 0; j < tab->n_blocks; j++)
             {
-                src_ptr[i] = slices[i + (64 * col)] + row;
-                targ_ptr[i] = slices[i + (64 * row)] + col;
+                TABLEAU_CHUNK(dst, j) = TABLEAU_CHUNK(src, j);
             }
-            simd_transpose_64x64(src_ptr, targ_ptr);
+            moved[row] = 1;
+            row = perm[row];
+            dst = src;
         }
-    }
 
-    // Inplace diagonal
-    for (size_t col = 0; col < chunk_elements; col++)
-    {
-        for (size_t i = 0; i < 64; i++)
+        for (size_t j = 0; j < tab->n_blocks; j++)
         {
-            src_ptr[i] = slices[i + (64 * col)] + col;
+            TABLEAU_CHUNK(dst, j) = tmp[j];
         }
-        simd_transpose_64x64_inplace(src_ptr);
+        moved[row] = 1;
     }
 
-    // Doing the remainder naively
-    for (size_t i = chunk_elements * 64; i < tab->n_qubits; i++)
+    for (size_t i = 0; i < n_qubits; i++)
     {
-        // Inner loop should run along the current orientation, and hence along the cache lines 
-        tableau_slice_p ptr_x = slices[i]; 
-   
-        for (size_t j = 0; j < tab->n_qubits - (remainder_elements - (i - chunk_elements * 64)); j++)
-        {
-            uint8_t val_a = __inline_slice_get_bit(ptr_x, j); 
-            uint8_t val_b = __inline_slice_get_bit(slices[j], i); 
-
-            __inline_slice_set_bit(ptr_x, j, val_b);
-            __inline_slice_set_bit(slices[j], i, val_a);
-        }    
+        tab->slices_x[i] = CANONICAL_ROW(i);
+        tab->slices_z[i] = CANONICAL_ROW(i + n_qubits);
     }
-   
+    #undef CANONICAL_ROW
+
+    free(tmp);
+    free(moved);
+    free(perm);
     return;
 }
 
+/*
+ * tableau_transpose_block_pair
+ * Transposes a tile of the X or Z block of a tiled tableau along with its mirror
+ * :: tab : const tableau_t* :: The tableau
+ * :: block : CHUNK_OBJ* :: Start of the X or Z tiles 
+ * :: row : const size_t :: Tile index along the qubits
+ * :: col : const size_t :: Tile index along the chunks of each slice, at least row
+ * Off diagonal tiles are transposed and exchanged with their mirror, diagonal tiles are transposed in place
+ * Padding rows and columns are zero and remain so
+ */
+static void tableau_transpose_block_pair(const tableau_t* tab, CHUNK_OBJ* block, const size_t row, const size_t col)
+{
+    uint64_t* src_ptr[TABLEAU_TILE_CHUNKS];
+    uint64_t* targ_ptr[TABLEAU_TILE_CHUNKS];
+
+    CHUNK_OBJ* src = __inline_tableau_tile(block, tab->n_blocks, row, col);
+    CHUNK_OBJ* targ = __inline_tableau_tile(block, tab->n_blocks, col, row);
+    #pragma omp simd
+    for (size_t i = 0; i < TABLEAU_TILE_CHUNKS; i++)
+    {
+        src_ptr[i] = src + i;
+        targ_ptr[i] = targ + i;
+    }
+
+    if (row == col)
+    {
+        CPU_DISPATCH.transpose_64x64_inplace(src_ptr);
+        return;
+    }
+    CPU_DISPATCH.transpose_64x64(src_ptr, targ_ptr);
+}
+#else
+/*
+ * tableau_transpose_block_ptrs
+ * Gathers the row pointers of a 64x64 block of the X or Z slices
+ * :: tab : const tableau_t* :: The tableau
+ * :: slices : uint64_t** :: The X or Z slices
+ * :: ptrs : uint64_t** :: Row pointers to fill
+ * :: pad : uint64_t* :: 64 chunks standing in for the rows past the last slice
+ * :: row : const size_t :: Block index along the slices
+ * :: col : const size_t :: Block index along the chunks of each slice
+ * Slices are padded past the last qubit, so only the rows of the last block can be missing
+ * The padding columns of the mirror are zero, hence so is everything written to the pad
+ */
+static inline
+void __inline_tableau_transpose_block_ptrs(const tableau_t* tab, uint64_t** slices, uint64_t** ptrs, uint64_t* pad, const size_t row, const size_t col)
+{
+    const size_t first = CHUNK_SIZE_BITS * row;
+    const size_t n_rows = (tab->n_qubits - first < CHUNK_SIZE_BITS) ? tab->n_qubits - first : CHUNK_SIZE_BITS;
+
+    #pragma omp simd
+    for (size_t i = 0; i < n_rows; i++)
+    {
+        ptrs[i] = slices[first + i] + col;
+    }
+    for (size_t i = n_rows; i < CHUNK_SIZE_BITS; i++)
+    {
+        pad[i] = 0;
+        ptrs[i] = pad + i;
+    }
+}
+
+/*
+ * tableau_transpose_block_pair
+ * Transposes a 64x64 block of the X or Z slices along with its mirror
+ * :: tab : const tableau_t* :: The tableau
+ * :: slices : uint64_t** :: The X or Z slices
+ * :: row : const size_t :: Block index along the slices
+ * :: col : const size_t :: Block index along the chunks of each slice, at least row
+ * Off diagonal blocks are transposed and exchanged with their mirror, diagonal blocks are transposed in place
+ * Blocks on the ragged edge are treated as zero padded to 64 rows
+ */
+static void tableau_transpose_block_pair(const tableau_t* tab, uint64_t** slices, const size_t row, const size_t col)
+{
+    uint64_t* src_ptr[CHUNK_SIZE_BITS];
+    uint64_t* targ_ptr[CHUNK_SIZE_BITS];
+    uint64_t src_pad[CHUNK_SIZE_BITS];
+    uint64_t targ_pad[CHUNK_SIZE_BITS];
+
+    __inline_tableau_transpose_block_ptrs(tab, slices, src_ptr, src_pad, row, col);
+    if (row == col)
+    {
+        CPU_DISPATCH.transpose_64x64_inplace(src_ptr);
+        return;
+    }
+
+    __inline_tableau_transpose_block_ptrs(tab, slices, targ_ptr, targ_pad, col, row);
+    CPU_DISPATCH.transpose_64x64(src_ptr, targ_ptr);
+}
+#endif
+
+/*
+ * tableau_transpose
+ * Transposes the tableau
+ * In the tiled layout this is a transpose of each tile and an exchange of tile indices
+ * In the slice layout the last block along each side is zero padded, so every size uses the 64x64 kernels
+ * Every pair of mirrored blocks is independent, the pairs of the X block are followed by those of
+ * the Z block and dealt out to the threads in turn so that consecutive pairs share their rows
+ */
+void tableau_transpose(tableau_t* tab)
+{
+    // Occupancy is tracked per qubit, which has no meaning for a transposed tableau
+    tableau_sparse_disable(tab);
+
+    const size_t n_blocks = tab->n_blocks;
+#if TABLEAU_LAYOUT == TABLEAU_LAYOUT_TILES
+    CHUNK_OBJ* blocks[2] = {(CHUNK_OBJ*)tab->chunks + n_blocks * n_blocks * TABLEAU_TILE_CHUNKS, (CHUNK_OBJ*)tab->chunks};
+    tableau_canonicalise_slices(tab);
+#else
+    uint64_t** blocks[2] = {tab->slices_x, tab->slices_z};
+#endif
+
+    const size_t n_pairs = n_blocks * n_blocks;
+    #pragma omp parallel for schedule(static, 1) if (2 * tab->n_qubits * tab->slice_len >= tab->parallel_threshold)
+    for (size_t k = 0; k < 2 * n_pairs; k++)
+    {
+        const size_t row = (k % n_pairs) / n_blocks;
+        const size_t col = (k % n_pairs) % n_blocks;
+        if (col >= row)
+        {
+            tableau_transpose_block_pair(tab, blocks[k / n_pairs], row, col);
+        }
+    }
+}
+
 void tableau_transpose_naive(tableau_t* tab)
 {
+    tableau_sparse_disable(tab);
 
     for (size_t i = 0; i < tab->n_qubits; i++)
     {
@@ -368,7 +991,7 @@ bool tableau_slice_empty_x(const tableau_t* tab, size_t idx)
 {
     DPRINT(DEBUG_3, "\t\tChecking X slice %lu is empty\n", idx);
 
-    return __inline_slice_empty(tab->slices_x[idx], tab->slice_len);
+    return __inline_slice_empty(tab->slices_x[idx], tab->active_len);
 } 
 
 
@@ -380,7 +1003,7 @@ bool tableau_slice_empty_x(const tableau_t* tab, size_t idx)
  */
 bool tableau_slice_empty_z(const tableau_t* tab, size_t idx)
 {
-    return __inline_slice_empty(tab->slices_z[idx], tab->slice_len);
+    return __inline_slice_empty(tab->slices_z[idx], tab->active_len);
 }
 
 
@@ -388,22 +1011,29 @@ bool tableau_slice_empty_z(const tableau_t* tab, size_t idx)
  * tableau_ctz
  * Gets the index of the first non-zero bit in the slice
  * :: tableau_slice_p ::
+ * Dispatches to the widest supported implementation
  */
 size_t tableau_ctz(CHUNK_OBJ* slice, const size_t slice_len)
 {
-    //#pragma GCC unroll 8
-    for (size_t i = 0;
-         i < slice_len;
-         i++)
+    return CPU_DISPATCH.ctz(slice, slice_len);
+}
+
+/*
+ * tableau_ctz_scalar
+ * Portable implementation of tableau_ctz
+ */
+size_t tableau_ctz_scalar(CHUNK_OBJ* slice, const size_t slice_len)
+{
+    for (size_t i = 0; i < slice_len; i++)
     {
         DPRINT(DEBUG_3, 
             "%p %lu\n",
-            slice + i,
-            *(slice + i));
+            &TABLEAU_CHUNK(slice, i),
+            TABLEAU_CHUNK(slice, i));
            
-        if (0 < *(slice + i))
+        if (0 < TABLEAU_CHUNK(slice, i))
         {
-            return CHUNK_SIZE_BITS * i + __CHUNK_CTZ(*(slice + i));
+            return CHUNK_SIZE_BITS * i + __CHUNK_CTZ(TABLEAU_CHUNK(slice, i));
         }
     }
     return CTZ_SENTINEL;
@@ -428,6 +1058,7 @@ void tableau_idx_swap(tableau_t* tab, const size_t i, const size_t j)
     tab->slices_z[i] = tab->slices_z[j];  
     tab->slices_z[j] = tmp;  
 
+    __inline_tableau_occupancy_swap(tab, i, j);
     return;
 }
 
@@ -450,6 +1081,8 @@ void tableau_idx_swap_transverse(tableau_t* tab, const size_t i, const size_t j)
     tmp = tab->slices_z[i];
     tab->slices_z[i] = tab->slices_z[j];  
     tab->slices_z[j] = tmp;  
+
+    __inline_tableau_occupancy_swap(tab, i, j);
     
     uint8_t phase_i = slice_get_bit(tab->phases, i); 
     uint8_t phase_j = slice_get_bit(tab->phases, j); 
@@ -459,38 +1092,63 @@ void tableau_idx_swap_transverse(tableau_t* tab, const size_t i, const size_t j)
     return;
 }
 
+/*
+ * tableau_slice_xor_range
+ * XORs the chunks [start, end) of the control X and Z slices into the target slices
+ * Cloned for each instruction set, see cpu_dispatch.h
+ */
+static CPU_DISPATCH_CLONES
+void tableau_slice_xor_range(
+    CHUNK_OBJ* restrict slice_ctrl_x,
+    CHUNK_OBJ* restrict slice_targ_x,
+    CHUNK_OBJ* restrict slice_ctrl_z,
+    CHUNK_OBJ* restrict slice_targ_z,
+    const size_t start,
+    const size_t end)
+{
+    #pragma omp simd
+    TABLEAU_FOR_EACH_CHUNK(i, start, end)
+    {
+        slice_targ_x[i] ^= slice_ctrl_x[i];
+        slice_targ_z[i] ^= slice_ctrl_z[i];
+    }
+}
+
 void tableau_slice_xor(tableau_t* tab, const size_t ctrl, const size_t targ)
 {
-    CHUNK_OBJ* slice_ctrl = (CHUNK_OBJ*)(tab->slices_x[ctrl]); 
-    CHUNK_OBJ* slice_targ = (CHUNK_OBJ*)(tab->slices_x[targ]); 
+    CHUNK_OBJ* slice_ctrl_x = (CHUNK_OBJ*)(tab->slices_x[ctrl]); 
+    CHUNK_OBJ* slice_targ_x = (CHUNK_OBJ*)(tab->slices_x[targ]); 
+    CHUNK_OBJ* slice_ctrl_z = (CHUNK_OBJ*)(tab->slices_z[ctrl]); 
+    CHUNK_OBJ* slice_targ_z = (CHUNK_OBJ*)(tab->slices_z[targ]); 
 
-    size_t i;
-    #pragma omp parallel private(i)
-    { 
-        #ifdef __GNUC__
-        #ifndef __clang__
-        #pragma omp for simd
-        #endif
-        #endif
-        for (i = 0; i < tab->slice_len; i++)
+    if (__inline_tableau_sparse(tab, ctrl))
+    {
+        // Only chunks occupied by the control change the target
+        size_t pos = 0;
+        size_t run_start;
+        while (__inline_tableau_next_run(__inline_tableau_occupancy(tab, ctrl), &pos, tab->active_len, &run_start))
         {
-            slice_targ[i] ^= slice_ctrl[i];
-        }  
+            tableau_slice_xor_range(slice_ctrl_x, slice_targ_x, slice_ctrl_z, slice_targ_z, run_start, pos);
+        }
+        __inline_tableau_occupancy_union(tab, ctrl, targ);
+        return;
     }
 
-    slice_ctrl = (CHUNK_OBJ*)(tab->slices_z[ctrl]); 
-    slice_targ = (CHUNK_OBJ*)(tab->slices_z[targ]); 
+    if (NULL != tab->occupancy)
+    {
+        __inline_tableau_occupancy_union(tab, ctrl, targ);
+    }
 
-    #pragma omp parallel private(i)
+    if (tab->active_len < tab->parallel_threshold)
+    {
+        tableau_slice_xor_range(slice_ctrl_x, slice_targ_x, slice_ctrl_z, slice_targ_z, 0, tab->active_len);
+        return;
+    }
+
+    #pragma omp parallel
     { 
-        #ifdef __GNUC__
-        #ifndef __clang__
-        #pragma omp for simd
-        #endif
-        #endif
-        for (i = 0; i < tab->slice_len; i++)
-        {
-            slice_targ[i] ^= slice_ctrl[i];
-        }  
+        size_t start, end;
+        __inline_tableau_chunk_range(tab->active_len, omp_get_thread_num(), omp_get_num_threads(), &start, &end);
+        tableau_slice_xor_range(slice_ctrl_x, slice_targ_x, slice_ctrl_z, slice_targ_z, start, end);
     }
 }
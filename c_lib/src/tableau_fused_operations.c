@@ -0,0 +1,378 @@
+#include "tableau_fused_operations.h"
+#include "cpu_dispatch.h"
+
+#define LC_IDX(cliff) ((cliff) & INSTRUCTION_OPERATOR_MASK)
+
+/*
+ * __inline_local_clifford_chunk
+ * Applies a local Clifford to a single chunk of a slice held in registers
+ * :: cliff : const uint8_t :: Masked local Clifford index
+ * :: x : CHUNK_OBJ* :: X chunk
+ * :: z : CHUNK_OBJ* :: Z chunk
+ * :: r : CHUNK_OBJ* :: Phase accumulator
+ * Each case matches the corresponding tableau_<clifford> operation, with the pointer swap of
+ * Hadamard type operations performed on the values instead
+ * When inlined with a constant cliff the switch is resolved at compile time
+ */
+static inline __attribute__((always_inline))
+void __inline_local_clifford_chunk(
+    const uint8_t cliff,
+    CHUNK_OBJ* x,
+    CHUNK_OBJ* z,
+    CHUNK_OBJ* r)
+{
+    CHUNK_OBJ tmp;
+    switch (cliff)
+    {
+        case LC_IDX(_I_):
+            break;
+        case LC_IDX(_X_):
+            *r ^= *z;
+            break;
+        case LC_IDX(_Y_):
+            *r ^= *z ^ *x;
+            break;
+        case LC_IDX(_Z_):
+            *r ^= *x;
+            break;
+        case LC_IDX(_H_):
+            *r ^= *x & *z;
+            tmp = *x; *x = *z; *z = tmp;
+            break;
+        case LC_IDX(_S_):
+            *r ^= *x & *z;
+            *z ^= *x;
+            break;
+        case LC_IDX(_R_):
+            *r ^= *x & ~*z;
+            *z ^= *x;
+            break;
+        case LC_IDX(_HX_):
+            *r ^= ~*x & *z;
+            tmp = *x; *x = *z; *z = tmp;
+            break;
+        case LC_IDX(_SX_):
+            *r ^= ~*x & *z;
+            *z ^= *x;
+            break;
+        case LC_IDX(_RX_):
+            *r ^= *x | *z;
+            *z ^= *x;
+            break;
+        case LC_IDX(_HY_):
+            *r ^= *z | *x;
+            tmp = *x; *x = *z; *z = tmp;
+            break;
+        case LC_IDX(_HZ_):
+            *r ^= ~*z & *x;
+            tmp = *x; *x = *z; *z = tmp;
+            break;
+        case LC_IDX(_SH_):
+            *x ^= *z;
+            tmp = *x; *x = *z; *z = tmp;
+            break;
+        case LC_IDX(_RH_):
+            *r ^= *z;
+            *x ^= *z;
+            tmp = *x; *x = *z; *z = tmp;
+            break;
+        case LC_IDX(_HS_):
+            *r ^= *x;
+            *z ^= *x;
+            tmp = *x; *x = *z; *z = tmp;
+            break;
+        case LC_IDX(_HR_):
+            *z ^= *x;
+            tmp = *x; *x = *z; *z = tmp;
+            break;
+        case LC_IDX(_HSX_):
+            *r ^= *x ^ *z;
+            *z ^= *x;
+            tmp = *x; *x = *z; *z = tmp;
+            break;
+        case LC_IDX(_HRX_):
+            *r ^= *z;
+            *z ^= *x;
+            tmp = *x; *x = *z; *z = tmp;
+            break;
+        case LC_IDX(_SHY_):
+            *r ^= *z ^ *x;
+            *x ^= *z;
+            tmp = *x; *x = *z; *z = tmp;
+            break;
+        case LC_IDX(_RHY_):
+            *r ^= *x;
+            *x ^= *z;
+            tmp = *x; *x = *z; *z = tmp;
+            break;
+        case LC_IDX(_HSH_):
+            *r ^= ~*x & *z;
+            *x ^= *z;
+            break;
+        case LC_IDX(_HRH_):
+            *r ^= *x & *z;
+            *x ^= *z;
+            break;
+        case LC_IDX(_RHS_):
+            *r ^= *x | *z;
+            *x ^= *z;
+            break;
+        case LC_IDX(_SHR_):
+            *r ^= *x & ~*z;
+            *x ^= *z;
+            break;
+    }
+    return;
+}
+
+/*
+ * __inline_fused_two_qubit_operation
+ * Single pass implementation of ctrl_cliff, targ_cliff and then gate over a range of chunks
+ * :: tab : tableau_t* :: The tableau
+ * :: ctrl : const size_t :: Control qubit
+ * :: targ : const size_t :: Target qubit
+ * :: start : const size_t :: First chunk of the range
+ * :: end : const size_t :: One past the last chunk of the range
+ * :: ctrl_cliff : const uint8_t :: Masked local Clifford index on the control
+ * :: targ_cliff : const uint8_t :: Masked local Clifford index on the target
+ * :: gate : const uint8_t :: Masked two qubit gate index
+ * Acts in place on the tableau
+ * Callers own the chunk range exclusively, so the phase update does not need to be atomic
+ */
+static inline __attribute__((always_inline))
+void __inline_fused_two_qubit_operation(
+    tableau_t* tab,
+    const size_t ctrl,
+    const size_t targ,
+    const size_t start,
+    const size_t end,
+    const uint8_t ctrl_cliff,
+    const uint8_t targ_cliff,
+    const uint8_t gate)
+{
+    CHUNK_OBJ* ctrl_slice_x = (CHUNK_OBJ*)(tab->slices_x[ctrl]);
+    CHUNK_OBJ* ctrl_slice_z = (CHUNK_OBJ*)(tab->slices_z[ctrl]);
+    CHUNK_OBJ* targ_slice_x = (CHUNK_OBJ*)(tab->slices_x[targ]);
+    CHUNK_OBJ* targ_slice_z = (CHUNK_OBJ*)(tab->slices_z[targ]);
+    CHUNK_OBJ* slice_r = (CHUNK_OBJ*)(tab->phases);
+
+    #pragma omp simd
+    TABLEAU_FOR_EACH_CHUNK(i, start, end)
+    {
+        CHUNK_OBJ c_x = ctrl_slice_x[i];
+        CHUNK_OBJ c_z = ctrl_slice_z[i];
+        CHUNK_OBJ t_x = targ_slice_x[i];
+        CHUNK_OBJ t_z = targ_slice_z[i];
+        CHUNK_OBJ r = 0;
+
+        __inline_local_clifford_chunk(ctrl_cliff, &c_x, &c_z, &r);
+        __inline_local_clifford_chunk(targ_cliff, &t_x, &t_z, &r);
+
+        if (LC_IDX(_CNOT_) == gate)
+        {
+            // See tableau_CNOT
+            r ^= c_x & t_z & ~(t_x ^ c_z);
+            t_x ^= c_x;
+            c_z ^= t_z;
+        }
+        else
+        {
+            // See tableau_CZ
+            r ^= (c_x & t_x & c_z) ^ (c_x & t_x & t_z);
+            t_z ^= c_x;
+            c_z ^= t_x;
+        }
+
+        slice_r[i] ^= r;
+        ctrl_slice_x[i] = c_x;
+        ctrl_slice_z[i] = c_z;
+        targ_slice_x[i] = t_x;
+        targ_slice_z[i] = t_z;
+    }
+    return;
+}
+
+/*
+ * Kernel generation
+ * FUSED_KERNEL defines a single kernel, FUSED_FOR_EACH_TARG expands over all target Cliffords
+ * and FUSED_FOR_EACH_CTRL expands over all control Cliffords
+ */
+#define FUSED_KERNEL_NAME(gate, ctrl_cliff, targ_cliff) tableau_fused_##gate##_##ctrl_cliff##_##targ_cliff
+
+#define FUSED_KERNEL(gate, ctrl_cliff, targ_cliff) \
+static CPU_DISPATCH_CLONES void FUSED_KERNEL_NAME(gate, ctrl_cliff, targ_cliff)( \
+    tableau_t* tab, const size_t ctrl, const size_t targ, const size_t start, const size_t end) \
+{ \
+    __inline_fused_two_qubit_operation(tab, ctrl, targ, start, end, \
+        LC_IDX(_##ctrl_cliff##_), LC_IDX(_##targ_cliff##_), LC_IDX(_##gate##_)); \
+}
+
+#define FUSED_FOR_EACH_TARG(FN, gate, ctrl_cliff) \
+    FN(gate, ctrl_cliff, I) FN(gate, ctrl_cliff, X) FN(gate, ctrl_cliff, Y) FN(gate, ctrl_cliff, Z) \
+    FN(gate, ctrl_cliff, H) FN(gate, ctrl_cliff, S) FN(gate, ctrl_cliff, R) FN(gate, ctrl_cliff, HX) \
+    FN(gate, ctrl_cliff, SX) FN(gate, ctrl_cliff, RX) FN(gate, ctrl_cliff, HY) FN(gate, ctrl_cliff, HZ) \
+    FN(gate, ctrl_cliff, SH) FN(gate, ctrl_cliff, RH) FN(gate, ctrl_cliff, HS) FN(gate, ctrl_cliff, HR) \
+    FN(gate, ctrl_cliff, HSX) FN(gate, ctrl_cliff, HRX) FN(gate, ctrl_cliff, SHY) FN(gate, ctrl_cliff, RHY) \
+    FN(gate, ctrl_cliff, HSH) FN(gate, ctrl_cliff, HRH) FN(gate, ctrl_cliff, RHS) FN(gate, ctrl_cliff, SHR)
+
+#define FUSED_KERNEL_ROW(gate, ctrl_cliff) FUSED_FOR_EACH_TARG(FUSED_KERNEL, gate, ctrl_cliff)
+
+#define FUSED_FOR_EACH_CTRL(FN, gate) \
+    FN(gate, I) FN(gate, X) FN(gate, Y) FN(gate, Z) FN(gate, H) FN(gate, S) FN(gate, R) FN(gate, HX) \
+    FN(gate, SX) FN(gate, RX) FN(gate, HY) FN(gate, HZ) FN(gate, SH) FN(gate, RH) FN(gate, HS) FN(gate, HR) \
+    FN(gate, HSX) FN(gate, HRX) FN(gate, SHY) FN(gate, RHY) FN(gate, HSH) FN(gate, HRH) FN(gate, RHS) FN(gate, SHR)
+
+FUSED_FOR_EACH_CTRL(FUSED_KERNEL_ROW, CNOT)
+FUSED_FOR_EACH_CTRL(FUSED_KERNEL_ROW, CZ)
+
+// Table construction
+#define FUSED_TABLE_ENTRY(gate, ctrl_cliff, targ_cliff) FUSED_KERNEL_NAME(gate, ctrl_cliff, targ_cliff),
+#define FUSED_TABLE_ROW(gate, ctrl_cliff) { FUSED_FOR_EACH_TARG(FUSED_TABLE_ENTRY, gate, ctrl_cliff) },
+
+const tableau_fused_operation_t FUSED_TWO_QUBIT_OPERATIONS[N_NON_LOCAL_CLIFFORDS][N_LOCAL_CLIFFORDS][N_LOCAL_CLIFFORDS] = {
+    { FUSED_FOR_EACH_CTRL(FUSED_TABLE_ROW, CNOT) },
+    { FUSED_FOR_EACH_CTRL(FUSED_TABLE_ROW, CZ) }
+};
+
+
+/*
+ * tableau_fused_operation_apply
+ * Applies a fused operation over the entire tableau
+ * :: tab : tableau_t* :: The tableau to operate on
+ * :: op : tableau_fused_operation_t :: The fused kernel
+ * :: ctrl : const size_t :: The control qubit
+ * :: targ : const size_t :: The target qubit
+ * Acts in place on the tableau
+ */
+void tableau_fused_operation_apply(
+    tableau_t* tab,
+    tableau_fused_operation_t op,
+    const size_t ctrl,
+    const size_t targ)
+{
+    if (NULL != tab->occupancy)
+    {
+        __inline_tableau_occupancy_union(tab, ctrl, targ);
+        if (__inline_tableau_sparse(tab, ctrl))
+        {
+            size_t pos = 0;
+            size_t run_start;
+            while (__inline_tableau_next_run(__inline_tableau_occupancy(tab, ctrl), &pos, tab->active_len, &run_start))
+            {
+                op(tab, ctrl, targ, run_start, pos);
+            }
+            return;
+        }
+    }
+
+    if (tab->active_len < tab->parallel_threshold)
+    {
+        op(tab, ctrl, targ, 0, tab->active_len);
+        return;
+    }
+
+    #pragma omp parallel
+    {
+        size_t start, end;
+        __inline_tableau_chunk_range(tab->active_len, omp_get_thread_num(), omp_get_num_threads(), &start, &end);
+        op(tab, ctrl, targ, start, end);
+    }
+    return;
+}
+
+/*
+ * tableau_fused_two_qubit_operation
+ * Applies a pair of local Cliffords followed by a two qubit gate in a single pass
+ * :: tab : tableau_t* :: The tableau to operate on
+ * :: gate : const instruction_t :: Two qubit gate opcode, either _CNOT_ or _CZ_
+ * :: ctrl_cliff : const instruction_t :: Local Clifford applied to the control before the gate
+ * :: targ_cliff : const instruction_t :: Local Clifford applied to the target before the gate
+ * :: ctrl : const size_t :: The control qubit
+ * :: targ : const size_t :: The target qubit
+ * Acts in place on the tableau
+ */
+void tableau_fused_two_qubit_operation(
+    tableau_t* tab,
+    const instruction_t gate,
+    const instruction_t ctrl_cliff,
+    const instruction_t targ_cliff,
+    const size_t ctrl,
+    const size_t targ)
+{
+    tableau_fused_operation_apply(tab, FUSED_TWO_QUBIT_OPERATION(gate, ctrl_cliff, targ_cliff), ctrl, targ);
+}
+
+/*
+ * tableau_fused_replay
+ * Replays a sequence of fused operations in a single parallel region
+ * :: tab : tableau_t* :: The tableau to operate on
+ * :: ops : const struct tableau_fused_instruction* :: Sequence of fused operations
+ * :: n_ops : const size_t :: Number of operations
+ * Column major gates only mix chunks that share an index, so each thread evolves its own range
+ * of chunks over the whole sequence without synchronising between gates
+ * As the fused kernels never swap slice pointers the pointer tables are shared read only
+ */
+void tableau_fused_replay(
+    tableau_t* tab,
+    const struct tableau_fused_instruction* ops,
+    const size_t n_ops)
+{
+    // Unions are taken in order, the final bitmaps bound the occupancy at each operation
+    // Windows touching any sparse qubit are replayed serially over runs of occupied chunks
+    bool sparse = false;
+    if (NULL != tab->occupancy)
+    {
+        for (size_t i = 0; i < n_ops; i++)
+        {
+            __inline_tableau_occupancy_union(tab, ops[i].ctrl, ops[i].targ);
+        }
+        for (size_t i = 0; (i < n_ops) && !sparse; i++)
+        {
+            sparse = __inline_tableau_sparse(tab, ops[i].ctrl);
+        }
+    }
+
+    if (sparse)
+    {
+        for (size_t i = 0; i < n_ops; i++)
+        {
+            if (__inline_tableau_sparse(tab, ops[i].ctrl))
+            {
+                size_t pos = 0;
+                size_t run_start;
+                while (__inline_tableau_next_run(__inline_tableau_occupancy(tab, ops[i].ctrl), &pos, tab->active_len, &run_start))
+                {
+                    ops[i].op(tab, ops[i].ctrl, ops[i].targ, run_start, pos);
+                }
+            }
+            else
+            {
+                ops[i].op(tab, ops[i].ctrl, ops[i].targ, 0, tab->active_len);
+            }
+        }
+        return;
+    }
+
+    if (tab->active_len < tab->parallel_threshold)
+    {
+        for (size_t i = 0; i < n_ops; i++)
+        {
+            ops[i].op(tab, ops[i].ctrl, ops[i].targ, 0, tab->active_len);
+        }
+        return;
+    }
+
+    #pragma omp parallel
+    {
+        size_t start, end;
+        __inline_tableau_chunk_range(tab->active_len, omp_get_thread_num(), omp_get_num_threads(), &start, &end);
+        if (start < end)
+        {
+            for (size_t i = 0; i < n_ops; i++)
+            {
+                ops[i].op(tab, ops[i].ctrl, ops[i].targ, start, end);
+            }
+        }
+    }
+    return;
+}
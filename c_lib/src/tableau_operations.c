@@ -2,6 +2,7 @@
 #define TABLEAU_OPERATIONS_SRC 
 
 #include "tableau_operations.h"
+#include "cpu_dispatch.h"
 
 /*
  * tableau_remove_zero_X_columns
@@ -12,9 +13,10 @@
 void tableau_remove_zero_X_columns(tableau_t* tab, clifford_queue_t* c_que)
 {
     // Can't parallelise as the H operation is already parallel
-    for (size_t i = 0; i < tab->n_qubits; i++)
+    const size_t n_active = __inline_tableau_active_qubits(tab);
+    for (size_t i = 0; i < n_active; i++)
     {
-       if (CTZ_SENTINEL == tableau_ctz(tab->slices_x[i], tab->slice_len)) 
+       if (CTZ_SENTINEL == tableau_ctz(tab->slices_x[i], tab->active_len)) 
        {
          tableau_H(tab, i);
          clifford_queue_local_clifford_right(c_que, _H_, i);   
@@ -33,8 +35,9 @@ void tableau_remove_zero_X_columns(tableau_t* tab, clifford_queue_t* c_que)
 void tableau_Z_zero_diagonal(tableau_t* tab, clifford_queue_t* c_que)
 {
     size_t i;
+    const size_t n_active = __inline_tableau_active_qubits(tab);
     #pragma omp parallel for private(i)
-    for (i = 0; i < tab->n_qubits; i++)
+    for (i = 0; i < n_active; i++)
     { 
         uint8_t z = __inline_slice_get_bit(tab->slices_z[i], i);  
         instruction_t operator = (z * (_I_)) | (!z * (_S_)); 
@@ -47,8 +50,10 @@ void tableau_Z_zero_diagonal(tableau_t* tab, clifford_queue_t* c_que)
 
 void tableau_X_diag_element(tableau_t* tab, clifford_queue_t* queue, const size_t idx)
 {
+    // Rows past the active bound are zero in every active column
+    const size_t n_active = __inline_tableau_active_qubits(tab);
 
-    for (size_t j = idx + 1; j < tab->n_qubits; j++)
+    for (size_t j = idx + 1; j < n_active; j++)
     {
         // Swap stabilisers
         if (1 == __inline_slice_get_bit(tab->slices_x[j], idx))
@@ -65,7 +70,7 @@ void tableau_X_diag_element(tableau_t* tab, clifford_queue_t* queue, const size_
         return;
     }
 
-    for (size_t j = idx + 1; j < tab->n_qubits; j++)
+    for (size_t j = idx + 1; j < n_active; j++)
     {
         // Swap stabilisers
         if (1 == __inline_slice_get_bit(tab->slices_z[j], idx))
@@ -85,39 +90,1355 @@ void tableau_X_diag_element(tableau_t* tab, clifford_queue_t* queue, const size_
 
 void tableau_X_diag_col_upper(tableau_t* tab, const size_t idx)
 {
-    size_t  j;
-    #pragma omp parallel
+    const size_t n_active = __inline_tableau_active_qubits(tab);
+    tableau_col_elim_X(tab, idx, idx + 1, n_active);
+    return;
+}
+
+
+void tableau_X_diag_col_lower(tableau_t* tab, const size_t idx)
+{
+    tableau_col_elim_X(tab, idx, 0, idx);
+    return;
+}
+
+/*
+ * __inline_tableau_m4rm_window
+ * Reads the X and Z bits of a row over a block of columns
+ * :: tab : tableau_t* :: The transposed tableau
+ * :: row : const size_t :: The row to read
+ * :: block : const size_t :: First column of the block
+ * X bits are held in the low half of the window and Z bits in the high half
+ */
+static inline
+uint64_t __inline_tableau_m4rm_window(tableau_t* tab, const size_t row, const size_t block)
+{
+    const uint64_t mask = (1ull << TABLEAU_M4RM_BLOCK) - 1;
+    const size_t chunk = block / CHUNK_SIZE_BITS;
+    const size_t offset = block % CHUNK_SIZE_BITS;
+    const uint64_t x = (TABLEAU_CHUNK(tab->slices_x[row], chunk) >> offset) & mask;
+    const uint64_t z = (TABLEAU_CHUNK(tab->slices_z[row], chunk) >> offset) & mask;
+    return x | (z << TABLEAU_M4RM_BLOCK);
+}
+
+/*
+ * tableau_m4rm_slot_t
+ * A block whose panel has been factored and whose tiles are still to be updated
+ * Later panels swap rows of the tableau, so the tile updates use the rows as they were at the
+ * end of the panel, row sums only depend on which storage is which row
+ */
+typedef struct tableau_m4rm_slot_t tableau_m4rm_slot_t;
+struct tableau_m4rm_slot_t
+{
+    size_t block; // First column of the block
+    size_t n_pivots; // Pivot rows of the block
+    size_t start; // First row to update
+    size_t end; // One past the last row to update
+    bool direct; // Whether pivot rows are added one at a time rather than from the tables
+    uint32_t* masks; // Pivot rows to be added to each row
+    uint32_t flush[TABLEAU_M4RM_BLOCK]; // Earlier pivot rows to be added to each pivot row
+    CHUNK_OBJ** rows_x; // X slices of each row at the end of the panel
+    CHUNK_OBJ** rows_z; // Z slices of each row at the end of the panel
+    CHUNK_OBJ* tables; // Combinations of pivot rows, see tableau_m4rm_tile
+};
+
+/*
+ * tableau_m4rm_t
+ * Scratch state of a blocked elimination
+ * The windows are the row view of the current block and the pivot index is its column view,
+ * bitmap w of the index holds bit w of the window of every row
+ * Pivots and the rows to eliminate are found by scanning a contiguous bitmap rather than every row
+ * Keeping the index up to date costs one bit flip per changed window bit, once this exceeds
+ * TABLEAU_M4RM_INDEX_BUDGET flips per row in a block the index is left stale and the rest of the
+ * block falls back to scanning the windows
+ */
+typedef struct tableau_m4rm_t tableau_m4rm_t;
+struct tableau_m4rm_t
+{
+    size_t n_active; // Rows of the tableau
+    size_t active_len; // Chunks of each row
+    bool upper; // Whether pivot rows are added to later rows rather than earlier rows
+    size_t block; // First column of the current block
+    uint64_t* windows; // Current X and Z bits of each row over the block
+    uint32_t* masks; // Pivot rows still to be added to each row, held by the slot of the block
+    tableau_m4rm_slot_t slots[TABLEAU_ELIM_SLOTS]; // Blocks in flight
+    size_t tile_len; // Chunks in each tile
+    size_t n_tiles; // Tiles in each row
+    size_t n_words; // Words in each bitmap of the pivot index
+    CHUNK_OBJ* bitmaps; // Storage for the pivot index
+    CHUNK_OBJ* index[2 * TABLEAU_M4RM_BLOCK]; // Bitmap for each window bit, hadamards swap these
+    size_t budget; // Remaining bit flips before the index is left stale
+    bool stale; // Whether the index no longer matches the windows
+    uint8_t pivot_mode; // Pivot strategy, see TABLEAU_PIVOT_FIRST
+    tableau_elim_stats_t stats; // Work done so far
+};
+
+/*
+ * tableau_m4rm_create
+ * Allocates the scratch state for an elimination
+ * :: tab : tableau_t* :: The transposed tableau
+ * :: pivot_mode : const uint8_t :: Pivot strategy
+ * :: upper : const bool :: Whether pivot rows are added to later rows rather than earlier rows
+ */
+static tableau_m4rm_t* tableau_m4rm_create(tableau_t* tab, const uint8_t pivot_mode, const bool upper)
+{
+    assert((TABLEAU_PIVOT_FIRST == pivot_mode) || (TABLEAU_PIVOT_MARKOWITZ == pivot_mode));
+    tableau_m4rm_t* m4rm = malloc(sizeof(tableau_m4rm_t));
+    m4rm->pivot_mode = pivot_mode;
+    m4rm->stats.row_sums = 0;
+    m4rm->stats.chunk_xors = 0;
+    m4rm->n_active = __inline_tableau_active_qubits(tab);
+    m4rm->active_len = tab->active_len;
+    m4rm->upper = upper;
+    m4rm->n_words = m4rm->n_active / CHUNK_SIZE_BITS + 1;
+    m4rm->windows = calloc(m4rm->n_words * CHUNK_SIZE_BITS, sizeof(uint64_t));
+    m4rm->bitmaps = malloc(2 * TABLEAU_M4RM_BLOCK * m4rm->n_words * sizeof(CHUNK_OBJ));
+    assert(NULL != m4rm->windows);
+    assert(NULL != m4rm->bitmaps);
+
+    for (size_t k = 0; k < TABLEAU_ELIM_SLOTS; k++)
+    {
+        tableau_m4rm_slot_t* slot = m4rm->slots + k;
+        slot->masks = malloc(m4rm->n_active * sizeof(uint32_t));
+        slot->rows_x = malloc(m4rm->n_active * sizeof(CHUNK_OBJ*));
+        slot->rows_z = malloc(m4rm->n_active * sizeof(CHUNK_OBJ*));
+        slot->tables = malloc((TABLEAU_M4RM_TABLES << TABLEAU_M4RM_BITS) * 2 * tab->active_len * sizeof(CHUNK_OBJ));
+        assert(NULL != slot->masks);
+        assert(NULL != slot->rows_x);
+        assert(NULL != slot->rows_z);
+        assert(NULL != slot->tables);
+    }
+
+    // Tiles are whole cache lines so that concurrent updates of a row do not share lines
+    m4rm->tile_len = TABLEAU_ELIM_TILE_LINES * CACHE_CHUNKS;
+    m4rm->n_tiles = tab->active_len / m4rm->tile_len + !!(tab->active_len % m4rm->tile_len);
+    return m4rm;
+}
+
+/*
+ * tableau_m4rm_destroy
+ * Frees the scratch state of an elimination and reports the work done
+ * :: m4rm : tableau_m4rm_t* :: Elimination state
+ * :: stats : tableau_elim_stats_t* :: Accumulates the work done, may be NULL
+ */
+static void tableau_m4rm_destroy(tableau_m4rm_t* m4rm, tableau_elim_stats_t* stats)
+{
+    DPRINT(DEBUG_1, "Elimination: %lu row sums, %lu chunk XORs\n", m4rm->stats.row_sums, m4rm->stats.chunk_xors);
+    if (NULL != stats)
+    {
+        stats->row_sums += m4rm->stats.row_sums;
+        stats->chunk_xors += m4rm->stats.chunk_xors;
+    }
+
+    for (size_t k = 0; k < TABLEAU_ELIM_SLOTS; k++)
+    {
+        free(m4rm->slots[k].masks);
+        free(m4rm->slots[k].rows_x);
+        free(m4rm->slots[k].rows_z);
+        free(m4rm->slots[k].tables);
+    }
+    free(m4rm->windows);
+    free(m4rm->bitmaps);
+    free(m4rm);
+}
+
+/*
+ * tableau_m4rm_index_build
+ * Rebuilds the pivot index from the windows
+ * Groups of 64 windows are transposed into one word of each bitmap
+ * Windows past the last row are kept zero
+ * Runs as tasks within the panel of a block
+ */
+static void tableau_m4rm_index_build(tableau_m4rm_t* m4rm)
+{
+    for (size_t w = 0; w < 2 * TABLEAU_M4RM_BLOCK; w++)
+    {
+        m4rm->index[w] = m4rm->bitmaps + w * m4rm->n_words;
+    }
+
+    #pragma omp taskloop grainsize(CACHE_CHUNKS)
+    for (size_t word = 0; word < m4rm->n_words; word++)
+    {
+        uint64_t group[CHUNK_SIZE_BITS];
+        uint64_t* group_ptrs[CHUNK_SIZE_BITS];
+        for (size_t k = 0; k < CHUNK_SIZE_BITS; k++)
+        {
+            group[k] = m4rm->windows[word * CHUNK_SIZE_BITS + k];
+            group_ptrs[k] = group + k;
+        }
+        CPU_DISPATCH.transpose_64x64_inplace(group_ptrs);
+        for (size_t w = 0; w < 2 * TABLEAU_M4RM_BLOCK; w++)
+        {
+            m4rm->index[w][word] = group[w];
+        }
+    }
+}
+
+/*
+ * tableau_m4rm_load
+ * Reads the windows of a block, clears the pending pivot rows and builds the pivot index
+ * Only the chunk holding the block is read
+ */
+static void tableau_m4rm_load(tableau_t* tab, tableau_m4rm_t* m4rm, const size_t block)
+{
+    m4rm->block = block;
+
+    #pragma omp taskloop grainsize(CACHE_CHUNKS * CHUNK_SIZE_BITS)
+    for (size_t j = 0; j < m4rm->n_active; j++)
+    {
+        m4rm->windows[j] = __inline_tableau_m4rm_window(tab, j, block);
+        m4rm->masks[j] = 0;
+    }
+    tableau_m4rm_index_build(m4rm);
+    m4rm->budget = TABLEAU_M4RM_INDEX_BUDGET * m4rm->n_active;
+    m4rm->stale = false;
+}
+
+/*
+ * __inline_tableau_m4rm_index_find
+ * Finds the first row at or after a given row with a bit set in a bitmap of the pivot index
+ * :: bitmap : const CHUNK_OBJ* :: Bitmap to search
+ * :: n_words : const size_t :: Words in the bitmap
+ * :: from : const size_t :: First row to consider
+ * Returns CTZ_SENTINEL if there is no such row
+ */
+static inline
+size_t __inline_tableau_m4rm_index_find(const CHUNK_OBJ* bitmap, const size_t n_words, const size_t from)
+{
+    size_t word = from / CHUNK_SIZE_BITS;
+    if (word >= n_words)
+    {
+        return CTZ_SENTINEL;
+    }
+
+    const CHUNK_OBJ first = bitmap[word] & (~0ull << (from % CHUNK_SIZE_BITS));
+    if (first)
+    {
+        return word * CHUNK_SIZE_BITS + __CHUNK_CTZ(first);
+    }
+    word++;
+
+#if TABLEAU_LAYOUT == TABLEAU_LAYOUT_SLICES
+    // Bitmaps are laid out like slices, so the vectorised ctz applies
+    const size_t pos = (word < n_words) ? tableau_ctz((CHUNK_OBJ*)bitmap + word, n_words - word) : CTZ_SENTINEL;
+    return (CTZ_SENTINEL == pos) ? CTZ_SENTINEL : word * CHUNK_SIZE_BITS + pos;
+#else
+    for (; word < n_words; word++)
+    {
+        if (bitmap[word])
+        {
+            return word * CHUNK_SIZE_BITS + __CHUNK_CTZ(bitmap[word]);
+        }
+    }
+    return CTZ_SENTINEL;
+#endif
+}
+
+/*
+ * __inline_tableau_m4rm_index_flip
+ * Flips the bits of a row in the bitmaps selected by a mask of window bits
+ * Leaves the index stale once the flip budget of the block is spent
+ */
+static inline
+void __inline_tableau_m4rm_index_flip(tableau_m4rm_t* m4rm, const size_t row, uint64_t bits)
+{
+    if (m4rm->stale)
+    {
+        return;
+    }
+
+    const size_t n_flips = __builtin_popcountll(bits);
+    if (n_flips > m4rm->budget)
+    {
+        DPRINT(DEBUG_2, "Pivot index stale from block %lu\n", m4rm->block);
+        m4rm->stale = true;
+        return;
+    }
+    m4rm->budget -= n_flips;
+
+    const CHUNK_OBJ row_bit = 1ull << (row % CHUNK_SIZE_BITS);
+    for (; bits; bits &= bits - 1)
+    {
+        m4rm->index[__CHUNK_CTZ(bits)][row / CHUNK_SIZE_BITS] ^= row_bit;
+    }
+}
+
+/*
+ * tableau_m4rm_index_find
+ * Finds the first row at or after a given row with a window bit set
+ * :: m4rm : tableau_m4rm_t* :: Elimination state
+ * :: bit : const size_t :: Window bit to search for
+ * :: from : const size_t :: First row to consider
+ * Searches the pivot index, or the windows themselves if the index is stale
+ */
+static size_t tableau_m4rm_index_find(tableau_m4rm_t* m4rm, const size_t bit, const size_t from)
+{
+    if (!m4rm->stale)
+    {
+        return __inline_tableau_m4rm_index_find(m4rm->index[bit], m4rm->n_words, from);
+    }
+
+    for (size_t j = from; j < m4rm->n_active; j++)
+    {
+        if ((m4rm->windows[j] >> bit) & 1)
+        {
+            return j;
+        }
+    }
+    return CTZ_SENTINEL;
+}
+
+/*
+ * tableau_m4rm_swap
+ * Swaps two rows of the tableau along with their windows, index bits and pending pivot masks
+ */
+static void tableau_m4rm_swap(tableau_t* tab, tableau_m4rm_t* m4rm, const size_t i, const size_t j)
+{
+    tableau_idx_swap_transverse(tab, i, j);
+
+    const uint64_t differ = m4rm->windows[i] ^ m4rm->windows[j];
+    __inline_tableau_m4rm_index_flip(m4rm, i, differ);
+    __inline_tableau_m4rm_index_flip(m4rm, j, differ);
+
+    const uint64_t window = m4rm->windows[i];
+    m4rm->windows[i] = m4rm->windows[j];
+    m4rm->windows[j] = window;
+
+    const uint32_t mask = m4rm->masks[i];
+    m4rm->masks[i] = m4rm->masks[j];
+    m4rm->masks[j] = mask;
+}
+
+/*
+ * tableau_m4rm_hadamard
+ * Applies a transverse hadamard to the tableau, the windows and the pivot index
+ * Row sums commute with the hadamard, so pending row sums are unaffected
+ */
+static void tableau_m4rm_hadamard(tableau_t* tab, clifford_queue_t* queue, tableau_m4rm_t* m4rm, const size_t idx)
+{
+    tableau_transverse_hadamard(tab, idx);
+    clifford_queue_local_clifford_right(queue, _H_, idx);
+
+    const size_t shift = idx - m4rm->block;
+    const uint64_t swap = (1ull << shift) | (1ull << (shift + TABLEAU_M4RM_BLOCK));
+    for (size_t j = 0; j < m4rm->n_active; j++)
+    {
+        const uint64_t differ = ((m4rm->windows[j] >> shift) ^ (m4rm->windows[j] >> (shift + TABLEAU_M4RM_BLOCK))) & 1;
+        m4rm->windows[j] ^= differ * swap;
+    }
+
+    CHUNK_OBJ* bitmap = m4rm->index[shift];
+    m4rm->index[shift] = m4rm->index[shift + TABLEAU_M4RM_BLOCK];
+    m4rm->index[shift + TABLEAU_M4RM_BLOCK] = bitmap;
+}
+
+/*
+ * __inline_tableau_row_weight
+ * Number of set X and Z bits in a row over the active chunks
+ */
+static inline
+size_t __inline_tableau_row_weight(tableau_t* tab, const size_t row)
+{
+    size_t weight = 0;
+    for (size_t i = 0; i < tab->active_len; i++)
+    {
+        weight += __builtin_popcountll(TABLEAU_CHUNK(tab->slices_x[row], i));
+        weight += __builtin_popcountll(TABLEAU_CHUNK(tab->slices_z[row], i));
+    }
+    return weight;
+}
+
+/*
+ * tableau_m4rm_select
+ * Selects a pivot row with a given window bit set
+ * :: tab : tableau_t* :: The transposed tableau
+ * :: m4rm : tableau_m4rm_t* :: Elimination state
+ * :: idx : const size_t :: Pivot column, the row idx is considered first
+ * :: bit : const size_t :: Window bit that the pivot row must have set
+ * With TABLEAU_PIVOT_MARKOWITZ the lowest weight of the first candidates is taken, weights are
+ * read from the tableau and do not include row sums still pending in the block
+ * Returns CTZ_SENTINEL if no row has the bit set
+ */
+static size_t tableau_m4rm_select(tableau_t* tab, tableau_m4rm_t* m4rm, const size_t idx, const size_t bit)
+{
+    size_t row = ((m4rm->windows[idx] >> bit) & 1) ? idx : tableau_m4rm_index_find(m4rm, bit, idx + 1);
+    if ((TABLEAU_PIVOT_FIRST == m4rm->pivot_mode) || (CTZ_SENTINEL == row))
+    {
+        return row;
+    }
+
+    size_t pivot = row;
+    size_t pivot_weight = __inline_tableau_row_weight(tab, row);
+    for (size_t i = 1; i < TABLEAU_PIVOT_CANDIDATES; i++)
+    {
+        row = tableau_m4rm_index_find(m4rm, bit, row + 1);
+        if (CTZ_SENTINEL == row)
+        {
+            break;
+        }
+
+        const size_t weight = __inline_tableau_row_weight(tab, row);
+        if (weight < pivot_weight)
+        {
+            pivot = row;
+            pivot_weight = weight;
+        }
+    }
+    return pivot;
+}
+
+/*
+ * tableau_m4rm_pivot
+ * Indexed equivalent of tableau_X_diag_element
+ * Windows hold the current value of each row, including any pending row sums
+ * Rows with an X bit in the pivot column are preferred, failing that a row with a Z bit is
+ * swapped in and the column is hadamarded
+ */
+static void tableau_m4rm_pivot(tableau_t* tab, clifford_queue_t* queue, tableau_m4rm_t* m4rm, const size_t idx)
+{
+    const size_t shift = idx - m4rm->block;
+
+    if ((TABLEAU_PIVOT_FIRST == m4rm->pivot_mode) && ((m4rm->windows[idx] >> shift) & 1))
+    {
+        return;
+    }
+
+    size_t row = tableau_m4rm_select(tab, m4rm, idx, shift);
+    if (CTZ_SENTINEL != row)
+    {
+        if (row != idx)
+        {
+            tableau_m4rm_swap(tab, m4rm, idx, row);
+        }
+        return;
+    }
+
+    row = tableau_m4rm_select(tab, m4rm, idx, shift + TABLEAU_M4RM_BLOCK);
+    if (CTZ_SENTINEL != row)
+    {
+        if (row != idx)
+        {
+            tableau_m4rm_swap(tab, m4rm, idx, row);
+        }
+        tableau_m4rm_hadamard(tab, queue, m4rm, idx);
+    }
+    return;
+}
+
+/*
+ * tableau_m4rm_eliminate
+ * Marks the pivot row to be added to every row in a range with an X bit in the pivot column
+ * :: m4rm : tableau_m4rm_t* :: Elimination state
+ * :: idx : const size_t :: Pivot row and column
+ * :: start : const size_t :: First row to eliminate
+ * :: end : const size_t :: One past the last row to eliminate
+ * Rows are found from the pivot index, which is only kept up to date for the later columns of
+ * the block as earlier columns are not searched again
+ * The bitmap of the pivot column is not changed here, so it remains valid if the index goes stale
+ */
+static void tableau_m4rm_eliminate(tableau_m4rm_t* m4rm, const size_t idx, const size_t start, const size_t end)
+{
+    const size_t shift = idx - m4rm->block;
+    const uint64_t later = ((1ull << TABLEAU_M4RM_BLOCK) - 1) & (~0ull << (shift + 1));
+    const uint64_t pivot = m4rm->windows[idx];
+    const uint64_t flips = pivot & (later | (later << TABLEAU_M4RM_BLOCK));
+    const CHUNK_OBJ* bitmap = m4rm->index[shift];
+
+    if (m4rm->stale)
+    {
+        for (size_t j = start; j < end; j++)
+        {
+            if ((m4rm->windows[j] >> shift) & 1)
+            {
+                m4rm->windows[j] ^= pivot;
+                m4rm->masks[j] |= 1u << shift;
+            }
+        }
+        return;
+    }
+
+    for (size_t word = start / CHUNK_SIZE_BITS; word * CHUNK_SIZE_BITS < end; word++)
+    {
+        CHUNK_OBJ rows = bitmap[word];
+        if (word == start / CHUNK_SIZE_BITS)
+        {
+            rows &= ~0ull << (start % CHUNK_SIZE_BITS);
+        }
+        if ((word + 1) * CHUNK_SIZE_BITS > end)
+        {
+            rows &= (1ull << (end % CHUNK_SIZE_BITS)) - 1;
+        }
+
+        for (; rows; rows &= rows - 1)
+        {
+            const size_t j = word * CHUNK_SIZE_BITS + __CHUNK_CTZ(rows);
+            m4rm->windows[j] ^= pivot;
+            m4rm->masks[j] |= 1u << shift;
+            __inline_tableau_m4rm_index_flip(m4rm, j, flips);
+        }
+    }
+}
+
+/*
+ * tableau_m4rm_panel
+ * Finds the pivots of a block and the pivot rows to be added to each row
+ * :: tab : tableau_t* :: The transposed tableau
+ * :: c_que : clifford_queue_t* :: The clifford queue
+ * :: m4rm : tableau_m4rm_t* :: Elimination state
+ * :: slot : tableau_m4rm_slot_t* :: Slot that the tile updates of the block read from
+ * :: block : const size_t :: First column of the block
+ * :: block_end : const size_t :: One past the last column of the block
+ * Only the windows and the chunk holding the block are changed, the rows are summed by the tiles
+ */
+static void tableau_m4rm_panel(
+    tableau_t* tab,
+    clifford_queue_t* c_que,
+    tableau_m4rm_t* m4rm,
+    tableau_m4rm_slot_t* slot,
+    const size_t block,
+    const size_t block_end)
+{
+    m4rm->masks = slot->masks;
+    tableau_m4rm_load(tab, m4rm, block);
+
+    size_t n_flushes = 0;
+    for (size_t i = block; i < block_end; i++)
+    {
+        tableau_m4rm_pivot(tab, c_que, m4rm, i);
+        if (m4rm->upper)
+        {
+            // Earlier pivot rows of the block are added to the pivot row before the tables are built
+            slot->flush[i - block] = m4rm->masks[i];
+            n_flushes += __builtin_popcount(m4rm->masks[i]);
+            m4rm->masks[i] = 0;
+            tableau_m4rm_eliminate(m4rm, i, i + 1, m4rm->n_active);
+        }
+        else
+        {
+            // Pivot rows are only added to earlier rows, so the tables hold them as they were used
+            slot->flush[i - block] = 0;
+            tableau_m4rm_eliminate(m4rm, i, 0, i);
+        }
+    }
+
+    slot->block = block;
+    slot->n_pivots = block_end - block;
+    slot->start = m4rm->upper ? block_end : 0;
+    slot->end = m4rm->upper ? m4rm->n_active : block_end;
+
+    size_t n_sums = 0;
+    size_t n_rows = 0;
+    for (size_t j = slot->start; j < slot->end; j++)
+    {
+        n_sums += __builtin_popcount(slot->masks[j]);
+        n_rows += !!slot->masks[j];
+    }
+    size_t n_entries = 0;
+    for (size_t t = 0; t * TABLEAU_M4RM_BITS < slot->n_pivots; t++)
+    {
+        const size_t n_bits = (slot->n_pivots - t * TABLEAU_M4RM_BITS < TABLEAU_M4RM_BITS) ? slot->n_pivots - t * TABLEAU_M4RM_BITS : TABLEAU_M4RM_BITS;
+        n_entries += (1ull << n_bits) - 1;
+    }
+    slot->direct = (n_sums <= n_entries + n_rows);
+    m4rm->stats.row_sums += n_flushes + n_sums;
+
+    memcpy(slot->rows_x, tab->slices_x, m4rm->n_active * sizeof(CHUNK_OBJ*));
+    memcpy(slot->rows_z, tab->slices_z, m4rm->n_active * sizeof(CHUNK_OBJ*));
+}
+
+/*
+ * __inline_tableau_m4rm_row_xor
+ * XORs the chunks [start, end) of a control row into a target row
+ */
+static inline
+void __inline_tableau_m4rm_row_xor(
+    const CHUNK_OBJ* restrict ctrl_x,
+    const CHUNK_OBJ* restrict ctrl_z,
+    CHUNK_OBJ* restrict targ_x,
+    CHUNK_OBJ* restrict targ_z,
+    const size_t start,
+    const size_t end)
+{
+    #pragma omp simd
+    for (size_t c = start; c < end; c++)
+    {
+        TABLEAU_CHUNK(targ_x, c) ^= TABLEAU_CHUNK(ctrl_x, c);
+        TABLEAU_CHUNK(targ_z, c) ^= TABLEAU_CHUNK(ctrl_z, c);
+    }
+}
+
+/*
+ * tableau_m4rm_tile_rows
+ * Adds the pending pivot rows of a block to a range of rows over a tile of chunks
+ * :: m4rm : tableau_m4rm_t* :: Elimination state
+ * :: slot : const tableau_m4rm_slot_t* :: The block
+ * :: tables : const CHUNK_OBJ* :: Tables of the tile, NULL to add the pivot rows directly
+ * :: live : const uint32_t :: Pivot rows that are not zero over the tile
+ * :: chunk_start : const size_t :: First chunk of the tile
+ * :: chunk_end : const size_t :: One past the last chunk of the tile
+ * :: start : const size_t :: First row to update
+ * :: end : const size_t :: One past the last row to update
+ */
+static void tableau_m4rm_tile_rows(
+    tableau_m4rm_t* m4rm,
+    const tableau_m4rm_slot_t* slot,
+    const CHUNK_OBJ* tables,
+    const uint32_t live,
+    const size_t chunk_start,
+    const size_t chunk_end,
+    const size_t start,
+    const size_t end)
+{
+    const size_t block = slot->block;
+    const uint32_t* masks = slot->masks;
+    CHUNK_OBJ* const* rows_x = slot->rows_x;
+    CHUNK_OBJ* const* rows_z = slot->rows_z;
+    const size_t tile_len = chunk_end - chunk_start;
+    const size_t entry_len = 2 * tile_len;
+    size_t n_xors = 0;
+
+    if (NULL == tables)
+    {
+        for (size_t j = start; j < end; j++)
+        {
+            for (uint32_t mask = masks[j] & live; mask; mask &= mask - 1)
+            {
+                const size_t pivot = block + __builtin_ctz(mask);
+                __inline_tableau_m4rm_row_xor(rows_x[pivot], rows_z[pivot], rows_x[j], rows_z[j], chunk_start, chunk_end);
+                n_xors += 2 * tile_len;
+            }
+        }
+
+        #pragma omp atomic
+        m4rm->stats.chunk_xors += n_xors;
+        return;
+    }
+
+    for (size_t j = start; j < end; j++)
+    {
+        if (0 == masks[j])
+        {
+            continue;
+        }
+
+        // Unused tables contribute their zero entry, each row is read and written once
+        const CHUNK_OBJ* entries[TABLEAU_M4RM_TABLES];
+        for (size_t t = 0; t < TABLEAU_M4RM_TABLES; t++)
+        {
+            const size_t e = (masks[j] >> (t * TABLEAU_M4RM_BITS)) & ((1ull << TABLEAU_M4RM_BITS) - 1);
+            entries[t] = tables + (((t * TABLEAU_M4RM_BITS < slot->n_pivots) ? t : 0) << TABLEAU_M4RM_BITS) * entry_len + e * entry_len;
+            n_xors += !!e * 2 * tile_len;
+        }
+
+        CHUNK_OBJ* slice_x = rows_x[j];
+        CHUNK_OBJ* slice_z = rows_z[j];
+
+        #pragma omp simd
+        for (size_t c = 0; c < tile_len; c++)
+        {
+            CHUNK_OBJ x = 0;
+            CHUNK_OBJ z = 0;
+            for (size_t t = 0; t < TABLEAU_M4RM_TABLES; t++)
+            {
+                x ^= entries[t][c];
+                z ^= entries[t][tile_len + c];
+            }
+            TABLEAU_CHUNK(slice_x, chunk_start + c) ^= x;
+            TABLEAU_CHUNK(slice_z, chunk_start + c) ^= z;
+        }
+    }
+
+    #pragma omp atomic
+    m4rm->stats.chunk_xors += n_xors;
+}
+
+/*
+ * tableau_m4rm_tile
+ * Adds the pending combinations of the pivot rows of a block to a tile of chunks
+ * :: m4rm : tableau_m4rm_t* :: Elimination state
+ * :: slot : const tableau_m4rm_slot_t* :: The block
+ * :: chunk_start : const size_t :: First chunk of the tile
+ * :: chunk_end : const size_t :: One past the last chunk of the tile
+ * Tables are built over the tile only and are held together, entry e of a table is entry e with
+ * its lowest bit cleared plus the pivot row of that bit
+ * When there are fewer row sums than table entries the pivot rows are added directly instead
+ */
+static void tableau_m4rm_tile(
+    tableau_m4rm_t* m4rm,
+    const tableau_m4rm_slot_t* slot,
+    const size_t chunk_start,
+    const size_t chunk_end)
+{
+    const size_t block = slot->block;
+    const size_t n_pivots = slot->n_pivots;
+    CHUNK_OBJ* const* rows_x = slot->rows_x;
+    CHUNK_OBJ* const* rows_z = slot->rows_z;
+    const size_t tile_len = chunk_end - chunk_start;
+    const size_t entry_len = 2 * tile_len;
+    CHUNK_OBJ* tables = slot->tables + (TABLEAU_M4RM_TABLES << TABLEAU_M4RM_BITS) * 2 * chunk_start;
+    size_t n_xors = 0;
+
+    // Pivot rows are flushed in order, so each is final before it is added to a later pivot row
+    for (size_t pivot = 0; pivot < n_pivots; pivot++)
+    {
+        for (uint32_t mask = slot->flush[pivot]; mask; mask &= mask - 1)
+        {
+            const size_t ctrl = block + __builtin_ctz(mask);
+            __inline_tableau_m4rm_row_xor(rows_x[ctrl], rows_z[ctrl], rows_x[block + pivot], rows_z[block + pivot], chunk_start, chunk_end);
+            n_xors += 2 * tile_len;
+        }
+    }
+
+    // Pivot rows that are zero over the tile add nothing to it, banded tableaus skip most tiles
+    uint32_t live = 0;
+    for (size_t pivot = 0; pivot < n_pivots; pivot++)
+    {
+        CHUNK_OBJ any = 0;
+        for (size_t c = chunk_start; c < chunk_end; c++)
+        {
+            any |= TABLEAU_CHUNK(rows_x[block + pivot], c) | TABLEAU_CHUNK(rows_z[block + pivot], c);
+        }
+        live |= (uint32_t)!!any << pivot;
+    }
+
+    size_t split = slot->end;
+    if ((0 == live) || slot->direct)
+    {
+        // Pivot rows only receive later pivots, so they are updated in order after every row
+        // that reads them
+        tables = NULL;
+        split = m4rm->upper ? slot->end : block;
+    }
+    else
+    {
+        for (size_t t = 0; t * TABLEAU_M4RM_BITS < n_pivots; t++)
+        {
+            const size_t n_bits = (n_pivots - t * TABLEAU_M4RM_BITS < TABLEAU_M4RM_BITS) ? n_pivots - t * TABLEAU_M4RM_BITS : TABLEAU_M4RM_BITS;
+            CHUNK_OBJ* table = tables + (t << TABLEAU_M4RM_BITS) * entry_len;
+
+            memset(table, 0x00, entry_len * sizeof(CHUNK_OBJ));
+            for (size_t e = 1; e < (1ull << n_bits); e++)
+            {
+                const size_t pivot = block + t * TABLEAU_M4RM_BITS + __builtin_ctzll(e);
+                const CHUNK_OBJ* prev = table + (e & (e - 1)) * entry_len;
+                CHUNK_OBJ* entry = table + e * entry_len;
+
+                #pragma omp simd
+                for (size_t c = 0; c < tile_len; c++)
+                {
+                    entry[c] = prev[c] ^ TABLEAU_CHUNK(rows_x[pivot], chunk_start + c);
+                    entry[tile_len + c] = prev[tile_len + c] ^ TABLEAU_CHUNK(rows_z[pivot], chunk_start + c);
+                }
+                n_xors += 2 * tile_len;
+            }
+        }
+    }
+
+    #pragma omp atomic
+    m4rm->stats.chunk_xors += n_xors;
+
+    const size_t n_row_tiles = (split - slot->start + TABLEAU_ELIM_TILE_ROWS - 1) / TABLEAU_ELIM_TILE_ROWS;
+    #pragma omp taskloop grainsize(1)
+    for (size_t r = 0; r < n_row_tiles; r++)
+    {
+        const size_t start = slot->start + r * TABLEAU_ELIM_TILE_ROWS;
+        const size_t end = (start + TABLEAU_ELIM_TILE_ROWS < split) ? start + TABLEAU_ELIM_TILE_ROWS : split;
+        tableau_m4rm_tile_rows(m4rm, slot, tables, live, chunk_start, chunk_end, start, end);
+    }
+    tableau_m4rm_tile_rows(m4rm, slot, tables, live, chunk_start, chunk_end, split, slot->end);
+}
+
+/*
+ * tableau_m4rm_run
+ * Eliminates the first n_qubits columns as a graph of panel and tile tasks
+ * :: tab : tableau_t* :: The transposed tableau
+ * :: c_que : clifford_queue_t* :: The clifford queue
+ * :: m4rm : tableau_m4rm_t* :: Elimination state
+ * :: n_qubits : const size_t :: Number of columns to eliminate
+ * The panel of a block follows the update of the tile holding its columns by the previous block
+ * and the updates of the slot it reuses, the update of a tile follows its panel and the update of
+ * the same tile by the previous block
+ * Markowitz pivots weigh whole rows, so with TABLEAU_PIVOT_MARKOWITZ each panel waits for every
+ * earlier update
+ */
+static void tableau_m4rm_run(tableau_t* tab, clifford_queue_t* c_que, tableau_m4rm_t* m4rm, const size_t n_qubits)
+{
+    // Dependency tokens, only their addresses are used
+    char slot_deps[TABLEAU_ELIM_SLOTS];
+    char* tile_deps = malloc(m4rm->n_tiles);
+    assert(NULL != tile_deps);
+
+    #pragma omp parallel if (tab->active_len >= tab->parallel_threshold)
+    #pragma omp single
+    {
+        for (size_t block = 0, k = 0; block < n_qubits; block += TABLEAU_M4RM_BLOCK, k++)
+        {
+            const size_t block_end = (block + TABLEAU_M4RM_BLOCK < n_qubits) ? block + TABLEAU_M4RM_BLOCK : n_qubits;
+            tableau_m4rm_slot_t* slot = m4rm->slots + k % TABLEAU_ELIM_SLOTS;
+            char* slot_dep = slot_deps + k % TABLEAU_ELIM_SLOTS;
+            char* panel_dep = tile_deps + (block / CHUNK_SIZE_BITS) / m4rm->tile_len;
+
+            if (TABLEAU_PIVOT_MARKOWITZ == m4rm->pivot_mode)
+            {
+                #pragma omp taskwait
+            }
+
+            #pragma omp task depend(inout: slot_dep[0], panel_dep[0])
+            tableau_m4rm_panel(tab, c_que, m4rm, slot, block, block_end);
+
+            for (size_t t = 0; t < m4rm->n_tiles; t++)
+            {
+                const size_t chunk_start = t * m4rm->tile_len;
+                const size_t chunk_end = (chunk_start + m4rm->tile_len < tab->active_len) ? chunk_start + m4rm->tile_len : tab->active_len;
+
+                #pragma omp task depend(in: slot_dep[0]) depend(inout: tile_deps[t])
+                tableau_m4rm_tile(m4rm, slot, chunk_start, chunk_end);
+            }
+        }
+    }
+
+    free(tile_deps);
+}
+
+/*
+ * tableau_X_elim_upper
+ * Blocked equivalent of tableau_X_diag_element and tableau_X_diag_col_upper over each column
+ * :: tab : tableau_t* :: The transposed tableau to act on
+ * :: c_que : clifford_queue_t* :: The clifford queue
+ * :: n_qubits : const size_t :: Number of columns to eliminate
+ * :: pivot_mode : const uint8_t :: Pivot strategy, see TABLEAU_PIVOT_FIRST
+ * :: stats : tableau_elim_stats_t* :: Accumulates the work done, may be NULL
+ * Pivot rows are brought up to date before the tables are built, all later rows are updated
+ * once per block
+ */
+void tableau_X_elim_upper(tableau_t* tab, clifford_queue_t* c_que, const size_t n_qubits, const uint8_t pivot_mode, tableau_elim_stats_t* stats)
+{
+    tableau_m4rm_t* m4rm = tableau_m4rm_create(tab, pivot_mode, true);
+    tableau_m4rm_run(tab, c_que, m4rm, n_qubits);
+    tableau_m4rm_destroy(m4rm, stats);
+}
+
+/*
+ * tableau_X_elim_lower
+ * Blocked equivalent of tableau_X_diag_element and tableau_X_diag_col_lower over each column
+ * :: tab : tableau_t* :: The transposed tableau to act on
+ * :: c_que : clifford_queue_t* :: The clifford queue
+ * :: n_qubits : const size_t :: Number of columns to eliminate
+ * :: pivot_mode : const uint8_t :: Pivot strategy, see TABLEAU_PIVOT_FIRST
+ * :: stats : tableau_elim_stats_t* :: Accumulates the work done, may be NULL
+ * Pivot rows are only ever added to earlier rows, so the tables are built from the pivot rows as
+ * they were when they were used, and every earlier row is updated once per block
+ */
+void tableau_X_elim_lower(tableau_t* tab, clifford_queue_t* c_que, const size_t n_qubits, const uint8_t pivot_mode, tableau_elim_stats_t* stats)
+{
+    tableau_m4rm_t* m4rm = tableau_m4rm_create(tab, pivot_mode, false);
+    tableau_m4rm_run(tab, c_que, m4rm, n_qubits);
+    tableau_m4rm_destroy(m4rm, stats);
+}
+
+/*
+ * tableau_col_elim_t
+ * Scratch state of a column elimination
+ * Pivot rows are not swapped into place, the swaps of tableau_m4rm_pivot are replayed on a
+ * permutation of the rows and the rows are only permuted once every column has been eliminated
+ * The pivots of a block are applied to its own columns one at a time, the effect of the block on
+ * any other column is a sum of the masks of the block selected by the bits of that column on
+ * the pivot rows, which is read from TABLEAU_COL_ELIM_TABLES tables of combinations of masks
+ */
+typedef struct tableau_col_elim_t tableau_col_elim_t;
+struct tableau_col_elim_t
+{
+    size_t n_active; // Rows and columns of the tableau
+    size_t active_len; // Chunks of each column
+    size_t* order; // Row held at each position after the swaps so far
+    size_t* where; // Position of each row, the inverse of order
+    CHUNK_OBJ* displaced; // Rows that are not at their own position
+    size_t n_pivots; // Pivots of the current block
+    size_t rows[TABLEAU_COL_ELIM_BLOCK]; // Pivot rows of the current block in order
+    uint64_t later[TABLEAU_COL_ELIM_BLOCK]; // Bit k of entry j is set if mask j holds pivot row k > j
+    CHUNK_OBJ* masks; // Rows that each pivot of the block is added to
+    size_t start; // First non zero chunk of any mask of the block
+    size_t end; // One past the last non zero chunk of any mask of the block
+    size_t n_words; // Chunks holding the pivot rows of the block
+    size_t words[TABLEAU_COL_ELIM_BLOCK]; // Index of each of these chunks
+    CHUNK_OBJ word_masks[TABLEAU_COL_ELIM_BLOCK]; // Pivot rows within each of these chunks
+    uint8_t word_pivots[TABLEAU_COL_ELIM_BLOCK][CHUNK_SIZE_BITS]; // Pivot of each of these rows
+    CHUNK_OBJ* tables; // Combinations of masks, see tableau_col_elim_update
+    tableau_elim_stats_t stats; // Work done so far
+};
+
+/*
+ * tableau_col_elim_create
+ * Allocates the scratch state for a column elimination
+ * :: tab : tableau_t* :: The tableau in its column major orientation
+ */
+static tableau_col_elim_t* tableau_col_elim_create(tableau_t* tab)
+{
+    tableau_col_elim_t* elim = malloc(sizeof(tableau_col_elim_t));
+    elim->n_active = __inline_tableau_active_qubits(tab);
+    elim->active_len = tab->active_len;
+    elim->stats.row_sums = 0;
+    elim->stats.chunk_xors = 0;
+    elim->order = malloc(tab->active_len * CHUNK_SIZE_BITS * sizeof(size_t));
+    elim->where = malloc(tab->active_len * CHUNK_SIZE_BITS * sizeof(size_t));
+    elim->displaced = calloc(tab->active_len, sizeof(CHUNK_OBJ));
+    elim->masks = malloc(TABLEAU_COL_ELIM_BLOCK * tab->active_len * sizeof(CHUNK_OBJ));
+    elim->tables = malloc((TABLEAU_COL_ELIM_TABLES << TABLEAU_M4RM_BITS) * tab->active_len * sizeof(CHUNK_OBJ));
+    assert(NULL != elim->order);
+    assert(NULL != elim->where);
+    assert(NULL != elim->displaced);
+    assert(NULL != elim->masks);
+    assert(NULL != elim->tables);
+
+    for (size_t i = 0; i < tab->active_len * CHUNK_SIZE_BITS; i++)
+    {
+        elim->order[i] = i;
+        elim->where[i] = i;
+    }
+    return elim;
+}
+
+/*
+ * tableau_col_elim_destroy
+ * Frees the scratch state of a column elimination and reports the work done
+ * :: elim : tableau_col_elim_t* :: Elimination state
+ * :: stats : tableau_elim_stats_t* :: Accumulates the work done, may be NULL
+ */
+static void tableau_col_elim_destroy(tableau_col_elim_t* elim, tableau_elim_stats_t* stats)
+{
+    DPRINT(DEBUG_1, "Column elimination: %lu row sums, %lu chunk XORs\n", elim->stats.row_sums, elim->stats.chunk_xors);
+    if (NULL != stats)
+    {
+        stats->row_sums += elim->stats.row_sums;
+        stats->chunk_xors += elim->stats.chunk_xors;
+    }
+    free(elim->order);
+    free(elim->where);
+    free(elim->displaced);
+    free(elim->masks);
+    free(elim->tables);
+    free(elim);
+}
+
+/*
+ * __inline_tableau_col_elim_displace
+ * Marks whether a row is away from its own position
+ * :: elim : tableau_col_elim_t* :: Elimination state
+ * :: row : const size_t :: The row
+ */
+static inline
+void __inline_tableau_col_elim_displace(tableau_col_elim_t* elim, const size_t row)
+{
+    const CHUNK_OBJ bit = 1ull << (row % CHUNK_SIZE_BITS);
+    elim->displaced[row / CHUNK_SIZE_BITS] = (elim->displaced[row / CHUNK_SIZE_BITS] & ~bit) | ((elim->where[row] != row) ? bit : 0);
+}
+
+/*
+ * tableau_col_elim_select
+ * Finds the row with a bit set in a column at the lowest position from the column onwards
+ * :: elim : const tableau_col_elim_t* :: Elimination state
+ * :: slice : const CHUNK_OBJ* :: The column
+ * :: idx : const size_t :: Index of the column
+ * Positions follow the row swaps of the transposed elimination, so the same pivots are chosen
+ * Rows at their own position are found by index, only displaced rows are looked up one at a time
+ * Returns CTZ_SENTINEL if there is no such row
+ */
+static size_t tableau_col_elim_select(const tableau_col_elim_t* elim, const CHUNK_OBJ* slice, const size_t idx)
+{
+    const size_t own = elim->order[idx];
+    if ((TABLEAU_CHUNK(slice, own / CHUNK_SIZE_BITS) >> (own % CHUNK_SIZE_BITS)) & 1)
+    {
+        return own;
+    }
+
+    size_t row = CTZ_SENTINEL;
+    size_t pos = CTZ_SENTINEL;
+    for (size_t i = (idx + 1) / CHUNK_SIZE_BITS; i < elim->active_len; i++)
+    {
+        CHUNK_OBJ rows = TABLEAU_CHUNK(slice, i) & ~elim->displaced[i];
+        if (i == (idx + 1) / CHUNK_SIZE_BITS)
+        {
+            rows &= ~0ull << ((idx + 1) % CHUNK_SIZE_BITS);
+        }
+        if (rows)
+        {
+            row = i * CHUNK_SIZE_BITS + __CHUNK_CTZ(rows);
+            pos = row;
+            break;
+        }
+    }
+
+    for (size_t i = 0; i < elim->active_len; i++)
     {
-        #pragma omp for 
-        for (j = idx + 1; j < tab->n_qubits; j++) 
+        CHUNK_OBJ rows = TABLEAU_CHUNK(slice, i) & elim->displaced[i];
+        while (rows)
         {
-            if (1 == __inline_slice_get_bit(tab->slices_x[j], idx))
+            const size_t r = i * CHUNK_SIZE_BITS + __CHUNK_CTZ(rows);
+            rows &= rows - 1;
+            if ((elim->where[r] > idx) && (elim->where[r] < pos))
             {
-                tableau_slice_xor(tab, idx, j);
+                row = r;
+                pos = elim->where[r];
             }
         }
     }
-    return;
+    return row;
 }
 
+/*
+ * tableau_col_elim_panel
+ * Finds the pivots of a block and eliminates them from the columns of the block
+ * :: tab : tableau_t* :: The tableau in its column major orientation
+ * :: c_que : clifford_queue_t* :: The clifford queue
+ * :: elim : tableau_col_elim_t* :: Elimination state
+ * :: block : const size_t :: First column of the block
+ * :: block_end : const size_t :: One past the last column of the block
+ * Rows with an X bit in the column are preferred, failing that the X and Z slices of the column
+ * are exchanged, which is a hadamard in this orientation
+ * Each pivot row is added to every other row with an X bit in its column, the mask of these rows
+ * is kept for the remaining columns
+ */
+static void tableau_col_elim_panel(
+    tableau_t* tab,
+    clifford_queue_t* c_que,
+    tableau_col_elim_t* elim,
+    const size_t block,
+    const size_t block_end)
+{
+    const size_t len = elim->active_len;
+    elim->n_pivots = 0;
+    elim->start = len;
+    elim->end = 0;
 
-void tableau_X_diag_col_lower(tableau_t* tab, const size_t idx)
+    for (size_t i = block; i < block_end; i++)
+    {
+        size_t row = tableau_col_elim_select(elim, tab->slices_x[i], i);
+        if (CTZ_SENTINEL == row)
+        {
+            row = tableau_col_elim_select(elim, tab->slices_z[i], i);
+            if (CTZ_SENTINEL == row)
+            {
+                continue;
+            }
+            tableau_slice_p tmp = tab->slices_x[i];
+            tab->slices_x[i] = tab->slices_z[i];
+            tab->slices_z[i] = tmp;
+            clifford_queue_local_clifford_right(c_que, _H_, i);
+        }
+
+        // Swap the pivot row into position
+        const size_t pos = elim->where[row];
+        elim->order[pos] = elim->order[i];
+        elim->where[elim->order[i]] = pos;
+        elim->order[i] = row;
+        elim->where[row] = i;
+        __inline_tableau_col_elim_displace(elim, row);
+        __inline_tableau_col_elim_displace(elim, elim->order[pos]);
+
+        const size_t k = elim->n_pivots++;
+        const size_t word = row / CHUNK_SIZE_BITS;
+        const CHUNK_OBJ bit = 1ull << (row % CHUNK_SIZE_BITS);
+        elim->rows[k] = row;
+
+        // The mask is every other row with an X bit in the pivot column
+        CHUNK_OBJ* mask = elim->masks + k * len;
+        size_t start = len;
+        size_t end = 0;
+        for (size_t j = 0; j < len; j++)
+        {
+            mask[j] = TABLEAU_CHUNK(tab->slices_x[i], j) ^ ((j == word) ? bit : 0);
+            if (mask[j])
+            {
+                start = (j < start) ? j : start;
+                end = j + 1;
+            }
+        }
+        elim->start = (start < elim->start) ? start : elim->start;
+        elim->end = (end > elim->end) ? end : elim->end;
+        for (size_t j = start; j < end; j++)
+        {
+            elim->stats.row_sums += __builtin_popcountll(mask[j]);
+        }
+
+        // Earlier X columns of the block hold a single earlier pivot row and are unchanged
+        for (size_t j = block; j < block_end; j++)
+        {
+            CHUNK_OBJ* cols[2] = {tab->slices_x[j], tab->slices_z[j]};
+            for (size_t s = (j < i); s < 2; s++)
+            {
+                if ((start < end) && (TABLEAU_CHUNK(cols[s], word) & bit))
+                {
+                    #pragma omp simd
+                    for (size_t c = start; c < end; c++)
+                    {
+                        TABLEAU_CHUNK(cols[s], c) ^= mask[c];
+                    }
+                    elim->stats.chunk_xors += end - start;
+                }
+            }
+        }
+    }
+
+    // Later pivot rows that each mask is added to
+    for (size_t j = 0; j < elim->n_pivots; j++)
+    {
+        const CHUNK_OBJ* mask = elim->masks + j * len;
+        elim->later[j] = 0;
+        for (size_t k = j + 1; k < elim->n_pivots; k++)
+        {
+            elim->later[j] |= ((mask[elim->rows[k] / CHUNK_SIZE_BITS] >> (elim->rows[k] % CHUNK_SIZE_BITS)) & 1ull) << k;
+        }
+    }
+
+    // Group the pivot rows by the chunk that holds them
+    elim->n_words = 0;
+    for (size_t k = 0; k < elim->n_pivots; k++)
+    {
+        const size_t word = elim->rows[k] / CHUNK_SIZE_BITS;
+        size_t w = 0;
+        while ((w < elim->n_words) && (elim->words[w] != word))
+        {
+            w++;
+        }
+        if (w == elim->n_words)
+        {
+            elim->words[w] = word;
+            elim->word_masks[w] = 0;
+            elim->n_words++;
+        }
+        elim->word_masks[w] |= 1ull << (elim->rows[k] % CHUNK_SIZE_BITS);
+        elim->word_pivots[w][elim->rows[k] % CHUNK_SIZE_BITS] = k;
+    }
+}
+
+/*
+ * tableau_col_elim_tables
+ * Builds the table of every combination of one group of TABLEAU_M4RM_BITS masks
+ * :: elim : tableau_col_elim_t* :: Elimination state
+ * :: t : const size_t :: Group of masks
+ * Entries only cover the chunks [start, end) of the block, each entry is an earlier entry plus
+ * a single mask
+ */
+static void tableau_col_elim_tables(tableau_col_elim_t* elim, const size_t t)
 {
-    size_t j;
-    CHUNK_OBJ* slice = tab->slices_x[idx];
+    const size_t len = elim->active_len;
+    const size_t entry_len = elim->end - elim->start;
+    const size_t n_bits = (elim->n_pivots - t * TABLEAU_M4RM_BITS < TABLEAU_M4RM_BITS) ? elim->n_pivots - t * TABLEAU_M4RM_BITS : TABLEAU_M4RM_BITS;
+    CHUNK_OBJ* table = elim->tables + (t << TABLEAU_M4RM_BITS) * entry_len;
 
-    #pragma omp parallel
+    memset(table, 0, entry_len * sizeof(CHUNK_OBJ));
+    for (size_t e = 1; e < (1ull << n_bits); e++)
+    {
+        const CHUNK_OBJ* prev = table + (e & (e - 1)) * entry_len;
+        const CHUNK_OBJ* mask = elim->masks + (t * TABLEAU_M4RM_BITS + __builtin_ctzll(e)) * len + elim->start;
+        CHUNK_OBJ* entry = table + e * entry_len;
+
+        #pragma omp simd
+        for (size_t c = 0; c < entry_len; c++)
+        {
+            entry[c] = prev[c] ^ mask[c];
+        }
+    }
+}
+
+/*
+ * tableau_col_elim_update
+ * Applies the pivots of a block to a column outside of the block
+ * :: elim : const tableau_col_elim_t* :: Elimination state
+ * :: slice : CHUNK_OBJ* :: The column
+ * Bit k of the sum is the bit of the column on pivot row k once the earlier masks of the block
+ * have been added, these are found from the bits of the column before the block
+ * Returns the number of chunks XORed
+ */
+static inline
+size_t tableau_col_elim_update(const tableau_col_elim_t* elim, CHUNK_OBJ* slice)
+{
+    uint64_t bits = 0;
+    for (size_t w = 0; w < elim->n_words; w++)
+    {
+        for (CHUNK_OBJ rows = TABLEAU_CHUNK(slice, elim->words[w]) & elim->word_masks[w]; rows; rows &= rows - 1)
+        {
+            bits |= 1ull << elim->word_pivots[w][__CHUNK_CTZ(rows)];
+        }
+    }
+    if (0 == bits)
+    {
+        return 0;
+    }
+
+    uint64_t sum = 0;
+    while (bits)
+    {
+        const size_t k = __builtin_ctzll(bits);
+        bits &= bits - 1;
+        bits ^= elim->later[k];
+        sum |= 1ull << k;
+    }
+
+    const size_t entry_len = elim->end - elim->start;
+    const CHUNK_OBJ* entries[TABLEAU_COL_ELIM_TABLES];
+    size_t n_entries = 0;
+    for (size_t t = 0; t < TABLEAU_COL_ELIM_TABLES; t++)
+    {
+        const size_t e = (sum >> (t * TABLEAU_M4RM_BITS)) & ((1ull << TABLEAU_M4RM_BITS) - 1);
+        if (e)
+        {
+            entries[n_entries++] = elim->tables + ((t << TABLEAU_M4RM_BITS) + e) * entry_len;
+        }
+    }
+
+    CHUNK_OBJ* targ = slice + elim->start * TABLEAU_CHUNK_STRIDE;
+    for (size_t e = 0; e < n_entries; e++)
+    {
+        const CHUNK_OBJ* entry = entries[e];
+        #pragma omp simd
+        for (size_t c = 0; c < entry_len; c++)
+        {
+            TABLEAU_CHUNK(targ, c) ^= entry[c];
+        }
+    }
+    return n_entries * entry_len;
+}
+
+/*
+ * tableau_col_elim_permute
+ * Moves each row to its position after the swaps of the elimination
+ * :: tab : tableau_t* :: The tableau in its column major orientation
+ * :: elim : const tableau_col_elim_t* :: Elimination state
+ * Moving a row touches one bit of every column, once enough rows move it is cheaper to transpose
+ * and permute the slice pointers, see TABLEAU_COL_ELIM_TRANSPOSE
+ * Returns true if the tableau was transposed
+ */
+static bool tableau_col_elim_permute(tableau_t* tab, const tableau_col_elim_t* elim)
+{
+    const size_t n_active = elim->n_active;
+    const size_t* perm = elim->order;
+    size_t* moved = malloc(n_active * sizeof(size_t));
+    assert(NULL != moved);
+
+    size_t n_moved = 0;
+    for (size_t i = 0; i < n_active; i++)
+    {
+        if (perm[i] != i)
+        {
+            moved[n_moved++] = i;
+        }
+    }
+
+    uint8_t* phases = malloc(n_moved + 1);
+    for (size_t i = 0; i < n_moved; i++)
+    {
+        phases[i] = __inline_slice_get_bit(tab->phases, perm[moved[i]]);
+    }
+    for (size_t i = 0; i < n_moved; i++)
+    {
+        __inline_slice_set_bit(tab->phases, moved[i], phases[i]);
+    }
+    free(phases);
+
+    const bool transpose = (n_moved * TABLEAU_COL_ELIM_TRANSPOSE > n_active);
+    DPRINT(DEBUG_2, "\t%lu rows permuted by %s\n", n_moved, transpose ? "transpose" : "bit moves");
+    if (transpose)
     {
-        #pragma omp for
-        for (j = 0; j < idx; j++) 
+        // Rows are slices once transposed
+        tableau_transpose(tab);
+        tableau_slice_p* slices_x = malloc(n_moved * sizeof(tableau_slice_p));
+        tableau_slice_p* slices_z = malloc(n_moved * sizeof(tableau_slice_p));
+        for (size_t i = 0; i < n_moved; i++)
         {
-            if (1 == __inline_slice_get_bit(tab->slices_x[j], idx))
+            slices_x[i] = tab->slices_x[perm[moved[i]]];
+            slices_z[i] = tab->slices_z[perm[moved[i]]];
+        }
+        for (size_t i = 0; i < n_moved; i++)
+        {
+            tab->slices_x[moved[i]] = slices_x[i];
+            tab->slices_z[moved[i]] = slices_z[i];
+        }
+        free(slices_x);
+        free(slices_z);
+    }
+    else if (n_moved > 0)
+    {
+        #pragma omp parallel if (n_moved * tab->active_len >= tab->parallel_threshold)
+        {
+            uint8_t* bits = malloc(n_moved);
+
+            #pragma omp for schedule(static)
+            for (size_t j = 0; j < 2 * n_active; j++)
             {
-                tableau_slice_xor(tab, idx, j);
+                tableau_slice_p slice = (j < n_active) ? tab->slices_x[j] : tab->slices_z[j - n_active];
+                for (size_t i = 0; i < n_moved; i++)
+                {
+                    bits[i] = __inline_slice_get_bit(slice, perm[moved[i]]);
+                }
+                for (size_t i = 0; i < n_moved; i++)
+                {
+                    __inline_slice_set_bit(slice, moved[i], bits[i]);
+                }
             }
+            free(bits);
         }
     }
-    return;
+
+    free(moved);
+    return transpose;
+}
+
+/*
+ * tableau_X_elim_cols
+ * Column major equivalent of tableau_X_elim_upper followed by tableau_X_elim_lower
+ * :: tab : tableau_t* :: The tableau in its column major orientation
+ * :: c_que : clifford_queue_t* :: The clifford queue
+ * :: n_qubits : const size_t :: Number of columns to eliminate
+ * :: stats : tableau_elim_stats_t* :: Accumulates the work done, may be NULL
+ * Columns are taken in blocks of TABLEAU_COL_ELIM_BLOCK, every other column is then updated once
+ * per block and columns that hold none of the pivot rows are skipped
+ * Returns true if the tableau was left transposed, see tableau_col_elim_permute
+ */
+bool tableau_X_elim_cols(tableau_t* tab, clifford_queue_t* c_que, const size_t n_qubits, tableau_elim_stats_t* stats)
+{
+    // Slices are written without maintaining their occupancy
+    tableau_sparse_disable(tab);
+
+    tableau_col_elim_t* elim = tableau_col_elim_create(tab);
+    const size_t n_active = elim->n_active;
+
+    for (size_t block = 0; block < n_qubits; block += TABLEAU_COL_ELIM_BLOCK)
+    {
+        const size_t block_end = (block + TABLEAU_COL_ELIM_BLOCK < n_qubits) ? block + TABLEAU_COL_ELIM_BLOCK : n_qubits;
+        tableau_col_elim_panel(tab, c_que, elim, block, block_end);
+        if ((0 == elim->n_pivots) || (elim->start >= elim->end))
+        {
+            continue;
+        }
+
+        const size_t n_tables = elim->n_pivots / TABLEAU_M4RM_BITS + !!(elim->n_pivots % TABLEAU_M4RM_BITS);
+        size_t n_xors = n_tables * ((1ull << TABLEAU_M4RM_BITS) - 1) * (elim->end - elim->start);
+
+        #pragma omp parallel if (elim->active_len >= tab->parallel_threshold)
+        {
+            #pragma omp for
+            for (size_t t = 0; t < n_tables; t++)
+            {
+                tableau_col_elim_tables(elim, t);
+            }
+
+            #pragma omp for schedule(dynamic, CACHE_CHUNKS) reduction(+:n_xors)
+            for (size_t j = 0; j < 2 * n_active; j++)
+            {
+                const size_t col = j % n_active;
+                if ((col < block) || (col >= block_end))
+                {
+                    n_xors += tableau_col_elim_update(elim, (j < n_active) ? tab->slices_x[col] : tab->slices_z[col]);
+                }
+            }
+        }
+        elim->stats.chunk_xors += n_xors;
+    }
+
+    const bool transposed = tableau_col_elim_permute(tab, elim);
+    tableau_col_elim_destroy(elim, stats);
+    return transposed;
 }
 
 /*
@@ -129,7 +1450,8 @@ void tableau_X_diagonal(tableau_t* tab, clifford_queue_t* c_que)
 {
     tableau_transpose(tab);
 
-    for (size_t i = 0; i < tab->n_qubits; i++)
+    const size_t n_active = __inline_tableau_active_qubits(tab);
+    for (size_t i = 0; i < n_active; i++)
     {
         // X(i, i) != 1 
         if (0 == __inline_slice_get_bit(tab->slices_x[i], i))
@@ -141,76 +1463,201 @@ void tableau_X_diagonal(tableau_t* tab, clifford_queue_t* c_que)
 }
 
 
-void tableau_H(tableau_t* tab, const size_t targ)
+/*
+ * Kernel selection
+ * Gates use the kernel tables selected for this host at load time, see cpu_dispatch.h
+ */
+#define SINGLE_QUBIT_KERNELS (CPU_DISPATCH.single_qubit_kernels)
+#define TWO_QUBIT_KERNELS (CPU_DISPATCH.two_qubit_kernels)
+
+
+/*
+ * __inline_tableau_single_qubit_dispatch
+ * Runs a single qubit chunk range kernel over a slice
+ * :: tab : tableau_t* :: The tableau to operate on
+ * :: targ : const size_t :: The target qubit
+ * :: kernel : tableau_kernel_t :: Chunk range kernel
+ * :: swap : const bool :: Whether the operation exchanges the X and Z slices
+ * Slices shorter than the tableau's parallel threshold are handled serially, otherwise each
+ * thread of the team is given a disjoint cache aligned range of chunks
+ * Sparse qubits are handled serially over their runs of occupied chunks
+ */
+static inline
+void __inline_tableau_single_qubit_dispatch(
+    tableau_t* tab,
+    const size_t targ,
+    tableau_kernel_t kernel,
+    const bool swap)
 {
     CHUNK_OBJ* slice_x = (CHUNK_OBJ*)(tab->slices_x[targ]); 
     CHUNK_OBJ* slice_z = (CHUNK_OBJ*)(tab->slices_z[targ]); 
     CHUNK_OBJ* slice_r = (CHUNK_OBJ*)(tab->phases); 
 
-    size_t i;
-    #pragma omp parallel private(i)
+    if (__inline_tableau_sparse(tab, targ))
     {
-        #pragma omp for simd
-        for (i = 0; i < tab->slice_len; i++)
+        size_t pos = 0;
+        size_t run_start;
+        while (__inline_tableau_next_run(__inline_tableau_occupancy(tab, targ), &pos, tab->active_len, &run_start))
         {
-            __atomic_fetch_xor(slice_r + i, slice_x[i] & slice_z[i], __ATOMIC_RELAXED);      
-        }  
+            kernel(slice_x, slice_z, slice_r, run_start, pos);
+        }
+    }
+    else if (tab->active_len < tab->parallel_threshold)
+    {
+        kernel(slice_x, slice_z, slice_r, 0, tab->active_len);
+    }
+    else
+    {
+        #pragma omp parallel
+        {
+            size_t start, end;
+            __inline_tableau_chunk_range(tab->active_len, omp_get_thread_num(), omp_get_num_threads(), &start, &end);
+            kernel(slice_x, slice_z, slice_r, start, end);
+        }
     }
-    void* ptr = tab->slices_x[targ];
-    tab->slices_x[targ] = tab->slices_z[targ];
-    tab->slices_z[targ] = ptr;
-}
 
+    if (swap)
+    {
+        void* ptr = tab->slices_x[targ];
+        tab->slices_x[targ] = tab->slices_z[targ];
+        tab->slices_z[targ] = ptr;
+    }
+    return;
+}
 
-void tableau_S(tableau_t* tab, const size_t targ)
+/*
+ * __inline_tableau_two_qubit_dispatch
+ * Runs a two qubit chunk range kernel over a pair of slices
+ * :: tab : tableau_t* :: The tableau to operate on
+ * :: ctrl : const size_t :: The control qubit
+ * :: targ : const size_t :: The target qubit
+ * :: kernel : tableau_two_qubit_kernel_t :: Chunk range kernel
+ * As with the single qubit dispatch, short or sparse slices are handled serially
+ */
+static inline
+void __inline_tableau_two_qubit_dispatch(
+    tableau_t* tab,
+    const size_t ctrl,
+    const size_t targ,
+    tableau_two_qubit_kernel_t kernel)
 {
-    CHUNK_OBJ* slice_x = (CHUNK_OBJ*)(tab->slices_x[targ]); 
-    CHUNK_OBJ* slice_z = (CHUNK_OBJ*)(tab->slices_z[targ]); 
+    CHUNK_OBJ* ctrl_slice_x = (CHUNK_OBJ*)(tab->slices_x[ctrl]); 
+    CHUNK_OBJ* ctrl_slice_z = (CHUNK_OBJ*)(tab->slices_z[ctrl]); 
+    CHUNK_OBJ* targ_slice_x = (CHUNK_OBJ*)(tab->slices_x[targ]); 
+    CHUNK_OBJ* targ_slice_z = (CHUNK_OBJ*)(tab->slices_z[targ]); 
     CHUNK_OBJ* slice_r = (CHUNK_OBJ*)(tab->phases); 
 
-    size_t i;
-    #pragma omp parallel private(i)
+    if (NULL != tab->occupancy)
     {
-        #pragma omp for simd
-        for (i = 0; i < tab->slice_len; i++)
+        __inline_tableau_occupancy_union(tab, ctrl, targ);
+        if (__inline_tableau_sparse(tab, ctrl))
         {
-            __atomic_fetch_xor(slice_r + i, slice_x[i] & slice_z[i], __ATOMIC_RELAXED);      
-            slice_z[i] ^= slice_x[i]; 
-        }  
+            size_t pos = 0;
+            size_t run_start;
+            while (__inline_tableau_next_run(__inline_tableau_occupancy(tab, ctrl), &pos, tab->active_len, &run_start))
+            {
+                kernel(ctrl_slice_x, ctrl_slice_z, targ_slice_x, targ_slice_z, slice_r, run_start, pos);
+            }
+            return;
+        }
+    }
+
+    if (tab->active_len < tab->parallel_threshold)
+    {
+        kernel(ctrl_slice_x, ctrl_slice_z, targ_slice_x, targ_slice_z, slice_r, 0, tab->active_len);
+        return;
+    }
+
+    #pragma omp parallel
+    {
+        size_t start, end;
+        __inline_tableau_chunk_range(tab->active_len, omp_get_thread_num(), omp_get_num_threads(), &start, &end);
+        kernel(ctrl_slice_x, ctrl_slice_z, targ_slice_x, targ_slice_z, slice_r, start, end);
+    }
+    return;
+}
+
+
+static
+void tableau_H_range(
+    CHUNK_OBJ* restrict slice_x,
+    CHUNK_OBJ* restrict slice_z,
+    CHUNK_OBJ* restrict slice_r,
+    const size_t start,
+    const size_t end)
+{
+    #pragma omp simd
+    TABLEAU_FOR_EACH_CHUNK(i, start, end)
+    {
+        slice_r[i] ^= slice_x[i] & slice_z[i];
     }
 }
 
-void tableau_Z(tableau_t* tab, const size_t targ)
+void tableau_H(tableau_t* tab, const size_t targ)
 {
-    CHUNK_OBJ* slice_x = (CHUNK_OBJ*)(tab->slices_x[targ]); 
-    CHUNK_OBJ* slice_r = (CHUNK_OBJ*)(tab->phases); 
-/*
- * Doubled S gate
- * S: (r ^= x.z; z ^= x)
- * r1 = r0 ^ (x.z0); z1 = z0 ^ x 
- * r2 = r0 ^ (x.z0) ^ (x.(z0 ^ x)); z2 = z0 ^ x ^ x 
- * r2 = r0 ^ x.(z0 ^ z0 ^ x); z2 = z0 
- * r2 = r0 ^ x; z2 = z0 
- */
+    __inline_tableau_single_qubit_dispatch(tab, targ, SINGLE_QUBIT_KERNELS[_H_ & INSTRUCTION_OPERATOR_MASK], true);
+}
 
-    size_t i;
-    #pragma omp parallel private(i) 
+
+static
+void tableau_S_range(
+    CHUNK_OBJ* restrict slice_x,
+    CHUNK_OBJ* restrict slice_z,
+    CHUNK_OBJ* restrict slice_r,
+    const size_t start,
+    const size_t end)
+{
+    #pragma omp simd
+    TABLEAU_FOR_EACH_CHUNK(i, start, end)
     {
-        #pragma omp for simd
-        for (i = 0; i < tab->slice_len; i++)
-        {
-            __atomic_fetch_xor(slice_r + i, slice_x[i], __ATOMIC_RELAXED);      
-        }  
+        slice_r[i] ^= slice_x[i] & slice_z[i];
+        slice_z[i] ^= slice_x[i];
     }
 }
 
+void tableau_S(tableau_t* tab, const size_t targ)
+{
+    __inline_tableau_single_qubit_dispatch(tab, targ, SINGLE_QUBIT_KERNELS[_S_ & INSTRUCTION_OPERATOR_MASK], false);
+}
 
-void tableau_R(tableau_t* tab, const size_t targ)
+static
+void tableau_Z_range(
+    CHUNK_OBJ* restrict slice_x,
+    CHUNK_OBJ* restrict slice_z,
+    CHUNK_OBJ* restrict slice_r,
+    const size_t start,
+    const size_t end)
 {
-    CHUNK_OBJ* slice_x = (CHUNK_OBJ*)(tab->slices_x[targ]); 
-    CHUNK_OBJ* slice_z = (CHUNK_OBJ*)(tab->slices_z[targ]); 
-    CHUNK_OBJ* slice_r = (CHUNK_OBJ*)(tab->phases); 
+    /*
+     * Doubled S gate
+     * S: (r ^= x.z; z ^= x)
+     * r1 = r0 ^ (x.z0); z1 = z0 ^ x 
+     * r2 = r0 ^ (x.z0) ^ (x.(z0 ^ x)); z2 = z0 ^ x ^ x 
+     * r2 = r0 ^ x.(z0 ^ z0 ^ x); z2 = z0 
+     * r2 = r0 ^ x; z2 = z0 
+     */
+
+    #pragma omp simd
+    TABLEAU_FOR_EACH_CHUNK(i, start, end)
+    {
+        slice_r[i] ^= slice_x[i];
+    }
+}
+
+void tableau_Z(tableau_t* tab, const size_t targ)
+{
+    __inline_tableau_single_qubit_dispatch(tab, targ, SINGLE_QUBIT_KERNELS[_Z_ & INSTRUCTION_OPERATOR_MASK], false);
+}
 
+
+static
+void tableau_R_range(
+    CHUNK_OBJ* restrict slice_x,
+    CHUNK_OBJ* restrict slice_z,
+    CHUNK_OBJ* restrict slice_r,
+    const size_t start,
+    const size_t end)
+{
     /*
      * Triple S gate
      * S : (r ^= x.z; z ^= x)
@@ -226,64 +1673,73 @@ void tableau_R(tableau_t* tab, const size_t targ)
      * R : (r ^= x.~z; z ^= x)
      */
 
-    size_t i;
-    #pragma omp parallel private(i) 
+    #pragma omp simd
+    TABLEAU_FOR_EACH_CHUNK(i, start, end)
     {
-        #pragma omp for simd
-        for (i = 0; i < tab->slice_len; i++)
-        {
-            __atomic_fetch_xor(slice_r + i, slice_x[i] & ~slice_z[i], __ATOMIC_RELAXED);
-            slice_z[i] ^= slice_x[i]; 
-        }  
+        slice_r[i] ^= slice_x[i] & ~slice_z[i];
+        slice_z[i] ^= slice_x[i];
     }
 }
 
+void tableau_R(tableau_t* tab, const size_t targ)
+{
+    __inline_tableau_single_qubit_dispatch(tab, targ, SINGLE_QUBIT_KERNELS[_R_ & INSTRUCTION_OPERATOR_MASK], false);
+}
+
 
 void tableau_I(tableau_t* tab, const size_t targ)
 {
     return;
 }
 
-void tableau_X(tableau_t* tab, const size_t targ)
+static
+void tableau_X_range(
+    CHUNK_OBJ* restrict slice_x,
+    CHUNK_OBJ* restrict slice_z,
+    CHUNK_OBJ* restrict slice_r,
+    const size_t start,
+    const size_t end)
 {
-    CHUNK_OBJ* slice_z = (CHUNK_OBJ*)(tab->slices_z[targ]); 
-    CHUNK_OBJ* slice_r = (CHUNK_OBJ*)(tab->phases); 
-/*
- * HZH Gate
- * Flip X and Z, perform a Z, then flip X and Z again
- * H : (r ^= x.z; x <-> z) 
- * Z : (r ^= x)
- * 
- * H
- * r_1 = r_0 ^ x0.z0; x1 = z0; z1 = x0  
- * 
- * Z
- * r_2 = r_1 ^ x1; x2 = x1; z2 = z1  
- * r_2 = r_0 ^ x0.z0 ^ z0; x2 = z0; z2 = x0  
- *
- * H
- * r_3 = r_0 ^ x0.z0 ^ z0 ^ z2.x2; x3 = z2; z3 = x2  
- * r_3 = r_0 ^ x0.z0 ^ z0 ^ z0.x0; x3 = x0; z3 = z0  
- * r_3 = r_0 ^ z0;
- *
- */
-    size_t i;
-    #pragma omp parallel private(i) 
+    /*
+     * HZH Gate
+     * Flip X and Z, perform a Z, then flip X and Z again
+     * H : (r ^= x.z; x <-> z) 
+     * Z : (r ^= x)
+     * 
+     * H
+     * r_1 = r_0 ^ x0.z0; x1 = z0; z1 = x0  
+     * 
+     * Z
+     * r_2 = r_1 ^ x1; x2 = x1; z2 = z1  
+     * r_2 = r_0 ^ x0.z0 ^ z0; x2 = z0; z2 = x0  
+     *
+     * H
+     * r_3 = r_0 ^ x0.z0 ^ z0 ^ z2.x2; x3 = z2; z3 = x2  
+     * r_3 = r_0 ^ x0.z0 ^ z0 ^ z0.x0; x3 = x0; z3 = z0  
+     * r_3 = r_0 ^ z0;
+     *
+     */
+
+    #pragma omp simd
+    TABLEAU_FOR_EACH_CHUNK(i, start, end)
     {
-        #pragma omp for simd
-        for (i = 0; i < tab->slice_len; i++)
-        {
-            __atomic_fetch_xor(slice_r + i, slice_z[i], __ATOMIC_RELAXED);      
-        }
+        slice_r[i] ^= slice_z[i];
     }
 }
 
-void tableau_Y(tableau_t* tab, const size_t targ)
+void tableau_X(tableau_t* tab, const size_t targ)
 {
-    CHUNK_OBJ* slice_x = (CHUNK_OBJ*)(tab->slices_x[targ]); 
-    CHUNK_OBJ* slice_z = (CHUNK_OBJ*)(tab->slices_z[targ]); 
-    CHUNK_OBJ* slice_r = (CHUNK_OBJ*)(tab->phases); 
+    __inline_tableau_single_qubit_dispatch(tab, targ, SINGLE_QUBIT_KERNELS[_X_ & INSTRUCTION_OPERATOR_MASK], false);
+}
 
+static
+void tableau_Y_range(
+    CHUNK_OBJ* restrict slice_x,
+    CHUNK_OBJ* restrict slice_z,
+    CHUNK_OBJ* restrict slice_r,
+    const size_t start,
+    const size_t end)
+{
     /*
      * Y = XZ
      * Z : (r ^= x)
@@ -295,23 +1751,27 @@ void tableau_Y(tableau_t* tab, const size_t targ)
      *
      * Y : r ^= x ^ z
      */
-    size_t i;
-    #pragma omp parallel private(i)
-    { 
-        #pragma omp for simd
-        for (i = 0; i < tab->slice_len; i++)
-        {
-            __atomic_fetch_xor(slice_r + i, slice_z[i] ^ slice_x[i], __ATOMIC_RELAXED);      
-        }  
+
+    #pragma omp simd
+    TABLEAU_FOR_EACH_CHUNK(i, start, end)
+    {
+        slice_r[i] ^= slice_z[i] ^ slice_x[i];
     }
 }
 
-void tableau_HX(tableau_t* tab, const size_t targ)
+void tableau_Y(tableau_t* tab, const size_t targ)
 {
-    CHUNK_OBJ* slice_x = (CHUNK_OBJ*)(tab->slices_x[targ]); 
-    CHUNK_OBJ* slice_z = (CHUNK_OBJ*)(tab->slices_z[targ]); 
-    CHUNK_OBJ* slice_r = (CHUNK_OBJ*)(tab->phases); 
+    __inline_tableau_single_qubit_dispatch(tab, targ, SINGLE_QUBIT_KERNELS[_Y_ & INSTRUCTION_OPERATOR_MASK], false);
+}
 
+static
+void tableau_HX_range(
+    CHUNK_OBJ* restrict slice_x,
+    CHUNK_OBJ* restrict slice_z,
+    CHUNK_OBJ* restrict slice_r,
+    const size_t start,
+    const size_t end)
+{
     /*
      * X : (r ^= z)
      * H : (r ^= x.z; x <-> z) 
@@ -322,25 +1782,27 @@ void tableau_HX(tableau_t* tab, const size_t targ)
      * r_2 = r_0 ^ (~x & z) 
      * Swap x and z
      */
-    size_t i;
-    #pragma omp parallel private(i)
-    { 
-        #pragma omp for simd
-        for (i = 0; i < tab->slice_len; i++)
-        {
-            __atomic_fetch_xor(slice_r + i, ~slice_x[i] & slice_z[i], __ATOMIC_RELAXED);      
-        }  
+
+    #pragma omp simd
+    TABLEAU_FOR_EACH_CHUNK(i, start, end)
+    {
+        slice_r[i] ^= ~slice_x[i] & slice_z[i];
     }
-    void* ptr = tab->slices_x[targ];
-    tab->slices_x[targ] = tab->slices_z[targ];
-    tab->slices_z[targ] = ptr;
 }
 
-void tableau_SX(tableau_t* tab, const size_t targ)
+void tableau_HX(tableau_t* tab, const size_t targ)
+{
+    __inline_tableau_single_qubit_dispatch(tab, targ, SINGLE_QUBIT_KERNELS[_HX_ & INSTRUCTION_OPERATOR_MASK], true);
+}
+
+static
+void tableau_SX_range(
+    CHUNK_OBJ* restrict slice_x,
+    CHUNK_OBJ* restrict slice_z,
+    CHUNK_OBJ* restrict slice_r,
+    const size_t start,
+    const size_t end)
 {
-    CHUNK_OBJ* slice_x = (CHUNK_OBJ*)(tab->slices_x[targ]); 
-    CHUNK_OBJ* slice_z = (CHUNK_OBJ*)(tab->slices_z[targ]); 
-    CHUNK_OBJ* slice_r = (CHUNK_OBJ*)(tab->phases); 
     /*
      * X : (r ^= z)
      * S : (r ^= x.z; z ^= x)
@@ -352,25 +1814,29 @@ void tableau_SX(tableau_t* tab, const size_t targ)
      * z_2 = z_0 ^ x
      */
 
-    size_t i;
-    #pragma omp parallel private(i)
-    { 
-        #pragma omp for simd
-        for (i = 0; i < tab->slice_len; i++)
-        {
-            __atomic_fetch_xor(slice_r + i, ~slice_x[i] & slice_z[i], __ATOMIC_RELAXED);      
-            slice_z[i] ^= slice_x[i]; 
-        }  
+    #pragma omp simd
+    TABLEAU_FOR_EACH_CHUNK(i, start, end)
+    {
+        slice_r[i] ^= ~slice_x[i] & slice_z[i];
+        slice_z[i] ^= slice_x[i];
     }
 }
 
+void tableau_SX(tableau_t* tab, const size_t targ)
+{
+    __inline_tableau_single_qubit_dispatch(tab, targ, SINGLE_QUBIT_KERNELS[_SX_ & INSTRUCTION_OPERATOR_MASK], false);
+}
+
 
 
-void tableau_RX(tableau_t* tab, const size_t targ)
+static
+void tableau_RX_range(
+    CHUNK_OBJ* restrict slice_x,
+    CHUNK_OBJ* restrict slice_z,
+    CHUNK_OBJ* restrict slice_r,
+    const size_t start,
+    const size_t end)
 {
-    CHUNK_OBJ* slice_x = (CHUNK_OBJ*)(tab->slices_x[targ]); 
-    CHUNK_OBJ* slice_z = (CHUNK_OBJ*)(tab->slices_z[targ]); 
-    CHUNK_OBJ* slice_r = (CHUNK_OBJ*)(tab->phases); 
     /*
      * X : (r ^= z)
      * R : (r ^= x.~z; z ^= x)
@@ -382,23 +1848,27 @@ void tableau_RX(tableau_t* tab, const size_t targ)
      * z_2 = z_0 ^ x
      */
 
-    size_t i;
-    #pragma omp parallel private(i)
-    { 
-        #pragma omp for simd
-        for (i = 0; i < tab->slice_len; i++)
-        {
-            __atomic_fetch_xor(slice_r + i, slice_x[i] | slice_z[i], __ATOMIC_RELAXED);      
-            slice_z[i] ^= slice_x[i]; 
-        }  
+    #pragma omp simd
+    TABLEAU_FOR_EACH_CHUNK(i, start, end)
+    {
+        slice_r[i] ^= slice_x[i] | slice_z[i];
+        slice_z[i] ^= slice_x[i];
     }
 }
 
-void tableau_HZ(tableau_t* tab, const size_t targ)
+void tableau_RX(tableau_t* tab, const size_t targ)
+{
+    __inline_tableau_single_qubit_dispatch(tab, targ, SINGLE_QUBIT_KERNELS[_RX_ & INSTRUCTION_OPERATOR_MASK], false);
+}
+
+static
+void tableau_HZ_range(
+    CHUNK_OBJ* restrict slice_x,
+    CHUNK_OBJ* restrict slice_z,
+    CHUNK_OBJ* restrict slice_r,
+    const size_t start,
+    const size_t end)
 {
-    CHUNK_OBJ* slice_x = (CHUNK_OBJ*)(tab->slices_x[targ]); 
-    CHUNK_OBJ* slice_z = (CHUNK_OBJ*)(tab->slices_z[targ]); 
-    CHUNK_OBJ* slice_r = (CHUNK_OBJ*)(tab->phases); 
     /*
      * Z : (r ^= x)
      * H : (r ^= x.z; x <-> z) 
@@ -411,27 +1881,28 @@ void tableau_HZ(tableau_t* tab, const size_t targ)
      * x_2 = z_0
      */
 
-    size_t i;
-    #pragma omp parallel private(i)
-    { 
-        #pragma omp for simd
-        for (i = 0; i < tab->slice_len; i++)
-        {
-            __atomic_fetch_xor(slice_r + i, ~slice_z[i] & slice_x[i], __ATOMIC_RELAXED);      
-        }  
+    #pragma omp simd
+    TABLEAU_FOR_EACH_CHUNK(i, start, end)
+    {
+        slice_r[i] ^= ~slice_z[i] & slice_x[i];
     }
-    void* ptr = tab->slices_x[targ];
-    tab->slices_x[targ] = tab->slices_z[targ];
-    tab->slices_z[targ] = ptr;
+}
+
+void tableau_HZ(tableau_t* tab, const size_t targ)
+{
+    __inline_tableau_single_qubit_dispatch(tab, targ, SINGLE_QUBIT_KERNELS[_HZ_ & INSTRUCTION_OPERATOR_MASK], true);
 }
 
 
 
-void tableau_HY(tableau_t* tab, const size_t targ)
+static
+void tableau_HY_range(
+    CHUNK_OBJ* restrict slice_x,
+    CHUNK_OBJ* restrict slice_z,
+    CHUNK_OBJ* restrict slice_r,
+    const size_t start,
+    const size_t end)
 {
-    CHUNK_OBJ* slice_x = (CHUNK_OBJ*)(tab->slices_x[targ]); 
-    CHUNK_OBJ* slice_z = (CHUNK_OBJ*)(tab->slices_z[targ]); 
-    CHUNK_OBJ* slice_r = (CHUNK_OBJ*)(tab->phases); 
     /*
      * Y : r ^= x ^ z
      * H : (r ^= x.z; x <-> z) 
@@ -444,25 +1915,27 @@ void tableau_HY(tableau_t* tab, const size_t targ)
      * x_2 = z_0
      */
 
-    size_t i;
-    #pragma omp parallel private(i)
-    { 
-        #pragma omp for simd
-        for (i = 0; i < tab->slice_len; i++)
-        {
-            __atomic_fetch_xor(slice_r + i, slice_z[i] ^ slice_x[i], __ATOMIC_RELAXED);      
-        }  
+    #pragma omp simd
+    TABLEAU_FOR_EACH_CHUNK(i, start, end)
+    {
+        slice_r[i] ^= slice_z[i] | slice_x[i];
     }
-    void* ptr = tab->slices_x[targ];
-    tab->slices_x[targ] = tab->slices_z[targ];
-    tab->slices_z[targ] = ptr;
+}
+
+void tableau_HY(tableau_t* tab, const size_t targ)
+{
+    __inline_tableau_single_qubit_dispatch(tab, targ, SINGLE_QUBIT_KERNELS[_HY_ & INSTRUCTION_OPERATOR_MASK], true);
 }
 
 
-void tableau_SH(tableau_t* tab, const size_t targ)
+static
+void tableau_SH_range(
+    CHUNK_OBJ* restrict slice_x,
+    CHUNK_OBJ* restrict slice_z,
+    CHUNK_OBJ* restrict slice_r,
+    const size_t start,
+    const size_t end)
 {
-    CHUNK_OBJ* slice_x = (CHUNK_OBJ*)(tab->slices_x[targ]); 
-    CHUNK_OBJ* slice_z = (CHUNK_OBJ*)(tab->slices_z[targ]); 
     /*
      * H : (r ^= x.z; x <-> z) 
      * S : (r ^= x.z; z ^= x)
@@ -478,27 +1951,27 @@ void tableau_SH(tableau_t* tab, const size_t targ)
      * 
      */
 
-    size_t i;
-    #pragma omp parallel private(i)
-    { 
-        #pragma omp for simd
-        for (i = 0; i < tab->slice_len; i++)
-        {
-            slice_x[i] ^= slice_z[i];
-        }  
+    #pragma omp simd
+    TABLEAU_FOR_EACH_CHUNK(i, start, end)
+    {
+        slice_x[i] ^= slice_z[i];
     }
-    void* ptr = tab->slices_x[targ];
-    tab->slices_x[targ] = tab->slices_z[targ];
-    tab->slices_z[targ] = ptr;
 }
 
-
-void tableau_RH(tableau_t* tab, const size_t targ)
+void tableau_SH(tableau_t* tab, const size_t targ)
 {
-    CHUNK_OBJ* slice_x = (CHUNK_OBJ*)(tab->slices_x[targ]); 
-    CHUNK_OBJ* slice_z = (CHUNK_OBJ*)(tab->slices_z[targ]); 
-    CHUNK_OBJ* slice_r = (CHUNK_OBJ*)(tab->phases); 
+    __inline_tableau_single_qubit_dispatch(tab, targ, SINGLE_QUBIT_KERNELS[_SH_ & INSTRUCTION_OPERATOR_MASK], true);
+}
+
 
+static
+void tableau_RH_range(
+    CHUNK_OBJ* restrict slice_x,
+    CHUNK_OBJ* restrict slice_z,
+    CHUNK_OBJ* restrict slice_r,
+    const size_t start,
+    const size_t end)
+{
     /*
      * H : (r ^= x.z; x <-> z) 
      * R : (r ^= x.~z; z ^= x)
@@ -514,26 +1987,28 @@ void tableau_RH(tableau_t* tab, const size_t targ)
      *
      */
 
-    size_t i;
-    #pragma omp parallel private(i)
-    { 
-        #pragma omp for simd
-        for (i = 0; i < tab->slice_len; i++)
-        {
-            __atomic_fetch_xor(slice_r + i, slice_z[i], __ATOMIC_RELAXED);
-            slice_x[i] ^= slice_z[i];
-        }  
+    #pragma omp simd
+    TABLEAU_FOR_EACH_CHUNK(i, start, end)
+    {
+        slice_r[i] ^= slice_z[i];
+        slice_x[i] ^= slice_z[i];
     }
-    void* ptr = tab->slices_x[targ];
-    tab->slices_x[targ] = tab->slices_z[targ];
-    tab->slices_z[targ] = ptr;
+}
+
+void tableau_RH(tableau_t* tab, const size_t targ)
+{
+    __inline_tableau_single_qubit_dispatch(tab, targ, SINGLE_QUBIT_KERNELS[_RH_ & INSTRUCTION_OPERATOR_MASK], true);
 }
 
 
-void tableau_HS(tableau_t* tab, const size_t targ)
+static
+void tableau_HS_range(
+    CHUNK_OBJ* restrict slice_x,
+    CHUNK_OBJ* restrict slice_z,
+    CHUNK_OBJ* restrict slice_r,
+    const size_t start,
+    const size_t end)
 {
-    CHUNK_OBJ* slice_x = (CHUNK_OBJ*)(tab->slices_x[targ]); 
-    CHUNK_OBJ* slice_z = (CHUNK_OBJ*)(tab->slices_z[targ]); 
     /*
      * S : (r ^= x.z; z ^= x)
      * H : (r ^= x.z; x <-> z) 
@@ -543,29 +2018,33 @@ void tableau_HS(tableau_t* tab, const size_t targ)
      *
      * r_2 = r_1 ^ x.z_1
      * r_2 = r_0 ^ x.z_0 ^ x.(z_0 ^ x)
+     * r_2 = r_0 ^ x
      * z_2 = x_1
      * x_2 = z_1
      *
      */
 
-    size_t i;
-    #pragma omp parallel private(i)
-    { 
-        #pragma omp for simd
-        for (i = 0; i < tab->slice_len; i++)
-        {
-            slice_x[i] ^= slice_z[i];
-        }  
+    #pragma omp simd
+    TABLEAU_FOR_EACH_CHUNK(i, start, end)
+    {
+        slice_r[i] ^= slice_x[i];
+        slice_z[i] ^= slice_x[i];
     }
-    void* ptr = tab->slices_x[targ];
-    tab->slices_x[targ] = tab->slices_z[targ];
-    tab->slices_z[targ] = ptr;
 }
 
-void tableau_HR(tableau_t* tab, const size_t targ)
+void tableau_HS(tableau_t* tab, const size_t targ)
+{
+    __inline_tableau_single_qubit_dispatch(tab, targ, SINGLE_QUBIT_KERNELS[_HS_ & INSTRUCTION_OPERATOR_MASK], true);
+}
+
+static
+void tableau_HR_range(
+    CHUNK_OBJ* restrict slice_x,
+    CHUNK_OBJ* restrict slice_z,
+    CHUNK_OBJ* restrict slice_r,
+    const size_t start,
+    const size_t end)
 {
-    CHUNK_OBJ* slice_x = (CHUNK_OBJ*)(tab->slices_x[targ]); 
-    CHUNK_OBJ* slice_z = (CHUNK_OBJ*)(tab->slices_z[targ]); 
     /*
      * R : (r ^= x.~z; z ^= x)
      * H : (r ^= x.z; x <-> z) 
@@ -581,26 +2060,26 @@ void tableau_HR(tableau_t* tab, const size_t targ)
      *
      */
 
-    size_t i; 
-    #pragma omp parallel private(i)
-    { 
-        #pragma omp for simd
-        for (i = 0; i < tab->slice_len; i++)
-        {
-            slice_z[i] ^= slice_x[i];
-        }  
+    #pragma omp simd
+    TABLEAU_FOR_EACH_CHUNK(i, start, end)
+    {
+        slice_z[i] ^= slice_x[i];
     }
-    void* ptr = tab->slices_x[targ];
-    tab->slices_x[targ] = tab->slices_z[targ];
-    tab->slices_z[targ] = ptr;
 }
 
-void tableau_HSX(tableau_t* tab, const size_t targ)
+void tableau_HR(tableau_t* tab, const size_t targ)
 {
-    CHUNK_OBJ* slice_x = (CHUNK_OBJ*)(tab->slices_x[targ]); 
-    CHUNK_OBJ* slice_z = (CHUNK_OBJ*)(tab->slices_z[targ]); 
-    CHUNK_OBJ* slice_r = (CHUNK_OBJ*)(tab->phases); 
+    __inline_tableau_single_qubit_dispatch(tab, targ, SINGLE_QUBIT_KERNELS[_HR_ & INSTRUCTION_OPERATOR_MASK], true);
+}
 
+static
+void tableau_HSX_range(
+    CHUNK_OBJ* restrict slice_x,
+    CHUNK_OBJ* restrict slice_z,
+    CHUNK_OBJ* restrict slice_r,
+    const size_t start,
+    const size_t end)
+{
     /*
      * X : (r ^= z)
      * S : (r ^= x.z; z ^= x)
@@ -620,27 +2099,27 @@ void tableau_HSX(tableau_t* tab, const size_t targ)
      * z_3 = x_2 = x_0
      */
 
-    size_t i;
-    #pragma omp parallel private(i)
-    { 
-        #pragma omp for simd
-        for (i = 0; i < tab->slice_len; i++)
-        {
-            __atomic_fetch_xor(slice_r + i, slice_x[i] ^ slice_z[i], __ATOMIC_RELAXED);
-            slice_z[i] ^= slice_x[i];
-        }  
+    #pragma omp simd
+    TABLEAU_FOR_EACH_CHUNK(i, start, end)
+    {
+        slice_r[i] ^= slice_x[i] ^ slice_z[i];
+        slice_z[i] ^= slice_x[i];
     }
-    void* ptr = tab->slices_x[targ];
-    tab->slices_x[targ] = tab->slices_z[targ];
-    tab->slices_z[targ] = ptr;
 }
 
-void tableau_HRX(tableau_t* tab, const size_t targ)
+void tableau_HSX(tableau_t* tab, const size_t targ)
 {
-    CHUNK_OBJ* slice_x = (CHUNK_OBJ*)(tab->slices_x[targ]); 
-    CHUNK_OBJ* slice_z = (CHUNK_OBJ*)(tab->slices_z[targ]); 
-    CHUNK_OBJ* slice_r = (CHUNK_OBJ*)(tab->phases); 
+    __inline_tableau_single_qubit_dispatch(tab, targ, SINGLE_QUBIT_KERNELS[_HSX_ & INSTRUCTION_OPERATOR_MASK], true);
+}
 
+static
+void tableau_HRX_range(
+    CHUNK_OBJ* restrict slice_x,
+    CHUNK_OBJ* restrict slice_z,
+    CHUNK_OBJ* restrict slice_r,
+    const size_t start,
+    const size_t end)
+{
     /*
      * X : (r ^= z)
      * R : (r ^= x.~z; z ^= x)
@@ -660,138 +2139,156 @@ void tableau_HRX(tableau_t* tab, const size_t targ)
      * z_3 = x_2 = x_0
      */
 
-    size_t i;
-    #pragma omp parallel private(i)
-    { 
-        #pragma omp for simd
-        for (i = 0; i < tab->slice_len; i++)
-        {
-            __atomic_fetch_xor(slice_r + i, slice_z[i], __ATOMIC_RELAXED);
-            slice_z[i] ^= slice_x[i];
-        }  
+    #pragma omp simd
+    TABLEAU_FOR_EACH_CHUNK(i, start, end)
+    {
+        slice_r[i] ^= slice_z[i];
+        slice_z[i] ^= slice_x[i];
+    }
+}
+
+void tableau_HRX(tableau_t* tab, const size_t targ)
+{
+    __inline_tableau_single_qubit_dispatch(tab, targ, SINGLE_QUBIT_KERNELS[_HRX_ & INSTRUCTION_OPERATOR_MASK], true);
+}
+
+static
+void tableau_SHY_range(
+    CHUNK_OBJ* restrict slice_x,
+    CHUNK_OBJ* restrict slice_z,
+    CHUNK_OBJ* restrict slice_r,
+    const size_t start,
+    const size_t end)
+{
+    #pragma omp simd
+    TABLEAU_FOR_EACH_CHUNK(i, start, end)
+    {
+        slice_r[i] ^= slice_z[i] ^ slice_x[i];
+        slice_x[i] ^= slice_z[i];
     }
-    void* ptr = tab->slices_x[targ];
-    tab->slices_x[targ] = tab->slices_z[targ];
-    tab->slices_z[targ] = ptr;
 }
 
 void tableau_SHY(tableau_t* tab, const size_t targ)
 {
-    CHUNK_OBJ* slice_x = (CHUNK_OBJ*)(tab->slices_x[targ]); 
-    CHUNK_OBJ* slice_z = (CHUNK_OBJ*)(tab->slices_z[targ]); 
-    CHUNK_OBJ* slice_r = (CHUNK_OBJ*)(tab->phases); 
+    __inline_tableau_single_qubit_dispatch(tab, targ, SINGLE_QUBIT_KERNELS[_SHY_ & INSTRUCTION_OPERATOR_MASK], true);
+}
 
-    size_t i;
-    #pragma omp parallel private(i)
-    { 
-        #pragma omp for simd
-        for (i = 0; i < tab->slice_len; i++)
-        {
-            __atomic_fetch_xor(slice_r + i, slice_z[i] ^ slice_x[i], __ATOMIC_RELAXED);
-            slice_x[i] ^= slice_z[i];
-        }  
+static
+void tableau_RHY_range(
+    CHUNK_OBJ* restrict slice_x,
+    CHUNK_OBJ* restrict slice_z,
+    CHUNK_OBJ* restrict slice_r,
+    const size_t start,
+    const size_t end)
+{
+    #pragma omp simd
+    TABLEAU_FOR_EACH_CHUNK(i, start, end)
+    {
+        slice_r[i] ^= slice_x[i];
+        slice_x[i] ^= slice_z[i];
     }
-    void* ptr = tab->slices_x[targ];
-    tab->slices_x[targ] = tab->slices_z[targ];
-    tab->slices_z[targ] = ptr;
 }
 
 void tableau_RHY(tableau_t* tab, const size_t targ)
 {
-    CHUNK_OBJ* slice_x = (CHUNK_OBJ*)(tab->slices_x[targ]); 
-    CHUNK_OBJ* slice_z = (CHUNK_OBJ*)(tab->slices_z[targ]); 
-    CHUNK_OBJ* slice_r = (CHUNK_OBJ*)(tab->phases); 
+    __inline_tableau_single_qubit_dispatch(tab, targ, SINGLE_QUBIT_KERNELS[_RHY_ & INSTRUCTION_OPERATOR_MASK], true);
+}
 
-    size_t i;
-    #pragma omp parallel private(i)
-    { 
-        #pragma omp for simd
-        for (i = 0; i < tab->slice_len; i++)
-        {
-            __atomic_fetch_xor(slice_r + i, slice_x[i], __ATOMIC_RELAXED);
-            slice_x[i] ^= slice_z[i];
-        }  
+static
+void tableau_HSH_range(
+    CHUNK_OBJ* restrict slice_x,
+    CHUNK_OBJ* restrict slice_z,
+    CHUNK_OBJ* restrict slice_r,
+    const size_t start,
+    const size_t end)
+{
+    #pragma omp simd
+    TABLEAU_FOR_EACH_CHUNK(i, start, end)
+    {
+        slice_r[i] ^= ~slice_x[i] & slice_z[i];
+        slice_x[i] ^= slice_z[i];
     }
-    void* ptr = tab->slices_x[targ];
-    tab->slices_x[targ] = tab->slices_z[targ];
-    tab->slices_z[targ] = ptr;
 }
 
 void tableau_HSH(tableau_t* tab, const size_t targ)
 {
-    CHUNK_OBJ* slice_x = (CHUNK_OBJ*)(tab->slices_x[targ]); 
-    CHUNK_OBJ* slice_z = (CHUNK_OBJ*)(tab->slices_z[targ]); 
-    CHUNK_OBJ* slice_r = (CHUNK_OBJ*)(tab->phases); 
+    __inline_tableau_single_qubit_dispatch(tab, targ, SINGLE_QUBIT_KERNELS[_HSH_ & INSTRUCTION_OPERATOR_MASK], false);
+}
 
-    size_t i;
-    #pragma omp parallel private(i)
-    { 
-        #pragma omp for simd
-        for (i = 0; i < tab->slice_len; i++)
-        {
-            __atomic_fetch_xor(slice_r + i, ~slice_x[i] & slice_z[i], __ATOMIC_RELAXED);
-            slice_x[i] ^= slice_z[i];
-        }  
+static
+void tableau_HRH_range(
+    CHUNK_OBJ* restrict slice_x,
+    CHUNK_OBJ* restrict slice_z,
+    CHUNK_OBJ* restrict slice_r,
+    const size_t start,
+    const size_t end)
+{
+    #pragma omp simd
+    TABLEAU_FOR_EACH_CHUNK(i, start, end)
+    {
+        slice_r[i] ^= slice_x[i] & slice_z[i];
+        slice_x[i] ^= slice_z[i];
     }
 }
 
 void tableau_HRH(tableau_t* tab, const size_t targ)
 {
-    CHUNK_OBJ* slice_x = (CHUNK_OBJ*)(tab->slices_x[targ]); 
-    CHUNK_OBJ* slice_z = (CHUNK_OBJ*)(tab->slices_z[targ]); 
-    CHUNK_OBJ* slice_r = (CHUNK_OBJ*)(tab->phases); 
+    __inline_tableau_single_qubit_dispatch(tab, targ, SINGLE_QUBIT_KERNELS[_HRH_ & INSTRUCTION_OPERATOR_MASK], false);
+}
 
-    size_t i;
-    #pragma omp parallel private(i)
-    { 
-        #pragma omp for simd
-        for (i = 0; i < tab->slice_len; i++)
-        {
-            __atomic_fetch_xor(slice_r + i, slice_x[i] & slice_z[i], __ATOMIC_RELAXED);
-            slice_x[i] ^= slice_z[i];
-        }  
+
+static
+void tableau_RHS_range(
+    CHUNK_OBJ* restrict slice_x,
+    CHUNK_OBJ* restrict slice_z,
+    CHUNK_OBJ* restrict slice_r,
+    const size_t start,
+    const size_t end)
+{
+    #pragma omp simd
+    TABLEAU_FOR_EACH_CHUNK(i, start, end)
+    {
+        slice_r[i] ^= slice_x[i] | slice_z[i];
+        slice_x[i] ^= slice_z[i];
     }
 }
 
-
 void tableau_RHS(tableau_t* tab, const size_t targ)
 {
-    CHUNK_OBJ* slice_x = (CHUNK_OBJ*)(tab->slices_x[targ]); 
-    CHUNK_OBJ* slice_z = (CHUNK_OBJ*)(tab->slices_z[targ]); 
-    CHUNK_OBJ* slice_r = (CHUNK_OBJ*)(tab->phases); 
+    __inline_tableau_single_qubit_dispatch(tab, targ, SINGLE_QUBIT_KERNELS[_RHS_ & INSTRUCTION_OPERATOR_MASK], false);
+}
 
-    size_t i;
-    #pragma omp parallel private(i)
-    { 
-        #pragma omp for simd
-        for (i = 0; i < tab->slice_len; i++)
-        {
-            __atomic_fetch_xor(slice_r + i, slice_x[i] | slice_z[i], __ATOMIC_RELAXED);
-            slice_x[i] ^= slice_z[i];
-        }  
+
+static
+void tableau_SHR_range(
+    CHUNK_OBJ* restrict slice_x,
+    CHUNK_OBJ* restrict slice_z,
+    CHUNK_OBJ* restrict slice_r,
+    const size_t start,
+    const size_t end)
+{
+    #pragma omp simd
+    TABLEAU_FOR_EACH_CHUNK(i, start, end)
+    {
+        slice_r[i] ^= slice_x[i] & ~slice_z[i];
+        slice_x[i] ^= slice_z[i];
     }
 }
 
-
 void tableau_SHR(tableau_t* tab, const size_t targ)
 {
-    CHUNK_OBJ* slice_x = (CHUNK_OBJ*)(tab->slices_x[targ]); 
-    CHUNK_OBJ* slice_z = (CHUNK_OBJ*)(tab->slices_z[targ]); 
-    CHUNK_OBJ* slice_r = (CHUNK_OBJ*)(tab->phases); 
-
-    size_t i;
-    #pragma omp parallel private(i)
-    { 
-        #pragma omp for simd
-        for (i = 0; i < tab->slice_len; i++)
-        {
-            __atomic_fetch_xor(slice_r + i, slice_x[i] & ~slice_z[i], __ATOMIC_RELAXED);
-            slice_x[i] ^= slice_z[i];
-        }  
-    }
+    __inline_tableau_single_qubit_dispatch(tab, targ, SINGLE_QUBIT_KERNELS[_SHR_ & INSTRUCTION_OPERATOR_MASK], false);
 }
 
-void tableau_CNOT(tableau_t* tab, const size_t ctrl, const size_t targ)
+static
+void tableau_CNOT_range(
+    CHUNK_OBJ* restrict ctrl_slice_x,
+    CHUNK_OBJ* restrict ctrl_slice_z,
+    CHUNK_OBJ* restrict targ_slice_x,
+    CHUNK_OBJ* restrict targ_slice_z,
+    CHUNK_OBJ* restrict slice_r,
+    const size_t start,
+    const size_t end)
 {
     /*
      * CNOT a, b: ( 
@@ -799,32 +2296,31 @@ void tableau_CNOT(tableau_t* tab, const size_t ctrl, const size_t targ)
      *     x_b ^= x_a;
      *     z_a ^= z_b) 
      *
-     */ 
-
-    CHUNK_OBJ* ctrl_slice_x = (CHUNK_OBJ*)(tab->slices_x[ctrl]); 
-    CHUNK_OBJ* ctrl_slice_z = (CHUNK_OBJ*)(tab->slices_z[ctrl]); 
-    CHUNK_OBJ* targ_slice_x = (CHUNK_OBJ*)(tab->slices_x[targ]); 
-    CHUNK_OBJ* targ_slice_z = (CHUNK_OBJ*)(tab->slices_z[targ]); 
-    CHUNK_OBJ* slice_r = (CHUNK_OBJ*)(tab->phases); 
+     */
 
-    size_t i;
-    #pragma omp parallel private(i)
-    { 
-        #pragma omp for simd
-        for (i = 0; i < tab->slice_len; i++)
-        {
-            __atomic_fetch_xor(
-                slice_r + i,
-                (ctrl_slice_x[i] & targ_slice_z[i] & ~(targ_slice_x[i] ^ ctrl_slice_z[i])),
-                 __ATOMIC_RELAXED
-            );
-            targ_slice_x[i] ^= ctrl_slice_x[i];
-            ctrl_slice_z[i] ^= targ_slice_z[i];
-        }  
+    #pragma omp simd
+    TABLEAU_FOR_EACH_CHUNK(i, start, end)
+    {
+        slice_r[i] ^= (ctrl_slice_x[i] & targ_slice_z[i] & ~(targ_slice_x[i] ^ ctrl_slice_z[i]));
+        targ_slice_x[i] ^= ctrl_slice_x[i];
+        ctrl_slice_z[i] ^= targ_slice_z[i];
     }
 }
 
-void tableau_CZ(tableau_t* tab, const size_t ctrl, const size_t targ)
+void tableau_CNOT(tableau_t* tab, const size_t ctrl, const size_t targ)
+{
+    __inline_tableau_two_qubit_dispatch(tab, ctrl, targ, TWO_QUBIT_KERNELS[_CNOT_ & INSTRUCTION_OPERATOR_MASK]);
+}
+
+static
+void tableau_CZ_range(
+    CHUNK_OBJ* restrict ctrl_slice_x,
+    CHUNK_OBJ* restrict ctrl_slice_z,
+    CHUNK_OBJ* restrict targ_slice_x,
+    CHUNK_OBJ* restrict targ_slice_z,
+    CHUNK_OBJ* restrict slice_r,
+    const size_t start,
+    const size_t end)
 {
     /* CZ = H_b CNOT H_b 
      * H : (r ^= x.z; x <-> z) 
@@ -860,27 +2356,193 @@ void tableau_CZ(tableau_t* tab, const size_t ctrl, const size_t targ)
      * z_a3 = z_a2 = z_a0 ^ x_b0 
      * z_b3 = x_b2 = z_b0 ^ x_a0 
      *
-     */ 
+     */
 
-    CHUNK_OBJ* ctrl_slice_x = (CHUNK_OBJ*)(tab->slices_x[ctrl]); 
-    CHUNK_OBJ* ctrl_slice_z = (CHUNK_OBJ*)(tab->slices_z[ctrl]); 
-    CHUNK_OBJ* targ_slice_x = (CHUNK_OBJ*)(tab->slices_x[targ]); 
-    CHUNK_OBJ* targ_slice_z = (CHUNK_OBJ*)(tab->slices_z[targ]); 
-    CHUNK_OBJ* slice_r = (CHUNK_OBJ*)(tab->phases); 
+    #pragma omp simd
+    TABLEAU_FOR_EACH_CHUNK(i, start, end)
+    {
+        slice_r[i] ^= (
+            (ctrl_slice_x[i] & targ_slice_x[i] & ctrl_slice_z[i]) 
+            ^ (ctrl_slice_x[i] & targ_slice_x[i] & targ_slice_z[i]) 
+        );
+        targ_slice_z[i] ^= ctrl_slice_x[i];
+        ctrl_slice_z[i] ^= targ_slice_x[i];
+    }
+}
 
-    size_t i;
-    // TODO the compiler isn't able to avx this section of code itself, CNOT appears to be near instant while CZ is non-trivial
-    #pragma omp parallel private(i)
-    { 
-        #pragma omp for simd
-        for (i = 0; i < tab->slice_len; i++)
+void tableau_CZ(tableau_t* tab, const size_t ctrl, const size_t targ)
+{
+    __inline_tableau_two_qubit_dispatch(tab, ctrl, targ, TWO_QUBIT_KERNELS[_CZ_ & INSTRUCTION_OPERATOR_MASK]);
+}
+
+
+/*
+ * Scalar chunk range kernels, indexed by the masked opcode
+ * Swapping kernels exchange the X and Z slice pointers once the kernel has been applied
+ */
+const tableau_kernel_t TABLEAU_SCALAR_SINGLE_QUBIT_KERNELS[N_LOCAL_CLIFFORDS] = {
+    NULL, // _I_
+    tableau_X_range,
+    tableau_Y_range,
+    tableau_Z_range,
+    tableau_H_range,
+    tableau_S_range,
+    tableau_R_range,
+    tableau_HX_range,
+    tableau_SX_range,
+    tableau_RX_range,
+    tableau_HY_range,
+    tableau_HZ_range,
+    tableau_SH_range,
+    tableau_RH_range,
+    tableau_HS_range,
+    tableau_HR_range,
+    tableau_HSX_range,
+    tableau_HRX_range,
+    tableau_SHY_range,
+    tableau_RHY_range,
+    tableau_HSH_range,
+    tableau_HRH_range,
+    tableau_RHS_range,
+    tableau_SHR_range};
+
+const tableau_two_qubit_kernel_t TABLEAU_SCALAR_TWO_QUBIT_KERNELS[N_NON_LOCAL_CLIFFORDS] = {
+    tableau_CNOT_range,
+    tableau_CZ_range};
+
+static const bool SINGLE_QUBIT_KERNEL_SWAPS[N_LOCAL_CLIFFORDS] = {
+    false, // _I_
+    false, // _X_
+    false, // _Y_
+    false, // _Z_
+    true, // _H_
+    false, // _S_
+    false, // _R_
+    true, // _HX_
+    false, // _SX_
+    false, // _RX_
+    true, // _HY_
+    true, // _HZ_
+    true, // _SH_
+    true, // _RH_
+    true, // _HS_
+    true, // _HR_
+    true, // _HSX_
+    true, // _HRX_
+    true, // _SHY_
+    true, // _RHY_
+    false, // _HSH_
+    false, // _HRH_
+    false, // _RHS_
+    false}; // _SHR_
+
+
+/*
+ * tableau_apply_local_cliffords
+ * Applies a local Clifford to each of the first n_qubits qubits
+ * :: tab : tableau_t* :: The tableau to operate on
+ * :: cliffords : const instruction_t* :: Local Clifford for each qubit 
+ * :: n_qubits : const size_t :: Number of qubits 
+ * Above the parallel threshold a single team is kept alive across all of the gates, with each 
+ * thread applying every gate to its own range of chunks
+ * Slice pointer swaps are deferred until the team has joined
+ */
+void tableau_apply_local_cliffords(tableau_t* tab, const instruction_t* cliffords, const size_t n_qubits)
+{
+    if (tab->active_len < tab->parallel_threshold)
+    {
+        for (size_t i = 0; i < n_qubits; i++)
+        {
+            SINGLE_QUBIT_OPERATIONS[cliffords[i] & INSTRUCTION_OPERATOR_MASK](tab, i);
+        }
+        return;
+    }
+
+    #pragma omp parallel
+    {
+        size_t start, end;
+        __inline_tableau_chunk_range(tab->active_len, omp_get_thread_num(), omp_get_num_threads(), &start, &end);
+        for (size_t i = 0; i < n_qubits; i++)
+        {
+            tableau_kernel_t kernel = SINGLE_QUBIT_KERNELS[cliffords[i] & INSTRUCTION_OPERATOR_MASK];
+            if (NULL != kernel)
+            {
+                kernel(tab->slices_x[i], tab->slices_z[i], tab->phases, start, end);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < n_qubits; i++)
+    {
+        if (SINGLE_QUBIT_KERNEL_SWAPS[cliffords[i] & INSTRUCTION_OPERATOR_MASK])
+        {
+            void* ptr = tab->slices_x[i];
+            tab->slices_x[i] = tab->slices_z[i];
+            tab->slices_z[i] = ptr;
+        }
+    }
+    return;
+}
+
+
+/*
+ * tableau_calibrate_parallel_threshold
+ * Measures the slice length at which a parallel kernel beats the serial kernel
+ * Times the S kernel over doubling slice lengths, both serially and split over the team
+ * Returns the first slice length in chunks at which the parallel version was faster, or 
+ * SIZE_MAX if it never was (for instance with a single thread)
+ */
+size_t tableau_calibrate_parallel_threshold(void)
+{
+    if (omp_get_max_threads() < 2)
+    {
+        return SIZE_MAX;
+    }
+
+    // Slices are strided in the tiled layout, keep the same memory footprint
+    const size_t max_len = (1ull << 20) / TABLEAU_CHUNK_STRIDE;
+    const size_t max_words = max_len * TABLEAU_CHUNK_STRIDE;
+    const size_t n_reps = 64;
+
+    CHUNK_OBJ* slices = NULL;
+    int err_code = posix_memalign((void**)&slices, CACHE_SIZE, 3 * max_words * sizeof(CHUNK_OBJ));
+    assert(0 == err_code);
+    memset(slices, 0x5a, 3 * max_words * sizeof(CHUNK_OBJ));
+
+    CHUNK_OBJ* slice_x = slices;
+    CHUNK_OBJ* slice_z = slices + max_words;
+    CHUNK_OBJ* slice_r = slices + 2 * max_words;
+
+    size_t threshold = SIZE_MAX;
+    for (size_t len = CACHE_CHUNKS; len <= max_len; len <<= 1)
+    {
+        double t_start = omp_get_wtime();
+        for (size_t rep = 0; rep < n_reps; rep++)
+        {
+            SINGLE_QUBIT_KERNELS[_S_ & INSTRUCTION_OPERATOR_MASK](slice_x, slice_z, slice_r, 0, len);
+        }
+        const double t_serial = omp_get_wtime() - t_start;
+
+        t_start = omp_get_wtime();
+        for (size_t rep = 0; rep < n_reps; rep++)
+        {
+            #pragma omp parallel
+            {
+                size_t start, end;
+                __inline_tableau_chunk_range(len, omp_get_thread_num(), omp_get_num_threads(), &start, &end);
+                SINGLE_QUBIT_KERNELS[_S_ & INSTRUCTION_OPERATOR_MASK](slice_x, slice_z, slice_r, start, end);
+            }
+        }
+        const double t_parallel = omp_get_wtime() - t_start;
+
+        DPRINT(DEBUG_2, "\tThreshold calibration %lu chunks: serial %e parallel %e\n", len, t_serial, t_parallel);
+        if (t_parallel < t_serial)
         {
-            __atomic_fetch_xor(slice_r + i, (
-                (ctrl_slice_x[i] & targ_slice_x[i] & ctrl_slice_z[i]) 
-                ^ (ctrl_slice_x[i] & targ_slice_x[i] & targ_slice_z[i]) 
-            ), __ATOMIC_RELAXED); 
-            targ_slice_z[i] ^= ctrl_slice_x[i];
-            ctrl_slice_z[i] ^= targ_slice_x[i];
-        }  
+            threshold = len;
+            break;
+        }
     }
+
+    free(slices);
+    return threshold;
 }
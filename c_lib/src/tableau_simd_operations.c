@@ -0,0 +1,398 @@
+#include "tableau_simd_operations.h"
+
+/*
+ * Instruction set descriptions
+ * Each instruction set provides a register type, the number of chunks per register,
+ * unaligned loads and stores and the four bitwise operations used by the gate bodies
+ * ANDN(a, b) is ~a & b, matching the vector instructions
+ */
+#define SCALAR_TARGET
+#define SCALAR_VEC CHUNK_OBJ
+#define SCALAR_CHUNKS (1)
+#define SCALAR_LOAD(ptr) (*(ptr))
+#define SCALAR_STORE(ptr, val) (*(ptr) = (val))
+#define SCALAR_XOR(a, b) ((a) ^ (b))
+#define SCALAR_AND(a, b) ((a) & (b))
+#define SCALAR_OR(a, b) ((a) | (b))
+#define SCALAR_ANDN(a, b) (~(a) & (b))
+
+#define AVX2_TARGET __attribute__((target("avx2")))
+#define AVX2_VEC __m256i
+#define AVX2_CHUNKS (sizeof(__m256i) / sizeof(CHUNK_OBJ))
+#define AVX2_LOAD(ptr) _mm256_loadu_si256((const __m256i*)(ptr))
+#define AVX2_STORE(ptr, val) _mm256_storeu_si256((__m256i*)(ptr), val)
+#define AVX2_XOR _mm256_xor_si256
+#define AVX2_AND _mm256_and_si256
+#define AVX2_OR _mm256_or_si256
+#define AVX2_ANDN _mm256_andnot_si256
+
+#define AVX512_TARGET __attribute__((target("avx512f")))
+#define AVX512_VEC __m512i
+#define AVX512_CHUNKS (sizeof(__m512i) / sizeof(CHUNK_OBJ))
+#define AVX512_LOAD(ptr) _mm512_loadu_si512((const void*)(ptr))
+#define AVX512_STORE(ptr, val) _mm512_storeu_si512((void*)(ptr), val)
+#define AVX512_XOR _mm512_xor_si512
+#define AVX512_AND _mm512_and_si512
+#define AVX512_OR _mm512_or_si512
+#define AVX512_ANDN _mm512_andnot_si512
+
+/*
+ * Slices written by each gate
+ * Only modified slices are stored back
+ */
+#define WRITE_X (1 << 0)
+#define WRITE_Z (1 << 1)
+#define WRITE_R (1 << 2)
+
+/*
+ * Gate bodies
+ * These follow the derivations of the scalar kernels in tableau_operations.c
+ * The phase is always updated from the values before the X or Z update
+ */
+#define X_BODY(ISA, x, z, r) { r = ISA##_XOR(r, z); }
+#define X_WRITES (WRITE_R)
+
+#define Y_BODY(ISA, x, z, r) { r = ISA##_XOR(r, ISA##_XOR(z, x)); }
+#define Y_WRITES (WRITE_R)
+
+#define Z_BODY(ISA, x, z, r) { r = ISA##_XOR(r, x); }
+#define Z_WRITES (WRITE_R)
+
+#define H_BODY(ISA, x, z, r) { r = ISA##_XOR(r, ISA##_AND(x, z)); }
+#define H_WRITES (WRITE_R)
+
+#define S_BODY(ISA, x, z, r) { r = ISA##_XOR(r, ISA##_AND(x, z)); z = ISA##_XOR(z, x); }
+#define S_WRITES (WRITE_R | WRITE_Z)
+
+#define R_BODY(ISA, x, z, r) { r = ISA##_XOR(r, ISA##_ANDN(z, x)); z = ISA##_XOR(z, x); }
+#define R_WRITES (WRITE_R | WRITE_Z)
+
+#define HX_BODY(ISA, x, z, r) { r = ISA##_XOR(r, ISA##_ANDN(x, z)); }
+#define HX_WRITES (WRITE_R)
+
+#define SX_BODY(ISA, x, z, r) { r = ISA##_XOR(r, ISA##_ANDN(x, z)); z = ISA##_XOR(z, x); }
+#define SX_WRITES (WRITE_R | WRITE_Z)
+
+#define RX_BODY(ISA, x, z, r) { r = ISA##_XOR(r, ISA##_OR(x, z)); z = ISA##_XOR(z, x); }
+#define RX_WRITES (WRITE_R | WRITE_Z)
+
+#define HY_BODY(ISA, x, z, r) { r = ISA##_XOR(r, ISA##_OR(z, x)); }
+#define HY_WRITES (WRITE_R)
+
+#define HZ_BODY(ISA, x, z, r) { r = ISA##_XOR(r, ISA##_ANDN(z, x)); }
+#define HZ_WRITES (WRITE_R)
+
+#define SH_BODY(ISA, x, z, r) { x = ISA##_XOR(x, z); }
+#define SH_WRITES (WRITE_X)
+
+#define RH_BODY(ISA, x, z, r) { r = ISA##_XOR(r, z); x = ISA##_XOR(x, z); }
+#define RH_WRITES (WRITE_R | WRITE_X)
+
+#define HS_BODY(ISA, x, z, r) { r = ISA##_XOR(r, x); z = ISA##_XOR(z, x); }
+#define HS_WRITES (WRITE_R | WRITE_Z)
+
+#define HR_BODY(ISA, x, z, r) { z = ISA##_XOR(z, x); }
+#define HR_WRITES (WRITE_Z)
+
+#define HSX_BODY(ISA, x, z, r) { r = ISA##_XOR(r, ISA##_XOR(x, z)); z = ISA##_XOR(z, x); }
+#define HSX_WRITES (WRITE_R | WRITE_Z)
+
+#define HRX_BODY(ISA, x, z, r) { r = ISA##_XOR(r, z); z = ISA##_XOR(z, x); }
+#define HRX_WRITES (WRITE_R | WRITE_Z)
+
+#define SHY_BODY(ISA, x, z, r) { r = ISA##_XOR(r, ISA##_XOR(z, x)); x = ISA##_XOR(x, z); }
+#define SHY_WRITES (WRITE_R | WRITE_X)
+
+#define RHY_BODY(ISA, x, z, r) { r = ISA##_XOR(r, x); x = ISA##_XOR(x, z); }
+#define RHY_WRITES (WRITE_R | WRITE_X)
+
+#define HSH_BODY(ISA, x, z, r) { r = ISA##_XOR(r, ISA##_ANDN(x, z)); x = ISA##_XOR(x, z); }
+#define HSH_WRITES (WRITE_R | WRITE_X)
+
+#define HRH_BODY(ISA, x, z, r) { r = ISA##_XOR(r, ISA##_AND(x, z)); x = ISA##_XOR(x, z); }
+#define HRH_WRITES (WRITE_R | WRITE_X)
+
+#define RHS_BODY(ISA, x, z, r) { r = ISA##_XOR(r, ISA##_OR(x, z)); x = ISA##_XOR(x, z); }
+#define RHS_WRITES (WRITE_R | WRITE_X)
+
+#define SHR_BODY(ISA, x, z, r) { r = ISA##_XOR(r, ISA##_ANDN(z, x)); x = ISA##_XOR(x, z); }
+#define SHR_WRITES (WRITE_R | WRITE_X)
+
+/*
+ * CNOT : r ^= cx.tz.~(tx ^ cz); tx ^= cx; cz ^= tz
+ * CZ : r ^= cx.tx.(cz ^ tz); tz ^= cx; cz ^= tx
+ */
+#define CNOT_BODY(ISA, cx, cz, tx, tz, r) { \
+    r = ISA##_XOR(r, ISA##_AND(cx, ISA##_ANDN(ISA##_XOR(tx, cz), tz))); \
+    tx = ISA##_XOR(tx, cx); \
+    cz = ISA##_XOR(cz, tz); }
+
+#define CZ_BODY(ISA, cx, cz, tx, tz, r) { \
+    r = ISA##_XOR(r, ISA##_AND(ISA##_AND(cx, tx), ISA##_XOR(cz, tz))); \
+    tz = ISA##_XOR(tz, cx); \
+    cz = ISA##_XOR(cz, tx); }
+
+
+/*
+ * SIMD_SINGLE_QUBIT_STEP
+ * Loads, updates and stores the chunks at offset i using the given instruction set
+ */
+#define SIMD_SINGLE_QUBIT_STEP(ISA, GATE, i) { \
+    ISA##_VEC x = ISA##_LOAD(slice_x + (i)); \
+    ISA##_VEC z = ISA##_LOAD(slice_z + (i)); \
+    ISA##_VEC r = ISA##_LOAD(slice_r + (i)); \
+    GATE##_BODY(ISA, x, z, r); \
+    if (GATE##_WRITES & WRITE_X) { ISA##_STORE(slice_x + (i), x); } \
+    if (GATE##_WRITES & WRITE_Z) { ISA##_STORE(slice_z + (i), z); } \
+    if (GATE##_WRITES & WRITE_R) { ISA##_STORE(slice_r + (i), r); } \
+}
+
+/*
+ * SIMD_SINGLE_QUBIT_KERNEL
+ * Generates tableau_<GATE>_range_<ISA>
+ * Full registers are processed first, the remaining chunks are handled one at a time
+ */
+#define SIMD_SINGLE_QUBIT_KERNEL(ISA, GATE) \
+static ISA##_TARGET \
+void tableau_##GATE##_range_##ISA( \
+    CHUNK_OBJ* restrict slice_x, \
+    CHUNK_OBJ* restrict slice_z, \
+    CHUNK_OBJ* restrict slice_r, \
+    const size_t start, \
+    const size_t end) \
+{ \
+    size_t i = start; \
+    for (; i + ISA##_CHUNKS <= end; i += ISA##_CHUNKS) \
+    { \
+        SIMD_SINGLE_QUBIT_STEP(ISA, GATE, i); \
+    } \
+    for (; i < end; i++) \
+    { \
+        SIMD_SINGLE_QUBIT_STEP(SCALAR, GATE, i); \
+    } \
+}
+
+#define SIMD_TWO_QUBIT_STEP(ISA, GATE, i) { \
+    ISA##_VEC cx = ISA##_LOAD(ctrl_slice_x + (i)); \
+    ISA##_VEC cz = ISA##_LOAD(ctrl_slice_z + (i)); \
+    ISA##_VEC tx = ISA##_LOAD(targ_slice_x + (i)); \
+    ISA##_VEC tz = ISA##_LOAD(targ_slice_z + (i)); \
+    ISA##_VEC r = ISA##_LOAD(slice_r + (i)); \
+    GATE##_BODY(ISA, cx, cz, tx, tz, r); \
+    ISA##_STORE(ctrl_slice_z + (i), cz); \
+    ISA##_STORE(targ_slice_x + (i), tx); \
+    ISA##_STORE(targ_slice_z + (i), tz); \
+    ISA##_STORE(slice_r + (i), r); \
+}
+
+/*
+ * SIMD_TWO_QUBIT_KERNEL
+ * Generates tableau_<GATE>_range_<ISA> for the two qubit gates
+ * The control X slice is never written
+ */
+#define SIMD_TWO_QUBIT_KERNEL(ISA, GATE) \
+static ISA##_TARGET \
+void tableau_##GATE##_range_##ISA( \
+    CHUNK_OBJ* restrict ctrl_slice_x, \
+    CHUNK_OBJ* restrict ctrl_slice_z, \
+    CHUNK_OBJ* restrict targ_slice_x, \
+    CHUNK_OBJ* restrict targ_slice_z, \
+    CHUNK_OBJ* restrict slice_r, \
+    const size_t start, \
+    const size_t end) \
+{ \
+    size_t i = start; \
+    for (; i + ISA##_CHUNKS <= end; i += ISA##_CHUNKS) \
+    { \
+        SIMD_TWO_QUBIT_STEP(ISA, GATE, i); \
+    } \
+    for (; i < end; i++) \
+    { \
+        SIMD_TWO_QUBIT_STEP(SCALAR, GATE, i); \
+    } \
+}
+
+#define SIMD_KERNELS(ISA) \
+    SIMD_SINGLE_QUBIT_KERNEL(ISA, X) \
+    SIMD_SINGLE_QUBIT_KERNEL(ISA, Y) \
+    SIMD_SINGLE_QUBIT_KERNEL(ISA, Z) \
+    SIMD_SINGLE_QUBIT_KERNEL(ISA, H) \
+    SIMD_SINGLE_QUBIT_KERNEL(ISA, S) \
+    SIMD_SINGLE_QUBIT_KERNEL(ISA, R) \
+    SIMD_SINGLE_QUBIT_KERNEL(ISA, HX) \
+    SIMD_SINGLE_QUBIT_KERNEL(ISA, SX) \
+    SIMD_SINGLE_QUBIT_KERNEL(ISA, RX) \
+    SIMD_SINGLE_QUBIT_KERNEL(ISA, HY) \
+    SIMD_SINGLE_QUBIT_KERNEL(ISA, HZ) \
+    SIMD_SINGLE_QUBIT_KERNEL(ISA, SH) \
+    SIMD_SINGLE_QUBIT_KERNEL(ISA, RH) \
+    SIMD_SINGLE_QUBIT_KERNEL(ISA, HS) \
+    SIMD_SINGLE_QUBIT_KERNEL(ISA, HR) \
+    SIMD_SINGLE_QUBIT_KERNEL(ISA, HSX) \
+    SIMD_SINGLE_QUBIT_KERNEL(ISA, HRX) \
+    SIMD_SINGLE_QUBIT_KERNEL(ISA, SHY) \
+    SIMD_SINGLE_QUBIT_KERNEL(ISA, RHY) \
+    SIMD_SINGLE_QUBIT_KERNEL(ISA, HSH) \
+    SIMD_SINGLE_QUBIT_KERNEL(ISA, HRH) \
+    SIMD_SINGLE_QUBIT_KERNEL(ISA, RHS) \
+    SIMD_SINGLE_QUBIT_KERNEL(ISA, SHR) \
+    SIMD_TWO_QUBIT_KERNEL(ISA, CNOT) \
+    SIMD_TWO_QUBIT_KERNEL(ISA, CZ)
+
+#define SIMD_SINGLE_QUBIT_TABLE(ISA) { \
+    NULL, \
+    tableau_X_range_##ISA, \
+    tableau_Y_range_##ISA, \
+    tableau_Z_range_##ISA, \
+    tableau_H_range_##ISA, \
+    tableau_S_range_##ISA, \
+    tableau_R_range_##ISA, \
+    tableau_HX_range_##ISA, \
+    tableau_SX_range_##ISA, \
+    tableau_RX_range_##ISA, \
+    tableau_HY_range_##ISA, \
+    tableau_HZ_range_##ISA, \
+    tableau_SH_range_##ISA, \
+    tableau_RH_range_##ISA, \
+    tableau_HS_range_##ISA, \
+    tableau_HR_range_##ISA, \
+    tableau_HSX_range_##ISA, \
+    tableau_HRX_range_##ISA, \
+    tableau_SHY_range_##ISA, \
+    tableau_RHY_range_##ISA, \
+    tableau_HSH_range_##ISA, \
+    tableau_HRH_range_##ISA, \
+    tableau_RHS_range_##ISA, \
+    tableau_SHR_range_##ISA}
+
+#define SIMD_TWO_QUBIT_TABLE(ISA) { \
+    tableau_CNOT_range_##ISA, \
+    tableau_CZ_range_##ISA}
+
+
+SIMD_KERNELS(AVX2)
+SIMD_KERNELS(AVX512)
+
+const tableau_kernel_t TABLEAU_AVX2_SINGLE_QUBIT_KERNELS[N_LOCAL_CLIFFORDS] = SIMD_SINGLE_QUBIT_TABLE(AVX2);
+const tableau_two_qubit_kernel_t TABLEAU_AVX2_TWO_QUBIT_KERNELS[N_NON_LOCAL_CLIFFORDS] = SIMD_TWO_QUBIT_TABLE(AVX2);
+
+const tableau_kernel_t TABLEAU_AVX512_SINGLE_QUBIT_KERNELS[N_LOCAL_CLIFFORDS] = SIMD_SINGLE_QUBIT_TABLE(AVX512);
+const tableau_two_qubit_kernel_t TABLEAU_AVX512_TWO_QUBIT_KERNELS[N_NON_LOCAL_CLIFFORDS] = SIMD_TWO_QUBIT_TABLE(AVX512);
+
+
+/*
+ * tableau_ctz_avx2
+ * Tests four chunks at a time, then finds the first set bit in the first non zero chunk
+ */
+__attribute__((target("avx2,bmi")))
+size_t tableau_ctz_avx2(CHUNK_OBJ* slice, const size_t slice_len)
+{
+    size_t i = 0;
+    for (; i + AVX2_CHUNKS <= slice_len; i += AVX2_CHUNKS)
+    {
+        __m256i chunks = AVX2_LOAD(slice + i);
+        if (!_mm256_testz_si256(chunks, chunks))
+        {
+            break;
+        }
+    }
+
+    for (; i < slice_len; i++)
+    {
+        if (0 != slice[i])
+        {
+            return CHUNK_SIZE_BITS * i + _tzcnt_u64(slice[i]);
+        }
+    }
+    return CTZ_SENTINEL;
+}
+
+/*
+ * tableau_ctz_avx512
+ * Tests eight chunks at a time, the mask of non zero chunks locates the first set chunk 
+ */
+__attribute__((target("avx512f,bmi")))
+size_t tableau_ctz_avx512(CHUNK_OBJ* slice, const size_t slice_len)
+{
+    size_t i = 0;
+    for (; i + AVX512_CHUNKS <= slice_len; i += AVX512_CHUNKS)
+    {
+        __m512i chunks = AVX512_LOAD(slice + i);
+        __mmask8 non_zero = _mm512_test_epi64_mask(chunks, chunks);
+        if (non_zero)
+        {
+            i += _tzcnt_u32(non_zero);
+            return CHUNK_SIZE_BITS * i + _tzcnt_u64(slice[i]);
+        }
+    }
+
+    for (; i < slice_len; i++)
+    {
+        if (0 != slice[i])
+        {
+            return CHUNK_SIZE_BITS * i + _tzcnt_u64(slice[i]);
+        }
+    }
+    return CTZ_SENTINEL;
+}
+
+/*
+ * tableau_transverse_hadamard_avx2
+ * Gathers the column chunks of four rows, only rows whose X and Z bits differ are written back
+ */
+__attribute__((target("avx2,bmi")))
+void tableau_transverse_hadamard_avx2(CHUNK_OBJ* const* slices_x, CHUNK_OBJ* const* slices_z, const size_t offset, const CHUNK_OBJ mask, const size_t n_rows)
+{
+    const __m256i bytes = _mm256_set1_epi64x(offset * sizeof(CHUNK_OBJ));
+    const __m256i masks = _mm256_set1_epi64x(mask);
+
+    size_t i = 0;
+    for (; i + AVX2_CHUNKS <= n_rows; i += AVX2_CHUNKS)
+    {
+        const __m256i addr_x = _mm256_add_epi64(AVX2_LOAD(slices_x + i), bytes);
+        const __m256i addr_z = _mm256_add_epi64(AVX2_LOAD(slices_z + i), bytes);
+        const __m256i x = _mm256_i64gather_epi64((const long long*)0, addr_x, 1);
+        const __m256i z = _mm256_i64gather_epi64((const long long*)0, addr_z, 1);
+        const __m256i differ = AVX2_AND(AVX2_XOR(x, z), masks);
+
+        const __m256i new_x = AVX2_XOR(x, differ);
+        const __m256i new_z = AVX2_XOR(z, differ);
+        slices_x[i][offset] = _mm256_extract_epi64(new_x, 0);
+        slices_x[i + 1][offset] = _mm256_extract_epi64(new_x, 1);
+        slices_x[i + 2][offset] = _mm256_extract_epi64(new_x, 2);
+        slices_x[i + 3][offset] = _mm256_extract_epi64(new_x, 3);
+        slices_z[i][offset] = _mm256_extract_epi64(new_z, 0);
+        slices_z[i + 1][offset] = _mm256_extract_epi64(new_z, 1);
+        slices_z[i + 2][offset] = _mm256_extract_epi64(new_z, 2);
+        slices_z[i + 3][offset] = _mm256_extract_epi64(new_z, 3);
+    }
+
+    tableau_transverse_hadamard_scalar(slices_x + i, slices_z + i, offset, mask, n_rows - i);
+}
+
+/*
+ * tableau_transverse_hadamard_avx512
+ * Gathers the column chunks of eight rows and scatters back the rows whose X and Z bits differ
+ */
+__attribute__((target("avx512f")))
+void tableau_transverse_hadamard_avx512(CHUNK_OBJ* const* slices_x, CHUNK_OBJ* const* slices_z, const size_t offset, const CHUNK_OBJ mask, const size_t n_rows)
+{
+    const __m512i bytes = _mm512_set1_epi64(offset * sizeof(CHUNK_OBJ));
+    const __m512i masks = _mm512_set1_epi64(mask);
+
+    size_t i = 0;
+    for (; i + AVX512_CHUNKS <= n_rows; i += AVX512_CHUNKS)
+    {
+        const __m512i addr_x = _mm512_add_epi64(AVX512_LOAD(slices_x + i), bytes);
+        const __m512i addr_z = _mm512_add_epi64(AVX512_LOAD(slices_z + i), bytes);
+        const __m512i x = _mm512_i64gather_epi64(addr_x, (const void*)0, 1);
+        const __m512i z = _mm512_i64gather_epi64(addr_z, (const void*)0, 1);
+        const __m512i differ = AVX512_AND(AVX512_XOR(x, z), masks);
+
+        const __mmask8 rows = _mm512_test_epi64_mask(differ, differ);
+        _mm512_mask_i64scatter_epi64((void*)0, rows, addr_x, AVX512_XOR(x, differ), 1);
+        _mm512_mask_i64scatter_epi64((void*)0, rows, addr_z, AVX512_XOR(z, differ), 1);
+    }
+
+    tableau_transverse_hadamard_scalar(slices_x + i, slices_z + i, offset, mask, n_rows - i);
+}
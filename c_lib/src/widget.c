@@ -1,5 +1,19 @@
 #include "widget.h"
 
+/*
+ * __inline_widget_tableau_capacity
+ * Number of qubits to allocate in the tableau
+ * :: n_qubits : const size_t :: Number of qubits required
+ * :: capacity : const size_t :: Suggested capacity
+ * :: max_qubits : const size_t :: Maximum number of qubits for the widget
+ */
+static inline
+size_t __inline_widget_tableau_capacity(const size_t n_qubits, const size_t capacity, const size_t max_qubits)
+{
+    size_t n_alloc = (n_qubits > capacity) ? n_qubits : capacity;
+    return (n_alloc < max_qubits) ? n_alloc : max_qubits;
+}
+
 /*
  * widget_create
  * Constructor for widget object
@@ -12,14 +26,38 @@ widget_t* widget_create(const size_t initial_qubits, const size_t max_qubits)
     wid->n_initial_qubits = initial_qubits;
     wid->n_qubits = initial_qubits;
     wid->max_qubits = max_qubits; 
-    wid->tableau = tableau_create(max_qubits);
+    wid->tableau = tableau_create(__inline_widget_tableau_capacity(initial_qubits, WIDGET_MIN_TABLEAU_QUBITS, max_qubits));
+    tableau_set_active_qubits(wid->tableau, initial_qubits);
     wid->queue = clifford_queue_create(max_qubits);
     wid->q_map = qubit_map_create(initial_qubits, max_qubits); 
     wid->pauli_tracker = pauli_tracker_create(max_qubits);
+    wid->ingest_mode = INGEST_CHUNK_REPLAY;
+    wid->pivot_mode = TABLEAU_PIVOT_FIRST;
+    wid->decompose_mode = DECOMPOSE_AUTO;
+    wid->elim_stats.row_sums = 0;
+    wid->elim_stats.chunk_xors = 0;
 
     return wid;
 }
 
+/*
+ * widget_reserve_qubits
+ * Ensures that the tableau holds at least a number of qubits
+ * :: wid : widget_t* :: The widget
+ * :: n_qubits : const size_t :: Number of qubits required, at most max_qubits
+ * The tableau grows geometrically up to max_qubits, so memory tracks the number of allocated
+ * qubits rather than the maximum
+ */
+void widget_reserve_qubits(widget_t* wid, const size_t n_qubits)
+{
+    assert(n_qubits <= wid->max_qubits);
+    if (n_qubits <= wid->tableau->n_qubits)
+    {
+        return;
+    }
+    tableau_grow(wid->tableau, __inline_widget_tableau_capacity(n_qubits, 2 * wid->tableau->n_qubits, wid->max_qubits));
+}
+
 /*
  * widget_destroy
  * Destructor for the widget object
@@ -54,6 +92,81 @@ size_t widget_get_max_qubits(const widget_t* wid)
     return wid->max_qubits;
 }
 
+/*
+ * widget_set_ingest_mode
+ * Selects how parse_instruction_block applies tableau operations
+ * :: wid : widget_t* :: The widget
+ * :: mode : const uint8_t :: One of INGEST_DISPATCH, INGEST_CHUNK_REPLAY or INGEST_THREADED
+ */
+void widget_set_ingest_mode(widget_t* wid, const uint8_t mode)
+{
+    assert(mode <= INGEST_THREADED);
+    wid->ingest_mode = mode;
+}
+
+/*
+ * widget_set_parallel_threshold
+ * Sets the slice length below which tableau kernels run serially
+ * :: wid : widget_t* :: The widget
+ * :: n_chunks : const size_t :: Threshold in chunks, 0 always forks a team and SIZE_MAX never does
+ */
+void widget_set_parallel_threshold(widget_t* wid, const size_t n_chunks)
+{
+    wid->tableau->parallel_threshold = n_chunks;
+}
+
+/*
+ * widget_set_sparse_slices
+ * Enables or disables sparse slice tracking on the widget's tableau
+ * :: wid : widget_t* :: The widget
+ * :: sparse : const bool :: Whether gate kernels should only visit occupied chunks
+ */
+void widget_set_sparse_slices(widget_t* wid, const bool sparse)
+{
+    if (sparse)
+    {
+        tableau_sparse_enable(wid->tableau);
+    }
+    else
+    {
+        tableau_sparse_disable(wid->tableau);
+    }
+}
+
+/*
+ * widget_set_pivot_mode
+ * Selects the pivot strategy used when the widget is decomposed
+ * :: wid : widget_t* :: The widget
+ * :: mode : const uint8_t :: Either TABLEAU_PIVOT_FIRST or TABLEAU_PIVOT_MARKOWITZ
+ */
+void widget_set_pivot_mode(widget_t* wid, const uint8_t mode)
+{
+    assert((TABLEAU_PIVOT_FIRST == mode) || (TABLEAU_PIVOT_MARKOWITZ == mode));
+    wid->pivot_mode = mode;
+}
+
+/*
+ * widget_set_decompose_mode
+ * Selects how the widget is decomposed
+ * :: wid : widget_t* :: The widget
+ * :: mode : const uint8_t :: One of DECOMPOSE_AUTO, DECOMPOSE_TRANSPOSE or DECOMPOSE_COLUMNS
+ */
+void widget_set_decompose_mode(widget_t* wid, const uint8_t mode)
+{
+    assert(mode <= DECOMPOSE_COLUMNS);
+    wid->decompose_mode = mode;
+}
+
+/*
+ * widget_get_elim_stats
+ * Work done by the elimination of the last call to widget_decompose
+ * :: wid : const widget_t* :: The widget
+ */
+tableau_elim_stats_t widget_get_elim_stats(const widget_t* wid)
+{
+    return wid->elim_stats;
+}
+
 /*
  * widget_get_adjacencies
  * For a qubit in the tableau, list all adjacent qubits 
@@ -71,11 +184,11 @@ struct adjacency_obj widget_get_adjacencies(const widget_t* wid, const size_t ta
     tableau_slice_p slice = wid->tableau->slices_z[target_qubit];
      
     #pragma omp parallel for 
-    for (size_t i = 0; i < wid->tableau->slice_len; i++)  
+    for (size_t i = 0; i < wid->tableau->active_len; i++)  
     {
-        if (slice[i] > 0 )
+        if (TABLEAU_CHUNK(slice, i) > 0 )
         {
-            CHUNK_OBJ obj = slice[i];
+            CHUNK_OBJ obj = TABLEAU_CHUNK(slice, i);
             while (obj > 0)
             {
                 uint32_t edge =  __CHUNK_CTZ(obj);
@@ -128,26 +241,25 @@ void widget_decompose(widget_t* wid)
 {
     tableau_remove_zero_X_columns(wid->tableau, wid->queue);
 
-    tableau_transpose(wid->tableau);
+    wid->elim_stats.row_sums = 0;
+    wid->elim_stats.chunk_xors = 0;
 
-    for (size_t i = 0; i < wid->n_qubits; i++)
-    {
-        if (0 == __inline_slice_get_bit(wid->tableau->slices_x[i], i))
-        {
-            tableau_X_diag_element(wid->tableau, wid->queue, i);
-        }
+    // Column elimination follows TABLEAU_PIVOT_FIRST, Markowitz pivots weigh whole rows
+    const bool columns = (DECOMPOSE_COLUMNS == wid->decompose_mode) ||
+        ((DECOMPOSE_AUTO == wid->decompose_mode) && (TABLEAU_PIVOT_FIRST == wid->pivot_mode));
 
-        tableau_X_diag_col_upper(wid->tableau, i);
+    if (columns)
+    {
+        // The decomposed tableau is symmetric, so it is not transposed unless rows are permuted that way
+        tableau_X_elim_cols(wid->tableau, wid->queue, wid->n_qubits, &wid->elim_stats);
     }
-
-
-    for (size_t i = 0; i < wid->n_qubits; i++)
+    else
     {
-        if (0 == __inline_slice_get_bit(wid->tableau->slices_x[i], i))
-        {
-            tableau_X_diag_element(wid->tableau, wid->queue, i);
-        }
-        tableau_X_diag_col_lower(wid->tableau, i);
+        tableau_transpose(wid->tableau);
+
+        // Blocked elimination, see tableau_X_diag_col_upper and tableau_X_diag_col_lower
+        tableau_X_elim_upper(wid->tableau, wid->queue, wid->n_qubits, wid->pivot_mode, &wid->elim_stats);
+        tableau_X_elim_lower(wid->tableau, wid->queue, wid->n_qubits, wid->pivot_mode, &wid->elim_stats);
     }
 
 
@@ -175,9 +287,9 @@ void widget_decompose(widget_t* wid)
     }
     // The previous loop zeros the phases, this loop just does it faster
     #pragma omp parallel for
-    for (size_t i = 0; i < wid->tableau->slice_len; i++)
+    for (size_t i = 0; i < wid->tableau->active_len; i++)
     {
-        wid->tableau->phases[i] = 0;    
+        TABLEAU_CHUNK(wid->tableau->phases, i) = 0;    
     }
 
 //    // TODO double check that this is doing something
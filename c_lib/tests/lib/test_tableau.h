@@ -16,8 +16,16 @@ tableau_t* tableau_random_create(size_t n_qubits)
     {
         for (size_t j = 0; j < tab->slice_len; j++)
         {
-           tab->slices_x[i][j] = rand(); 
-           tab->slices_z[i][j] = rand(); 
+           TABLEAU_CHUNK(tab->slices_x[i], j) = rand(); 
+           TABLEAU_CHUNK(tab->slices_z[i], j) = rand(); 
+        }
+
+        // Bits past the last qubit are padding and are kept clear, as in tableau_create
+        if (n_qubits % CHUNK_SIZE_BITS)
+        {
+            const CHUNK_OBJ mask = (1ull << (n_qubits % CHUNK_SIZE_BITS)) - 1;
+            TABLEAU_CHUNK(tab->slices_x[i], n_qubits / CHUNK_SIZE_BITS) &= mask;
+            TABLEAU_CHUNK(tab->slices_z[i], n_qubits / CHUNK_SIZE_BITS) &= mask;
         }
     }     
     tab->phases[0] = rand(); 
@@ -40,13 +48,13 @@ tableau_t* tableau_copy(tableau_t* const tab)
     {
         for (size_t j = 0; j < tab->slice_len; j++)
         {
-            tab_cpy->slices_x[i][j] = tab->slices_x[i][j]; 
-            tab_cpy->slices_z[i][j] = tab->slices_z[i][j]; 
+            TABLEAU_CHUNK(tab_cpy->slices_x[i], j) = TABLEAU_CHUNK(tab->slices_x[i], j); 
+            TABLEAU_CHUNK(tab_cpy->slices_z[i], j) = TABLEAU_CHUNK(tab->slices_z[i], j); 
         }
     }   
     for (size_t j = 0; j < tab->slice_len; j++)
     {
-        tab_cpy->phases[j] = tab->phases[j]; 
+        TABLEAU_CHUNK(tab_cpy->phases, j) = TABLEAU_CHUNK(tab->phases, j); 
     }
     return tab_cpy;
 }
@@ -0,0 +1,208 @@
+#include <assert.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#define INSTRUCTIONS_TABLE
+
+#include "widget.h"
+#include "tableau_operations.h"
+#include "input_stream.h"
+#include "instructions.h"
+#include "circuit_file.h"
+
+/*
+ * create_instruction_stream
+ * Random stream of local and non local Cliffords with an RZ in every eight gates
+ */
+instruction_stream_u* create_instruction_stream(const size_t n_qubits, const size_t n_gates)
+{
+    instruction_stream_u* inst = malloc(n_gates * sizeof(instruction_stream_u));
+    for (size_t i = 0; i < n_gates; i++)
+    {
+        if (0 == i % 8)
+        {
+            inst[i].rz.opcode = _RZ_;
+            inst[i].rz.arg = rand() % n_qubits;
+            inst[i].rz.tag = i;
+        }
+        else if (rand() % 2)
+        {
+            inst[i].single.opcode = LOCAL_CLIFFORD_MASK | (rand() % N_LOCAL_CLIFFORD_INSTRUCTIONS);
+            inst[i].single.arg = rand() % n_qubits;
+        }
+        else
+        {
+            inst[i].multi.opcode = NON_LOCAL_CLIFFORD_MASK | (rand() % N_NON_LOCAL_CLIFFORD_INSTRUCTIONS);
+            inst[i].multi.ctrl = rand() % n_qubits;
+            while ((inst[i].multi.targ = rand() % n_qubits) == inst[i].multi.ctrl) {};
+        }
+    }
+    return inst;
+}
+
+/*
+ * test_circuit_file
+ * Writes a stream to a circuit file and compares parsing the file against parsing the stream
+ */
+void test_circuit_file(const size_t n_qubits, const size_t n_gates, const uint32_t encoding)
+{
+    char path[] = "/tmp/test_circuit_file_XXXXXX";
+    const int fd = mkstemp(path);
+    assert(fd >= 0);
+    close(fd);
+
+    const size_t max_qubits = n_qubits + n_gates / 8 + 1;
+    instruction_stream_u* inst = create_instruction_stream(n_qubits, n_gates);
+    assert(CIRCUIT_FILE_OK == circuit_file_write(path, n_qubits, max_qubits, inst, n_gates, encoding));
+
+    int status;
+    circuit_file_t* file = circuit_file_open(path, &status);
+    assert(CIRCUIT_FILE_OK == status);
+    assert(NULL != file);
+    assert(n_qubits == file->header.n_qubits);
+    assert(max_qubits == file->header.max_qubits);
+    assert(n_gates == file->header.n_instructions);
+
+    widget_t* wid = circuit_file_widget_create(file);
+    widget_t* wid_ref = widget_create(n_qubits, max_qubits);
+    assert(n_gates == circuit_file_parse(wid, file, &status));
+    assert(CIRCUIT_FILE_OK == status);
+    parse_instruction_block(wid_ref, inst, n_gates);
+    circuit_file_close(file);
+
+    assert(wid->n_qubits == wid_ref->n_qubits);
+    for (size_t i = 0; i < wid->n_qubits; i++)
+    {
+        assert(wid->queue->table[i] == wid_ref->queue->table[i]);
+        assert(wid->queue->non_cliffords[i] == wid_ref->queue->non_cliffords[i]);
+        for (size_t j = 0; j < wid->tableau->slice_len; j++)
+        {
+            assert(TABLEAU_CHUNK(wid->tableau->slices_x[i], j) == TABLEAU_CHUNK(wid_ref->tableau->slices_x[i], j));
+            assert(TABLEAU_CHUNK(wid->tableau->slices_z[i], j) == TABLEAU_CHUNK(wid_ref->tableau->slices_z[i], j));
+        }
+    }
+
+    widget_destroy(wid);
+    widget_destroy(wid_ref);
+    free(inst);
+    unlink(path);
+}
+
+/*
+ * test_corrupt_records
+ * Writes a two qubit circuit file, overwrites one byte of its records and checks that the parse fails
+ * :: offset : const long :: Offset of the byte into the records, negative to leave the records intact
+ * :: byte : const uint8_t :: Byte to write
+ * :: expected : const int :: Status of the parse
+ * The records fit in one window, so none of them are parsed
+ */
+void test_corrupt_records(
+    const char* path,
+    const instruction_stream_u* inst,
+    const size_t n_instructions,
+    const uint32_t encoding,
+    const long offset,
+    const uint8_t byte,
+    const int expected)
+{
+    assert(CIRCUIT_FILE_OK == circuit_file_write(path, 2, 2, inst, n_instructions, encoding));
+    if (offset >= 0)
+    {
+        FILE* fp = fopen(path, "r+b");
+        assert(0 == fseek(fp, CIRCUIT_FILE_HEADER_BYTES + offset, SEEK_SET));
+        assert(1 == fwrite(&byte, 1, 1, fp));
+        fclose(fp);
+    }
+
+    int status;
+    circuit_file_t* file = circuit_file_open(path, &status);
+    assert(CIRCUIT_FILE_OK == status);
+
+    widget_t* wid = circuit_file_widget_create(file);
+    assert(0 == circuit_file_parse(wid, file, &status));
+    assert(expected == status);
+
+    widget_destroy(wid);
+    circuit_file_close(file);
+}
+
+/*
+ * test_invalid_files
+ * Missing, short and corrupted files are rejected
+ */
+void test_invalid_files()
+{
+    int status;
+    assert(NULL == circuit_file_open("/tmp/test_circuit_file_missing", &status));
+    assert(CIRCUIT_FILE_ERR_IO == status);
+
+    char path[] = "/tmp/test_circuit_file_XXXXXX";
+    const int fd = mkstemp(path);
+    assert(fd >= 0);
+    assert(4 == write(fd, "CAB", 4));
+    close(fd);
+    assert(NULL == circuit_file_open(path, &status));
+    assert(CIRCUIT_FILE_ERR_FORMAT == status);
+
+    // Records past the end of the file
+    instruction_stream_u inst[2];
+    inst[0].single.opcode = _H_;
+    inst[0].single.arg = 0;
+    inst[1] = inst[0];
+    assert(CIRCUIT_FILE_OK == circuit_file_write(path, 1, 1, inst, 2, CIRCUIT_FILE_ENCODING_RAW));
+    assert(0 == truncate(path, CIRCUIT_FILE_HEADER_BYTES + sizeof(instruction_stream_u)));
+    assert(NULL == circuit_file_open(path, NULL));
+
+    // Bad magic
+    assert(CIRCUIT_FILE_OK == circuit_file_write(path, 1, 1, inst, 2, CIRCUIT_FILE_ENCODING_PACKED));
+    FILE* fp = fopen(path, "r+b");
+    assert(1 == fwrite("X", 1, 1, fp));
+    fclose(fp);
+    assert(NULL == circuit_file_open(path, &status));
+    assert(CIRCUIT_FILE_ERR_FORMAT == status);
+
+    // Corrupt records pass the header checks and are rejected by the parse
+    inst[1].multi.opcode = _CNOT_;
+    inst[1].multi.ctrl = 0;
+    inst[1].multi.targ = 50000000;
+    test_corrupt_records(path, inst, 2, CIRCUIT_FILE_ENCODING_RAW, -1, 0, CIRCUIT_FILE_ERR_QUBITS);
+    test_corrupt_records(path, inst, 2, CIRCUIT_FILE_ENCODING_PACKED, -1, 0, CIRCUIT_FILE_ERR_QUBITS);
+
+    // Unknown opcode
+    inst[1].multi.targ = 1;
+    test_corrupt_records(path, inst, 2, CIRCUIT_FILE_ENCODING_RAW, 0, 0x00, CIRCUIT_FILE_ERR_FORMAT);
+    test_corrupt_records(path, inst, 2, CIRCUIT_FILE_ENCODING_PACKED, 0, 0x00, CIRCUIT_FILE_ERR_FORMAT);
+
+    // Composite local Cliffords are queued but never appear in the stream
+    test_corrupt_records(path, inst, 2, CIRCUIT_FILE_ENCODING_RAW, 0, _HY_, CIRCUIT_FILE_ERR_FORMAT);
+    test_corrupt_records(path, inst, 2, CIRCUIT_FILE_ENCODING_PACKED, 0, _SHR_, CIRCUIT_FILE_ERR_FORMAT);
+
+    // The last varint continues past the end of the records
+    test_corrupt_records(path, inst, 2, CIRCUIT_FILE_ENCODING_PACKED, 4, 0x81, CIRCUIT_FILE_ERR_FORMAT);
+
+    // More RZ gates than the widget has qubits for
+    inst[1].rz.opcode = _RZ_;
+    inst[1].rz.arg = 1;
+    inst[1].rz.tag = 0;
+    test_corrupt_records(path, inst, 2, CIRCUIT_FILE_ENCODING_RAW, -1, 0, CIRCUIT_FILE_ERR_QUBITS);
+
+    unlink(path);
+}
+
+
+int main()
+{
+    test_invalid_files();
+
+    for (size_t i = 0; i < 5; i++)
+    {
+        srand(i);
+        test_circuit_file(10 + i, 100, CIRCUIT_FILE_ENCODING_RAW);
+        test_circuit_file(10 + i, 100, CIRCUIT_FILE_ENCODING_PACKED);
+        test_circuit_file(300, 3 * CIRCUIT_FILE_WINDOW + 17, CIRCUIT_FILE_ENCODING_RAW);
+        test_circuit_file(300, 3 * CIRCUIT_FILE_WINDOW + 17, CIRCUIT_FILE_ENCODING_PACKED);
+    }
+    test_circuit_file(10, 0, CIRCUIT_FILE_ENCODING_RAW);
+
+    return 0;
+}
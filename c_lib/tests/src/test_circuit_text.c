@@ -0,0 +1,444 @@
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#define INSTRUCTIONS_TABLE
+
+#include "widget.h"
+#include "tableau_operations.h"
+#include "input_stream.h"
+#include "instructions.h"
+#include "circuit_text.h"
+
+#define MAX_TEST_INSTRUCTIONS (64)
+
+/*
+ * read_text
+ * Parses a whole text circuit from a string
+ * :: text : const char* :: The circuit
+ * :: format : const uint8_t :: CIRCUIT_TEXT_QASM or CIRCUIT_TEXT_STIM
+ * :: inst : instruction_stream_u* :: Written with the instructions
+ * :: status : int* :: Written with the status of the parser
+ * :: line : size_t* :: Written with the line of the last statement read
+ * Returns the number of instructions
+ */
+size_t read_text(const char* text, const uint8_t format, instruction_stream_u* inst, int* status, size_t* line)
+{
+    FILE* fp = fmemopen((void*)text, strlen(text), "r");
+    assert(NULL != fp);
+    circuit_text_parser_t* parser = circuit_text_parser_create(fp, format);
+    size_t n = 0;
+    size_t n_read;
+    while ((n_read = circuit_text_read(parser, inst + n, 1)))
+    {
+        n += n_read;
+        assert(n < MAX_TEST_INSTRUCTIONS);
+    }
+    *status = parser->status;
+    *line = parser->line;
+    circuit_text_parser_destroy(parser);
+    fclose(fp);
+    return n;
+}
+
+/*
+ * assert_instruction
+ * Checks the opcode and qubits of an instruction
+ */
+void assert_instruction(const instruction_stream_u* inst, const instruction_t opcode, const uint32_t a, const uint32_t b)
+{
+    assert(opcode == inst->instruction);
+    switch (INSTRUCTION_TYPE(opcode))
+    {
+        case INSTRUCTION_TYPE(LOCAL_CLIFFORD_MASK):
+            assert(a == inst->single.arg);
+            break;
+        case INSTRUCTION_TYPE(RZ_MASK):
+            assert(a == inst->rz.arg);
+            assert(b == inst->rz.tag);
+            break;
+        default:
+            assert(a == inst->multi.ctrl);
+            assert(b == inst->multi.targ);
+    }
+}
+
+/*
+ * float_tag
+ * Bits of an angle as a 32 bit float
+ */
+non_clifford_tag_t float_tag(const float angle)
+{
+    non_clifford_tag_t tag;
+    memcpy(&tag, &angle, sizeof(tag));
+    return tag;
+}
+
+/*
+ * test_qasm
+ * Every supported QASM gate, registers, broadcasting and comments
+ */
+void test_qasm()
+{
+    const char* text =
+        "OPENQASM 2.0;\n"
+        "include \"qelib1.inc\";\n"
+        "qreg a[2];\n"
+        "qreg b[2]; creg c[2];\n"
+        "// comment ; with a semicolon\n"
+        "id a[0]; x a[0]; y a[1]; z b[0];\n"
+        "h b[1]; s a[0]; sdg a[1];\n"
+        "sx a[0]; sxdg b[0];\n"
+        "cx a[0], b[1]; CX b[0],a[1]; cz a[1], a[0];\n"
+        "cy a[0], b[0]; swap a[1], b[1];\n"
+        "barrier a, b;\n"
+        "t a[0]; tdg a[1]; rz(-pi / 2) b[0]; u1(0) b[1]; p(2*(pi - 1)) a[0];\n"
+        "cx a, b;\n"
+        "h b;\n"
+        "cz a[0],\n"
+        "   b; // broadcast over b\n";
+
+    instruction_stream_u inst[MAX_TEST_INSTRUCTIONS];
+    int status;
+    size_t line;
+    const size_t n = read_text(text, CIRCUIT_TEXT_QASM, inst, &status, &line);
+    assert(CIRCUIT_TEXT_OK == status);
+
+    size_t i = 0;
+    assert_instruction(inst + i++, _X_, 0, 0);
+    assert_instruction(inst + i++, _Y_, 1, 0);
+    assert_instruction(inst + i++, _Z_, 2, 0);
+    assert_instruction(inst + i++, _H_, 3, 0);
+    assert_instruction(inst + i++, _S_, 0, 0);
+    assert_instruction(inst + i++, _R_, 1, 0);
+    assert_instruction(inst + i++, _H_, 0, 0);
+    assert_instruction(inst + i++, _S_, 0, 0);
+    assert_instruction(inst + i++, _H_, 0, 0);
+    assert_instruction(inst + i++, _H_, 2, 0);
+    assert_instruction(inst + i++, _R_, 2, 0);
+    assert_instruction(inst + i++, _H_, 2, 0);
+    assert_instruction(inst + i++, _CNOT_, 0, 3);
+    assert_instruction(inst + i++, _CNOT_, 2, 1);
+    assert_instruction(inst + i++, _CZ_, 1, 0);
+    assert_instruction(inst + i++, _R_, 2, 0);
+    assert_instruction(inst + i++, _CNOT_, 0, 2);
+    assert_instruction(inst + i++, _S_, 2, 0);
+    assert_instruction(inst + i++, _CNOT_, 1, 3);
+    assert_instruction(inst + i++, _CNOT_, 3, 1);
+    assert_instruction(inst + i++, _CNOT_, 1, 3);
+    assert_instruction(inst + i++, _RZ_, 0, float_tag(M_PI / 4));
+    assert_instruction(inst + i++, _RZ_, 1, float_tag(-M_PI / 4));
+    assert_instruction(inst + i++, _RZ_, 2, float_tag(-M_PI / 2));
+    assert_instruction(inst + i++, _RZ_, 3, 0);
+    assert_instruction(inst + i++, _RZ_, 0, float_tag(2 * (M_PI - 1)));
+    assert_instruction(inst + i++, _CNOT_, 0, 2);
+    assert_instruction(inst + i++, _CNOT_, 1, 3);
+    assert_instruction(inst + i++, _H_, 2, 0);
+    assert_instruction(inst + i++, _H_, 3, 0);
+    assert_instruction(inst + i++, _CZ_, 0, 2);
+    assert_instruction(inst + i++, _CZ_, 0, 3);
+    assert(n == i);
+}
+
+/*
+ * test_stim
+ * Every supported Stim gate, target lists, annotations and comments
+ */
+void test_stim()
+{
+    const char* text =
+        "# comment\n"
+        "QUBIT_COORDS(0, 1) 0\n"
+        "QUBIT_COORDS(1, 1) 5\n"
+        "I 0\n"
+        "X 0 1\n"
+        "y 2\n"
+        "Z 3 # comment\n"
+        "\n"
+        "H 0\tH_XZ 1\n"
+        "TICK\n"
+        "S 0\n"
+        "SQRT_Z 1\n"
+        "S_DAG 2\n"
+        "SQRT_Z_DAG 3\n"
+        "SQRT_X 0\n"
+        "SQRT_X_DAG 1\n"
+        "CX 0 1 2 3\n"
+        "CNOT 1 0\n"
+        "ZCX 2 0\n"
+        "CY 0 1\n"
+        "ZCY 1 0\n"
+        "CZ 0 1\n"
+        "ZCZ 3 2\n"
+        "SWAP 0 4\n"
+        "DETECTOR(1, 0) rec[-1]\n"
+        "SHIFT_COORDS(0, 1)\n"
+        "OBSERVABLE_INCLUDE(0) rec[-1]\n";
+
+    instruction_stream_u inst[MAX_TEST_INSTRUCTIONS];
+    int status;
+    size_t line;
+
+    // Two gate names on one line are a syntax error
+    read_text(text, CIRCUIT_TEXT_STIM, inst, &status, &line);
+    assert(CIRCUIT_TEXT_ERR_SYNTAX == status);
+    assert(9 == line);
+
+    char* fixed = strdup(text);
+    *strchr(fixed, '\t') = '\n';
+    const size_t n = read_text(fixed, CIRCUIT_TEXT_STIM, inst, &status, &line);
+    free(fixed);
+    assert(CIRCUIT_TEXT_OK == status);
+
+    size_t i = 0;
+    assert_instruction(inst + i++, _X_, 0, 0);
+    assert_instruction(inst + i++, _X_, 1, 0);
+    assert_instruction(inst + i++, _Y_, 2, 0);
+    assert_instruction(inst + i++, _Z_, 3, 0);
+    assert_instruction(inst + i++, _H_, 0, 0);
+    assert_instruction(inst + i++, _H_, 1, 0);
+    assert_instruction(inst + i++, _S_, 0, 0);
+    assert_instruction(inst + i++, _S_, 1, 0);
+    assert_instruction(inst + i++, _R_, 2, 0);
+    assert_instruction(inst + i++, _R_, 3, 0);
+    assert_instruction(inst + i++, _H_, 0, 0);
+    assert_instruction(inst + i++, _S_, 0, 0);
+    assert_instruction(inst + i++, _H_, 0, 0);
+    assert_instruction(inst + i++, _H_, 1, 0);
+    assert_instruction(inst + i++, _R_, 1, 0);
+    assert_instruction(inst + i++, _H_, 1, 0);
+    assert_instruction(inst + i++, _CNOT_, 0, 1);
+    assert_instruction(inst + i++, _CNOT_, 2, 3);
+    assert_instruction(inst + i++, _CNOT_, 1, 0);
+    assert_instruction(inst + i++, _CNOT_, 2, 0);
+    assert_instruction(inst + i++, _R_, 1, 0);
+    assert_instruction(inst + i++, _CNOT_, 0, 1);
+    assert_instruction(inst + i++, _S_, 1, 0);
+    assert_instruction(inst + i++, _R_, 0, 0);
+    assert_instruction(inst + i++, _CNOT_, 1, 0);
+    assert_instruction(inst + i++, _S_, 0, 0);
+    assert_instruction(inst + i++, _CZ_, 0, 1);
+    assert_instruction(inst + i++, _CZ_, 3, 2);
+    assert_instruction(inst + i++, _CNOT_, 0, 4);
+    assert_instruction(inst + i++, _CNOT_, 4, 0);
+    assert_instruction(inst + i++, _CNOT_, 0, 4);
+    assert(n == i);
+}
+
+/*
+ * test_errors
+ * Unsupported statements and malformed statements stop the parse on their line
+ */
+void test_errors()
+{
+    struct {
+        const char* text;
+        uint8_t format;
+        int status;
+        size_t line;
+    } cases[] = {
+        {"qreg q[2];\nh q[0];\nmeasure q[0] -> c[0];\nh q[1];", CIRCUIT_TEXT_QASM, CIRCUIT_TEXT_ERR_UNSUPPORTED, 3},
+        {"qreg q[2];\nu3(0, 0, 0) q[0];", CIRCUIT_TEXT_QASM, CIRCUIT_TEXT_ERR_UNSUPPORTED, 2},
+        {"qreg q[2];\n\ngate g a { h a; }", CIRCUIT_TEXT_QASM, CIRCUIT_TEXT_ERR_UNSUPPORTED, 3},
+        {"qreg q[2];\nh q[2];", CIRCUIT_TEXT_QASM, CIRCUIT_TEXT_ERR_QUBITS, 2},
+        {"qreg q[2];\nh r[0];", CIRCUIT_TEXT_QASM, CIRCUIT_TEXT_ERR_SYNTAX, 2},
+        {"qreg q[2];\ncx q[0];", CIRCUIT_TEXT_QASM, CIRCUIT_TEXT_ERR_SYNTAX, 2},
+        {"qreg q[2];\ncx q[1], q[1];", CIRCUIT_TEXT_QASM, CIRCUIT_TEXT_ERR_SYNTAX, 2},
+        {"qreg q[2];\nqreg r[3];\ncx q, r;", CIRCUIT_TEXT_QASM, CIRCUIT_TEXT_ERR_SYNTAX, 3},
+        {"qreg q[2];\nrz(pi/) q[0];", CIRCUIT_TEXT_QASM, CIRCUIT_TEXT_ERR_SYNTAX, 2},
+        {"qreg q[2];\nrz q[0];", CIRCUIT_TEXT_QASM, CIRCUIT_TEXT_ERR_SYNTAX, 2},
+        {"H 0\nM 0\n", CIRCUIT_TEXT_STIM, CIRCUIT_TEXT_ERR_UNSUPPORTED, 2},
+        {"H 0\nREPEAT 2 {\nH 0\n}\n", CIRCUIT_TEXT_STIM, CIRCUIT_TEXT_ERR_UNSUPPORTED, 2},
+        {"H 0\nCX rec[-1] 0\n", CIRCUIT_TEXT_STIM, CIRCUIT_TEXT_ERR_UNSUPPORTED, 2},
+        {"CX 0 1 2\n", CIRCUIT_TEXT_STIM, CIRCUIT_TEXT_ERR_SYNTAX, 1},
+        {"\n\nCZ 1 1\n", CIRCUIT_TEXT_STIM, CIRCUIT_TEXT_ERR_SYNTAX, 3},
+        {"H(0.1) 0\n", CIRCUIT_TEXT_STIM, CIRCUIT_TEXT_ERR_SYNTAX, 1},
+    };
+
+    instruction_stream_u inst[MAX_TEST_INSTRUCTIONS];
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        int status;
+        size_t line;
+        read_text(cases[i].text, cases[i].format, inst, &status, &line);
+        assert(cases[i].status == status);
+        assert(cases[i].line == line);
+    }
+}
+
+/*
+ * create_instruction_stream
+ * Random stream of local and non local Cliffords with an RZ in every eight gates
+ */
+instruction_stream_u* create_instruction_stream(const size_t n_qubits, const size_t n_gates, const bool rz)
+{
+    instruction_stream_u* inst = malloc(n_gates * sizeof(instruction_stream_u));
+    for (size_t i = 0; i < n_gates; i++)
+    {
+        if (rz && (0 == i % 8))
+        {
+            inst[i].rz.opcode = _RZ_;
+            inst[i].rz.arg = rand() % n_qubits;
+            inst[i].rz.tag = float_tag((float)rand() / RAND_MAX - 0.5f);
+        }
+        else if (rand() % 2)
+        {
+            inst[i].single.opcode = LOCAL_CLIFFORD_MASK | (rand() % N_LOCAL_CLIFFORD_INSTRUCTIONS);
+            inst[i].single.arg = rand() % n_qubits;
+        }
+        else
+        {
+            inst[i].multi.opcode = NON_LOCAL_CLIFFORD_MASK | (rand() % N_NON_LOCAL_CLIFFORD_INSTRUCTIONS);
+            inst[i].multi.ctrl = rand() % n_qubits;
+            while ((inst[i].multi.targ = rand() % n_qubits) == inst[i].multi.ctrl) {};
+        }
+    }
+    return inst;
+}
+
+/*
+ * write_text
+ * Writes a stream as a text circuit
+ */
+void write_text(FILE* fp, const uint8_t format, const size_t n_qubits, const instruction_stream_u* inst, const size_t n_gates)
+{
+    const char* QASM_NAMES[N_LOCAL_CLIFFORD_INSTRUCTIONS] = {"id", "x", "y", "z", "h", "s", "sdg"};
+    const char* STIM_NAMES[N_LOCAL_CLIFFORD_INSTRUCTIONS] = {"I", "X", "Y", "Z", "H", "S", "S_DAG"};
+
+    if (CIRCUIT_TEXT_QASM == format)
+    {
+        fprintf(fp, "OPENQASM 2.0;\ninclude \"qelib1.inc\";\nqreg q[%zu];\n", n_qubits);
+    }
+    for (size_t i = 0; i < n_gates; i++)
+    {
+        const bool qasm = (CIRCUIT_TEXT_QASM == format);
+        switch (INSTRUCTION_TYPE(inst[i].instruction))
+        {
+            case INSTRUCTION_TYPE(LOCAL_CLIFFORD_MASK):
+            {
+                const char* name = (qasm ? QASM_NAMES : STIM_NAMES)[inst[i].instruction & INSTRUCTION_OPERATOR_MASK];
+                fprintf(fp, qasm ? "%s q[%u];\n" : "%s %u\n", name, inst[i].single.arg);
+                break;
+            }
+            case INSTRUCTION_TYPE(NON_LOCAL_CLIFFORD_MASK):
+            {
+                const char* name = (_CNOT_ == inst[i].instruction) ? (qasm ? "cx" : "CX") : (qasm ? "cz" : "CZ");
+                fprintf(fp, qasm ? "%s q[%u], q[%u];\n" : "%s %u %u\n", name, inst[i].multi.ctrl, inst[i].multi.targ);
+                break;
+            }
+            default:
+            {
+                float angle;
+                memcpy(&angle, &inst[i].rz.tag, sizeof(angle));
+                fprintf(fp, "rz(%.9g) q[%u];\n", angle, inst[i].rz.arg);
+            }
+        }
+    }
+}
+
+/*
+ * test_stream
+ * Writes a random stream as a text circuit, then reads it back in blocks and parses it into a widget
+ */
+void test_stream(const size_t n_qubits, const size_t n_gates, const uint8_t format, const size_t block)
+{
+    const bool rz = (CIRCUIT_TEXT_QASM == format);
+    instruction_stream_u* inst = create_instruction_stream(n_qubits, n_gates, rz);
+
+    char path[] = "/tmp/test_circuit_text_XXXXXX";
+    const int fd = mkstemp(path);
+    assert(fd >= 0);
+    FILE* fp = fdopen(fd, "w+");
+    write_text(fp, format, n_qubits, inst, n_gates);
+
+    // Identity gates are dropped
+    size_t n_expected = 0;
+    for (size_t i = 0; i < n_gates; i++)
+    {
+        n_expected += (_I_ != inst[i].instruction);
+    }
+
+    rewind(fp);
+    circuit_text_parser_t* parser = circuit_text_parser_create(fp, format);
+    const size_t n_header = circuit_text_read_header(parser);
+    assert(rz ? (n_header == n_qubits) : (n_header <= n_qubits));
+    instruction_stream_u* read = malloc(block * sizeof(instruction_stream_u));
+    size_t n_read = 0;
+    size_t j = 0;
+    size_t n;
+    while ((n = circuit_text_read(parser, read, block)))
+    {
+        assert(n <= block);
+        for (size_t i = 0; i < n; i++, j++)
+        {
+            while (_I_ == inst[j].instruction)
+            {
+                j++;
+            }
+            assert_instruction(read + i, inst[j].instruction, inst[j].multi.ctrl, inst[j].multi.targ);
+        }
+        n_read += n;
+    }
+    assert(CIRCUIT_TEXT_OK == parser->status);
+    assert(n_expected == n_read);
+    circuit_text_parser_destroy(parser);
+    free(read);
+
+    // Parsing the text matches parsing the stream
+    rewind(fp);
+    parser = circuit_text_parser_create(fp, format);
+    const size_t max_qubits = n_qubits + n_gates / 8 + 1;
+    widget_t* wid = widget_create(n_qubits, max_qubits);
+    widget_t* wid_ref = widget_create(n_qubits, max_qubits);
+    assert(n_expected == circuit_text_parse(wid, parser));
+    assert(CIRCUIT_TEXT_OK == parser->status);
+    parse_instruction_block(wid_ref, inst, n_gates);
+    circuit_text_parser_destroy(parser);
+
+    assert(wid->n_qubits == wid_ref->n_qubits);
+    for (size_t i = 0; i < wid->n_qubits; i++)
+    {
+        assert(wid->queue->table[i] == wid_ref->queue->table[i]);
+        assert(wid->queue->non_cliffords[i] == wid_ref->queue->non_cliffords[i]);
+        for (size_t k = 0; k < wid->tableau->slice_len; k++)
+        {
+            assert(TABLEAU_CHUNK(wid->tableau->slices_x[i], k) == TABLEAU_CHUNK(wid_ref->tableau->slices_x[i], k));
+            assert(TABLEAU_CHUNK(wid->tableau->slices_z[i], k) == TABLEAU_CHUNK(wid_ref->tableau->slices_z[i], k));
+        }
+    }
+    widget_destroy(wid);
+    widget_destroy(wid_ref);
+
+    // A widget with too few qubits stops the parse
+    rewind(fp);
+    parser = circuit_text_parser_create(fp, format);
+    wid = widget_create(n_qubits / 2, max_qubits);
+    circuit_text_parse(wid, parser);
+    assert(CIRCUIT_TEXT_ERR_QUBITS == parser->status);
+    circuit_text_parser_destroy(parser);
+    widget_destroy(wid);
+
+    fclose(fp);
+    unlink(path);
+    free(inst);
+}
+
+
+int main()
+{
+    test_qasm();
+    test_stim();
+    test_errors();
+
+    for (size_t i = 0; i < 5; i++)
+    {
+        srand(i);
+        test_stream(10 + i, 200, CIRCUIT_TEXT_QASM, 1 + i);
+        test_stream(10 + i, 200, CIRCUIT_TEXT_STIM, 7);
+        test_stream(300, 3 * CIRCUIT_TEXT_WINDOW + 17, CIRCUIT_TEXT_QASM, CIRCUIT_TEXT_WINDOW);
+        test_stream(300, 3 * CIRCUIT_TEXT_WINDOW + 17, CIRCUIT_TEXT_STIM, 1000);
+    }
+
+    return 0;
+}
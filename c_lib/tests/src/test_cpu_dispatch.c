@@ -0,0 +1,161 @@
+#include <assert.h>
+
+#include "tableau.h"
+#include "tableau_operations.h"
+#include "cpu_dispatch.h"
+#include "test_tableau.h"
+
+/*
+ * test_tableau_eq
+ * Checks that two tableaus hold the same X, Z and phase slices
+ */
+void test_tableau_eq(tableau_t* tab, tableau_t* tab_cmp)
+{
+    for (size_t i = 0; i < tab->n_qubits; i++)
+    {
+        for (size_t j = 0; j < tab->slice_len; j++)
+        {
+            assert(TABLEAU_CHUNK(tab->slices_x[i], j) == TABLEAU_CHUNK(tab_cmp->slices_x[i], j));
+            assert(TABLEAU_CHUNK(tab->slices_z[i], j) == TABLEAU_CHUNK(tab_cmp->slices_z[i], j));
+        }
+    }
+    for (size_t j = 0; j < tab->slice_len; j++)
+    {
+        assert(TABLEAU_CHUNK(tab->phases, j) == TABLEAU_CHUNK(tab_cmp->phases, j));
+    }
+}
+
+/*
+ * test_dispatch_gates
+ * Applies the same random gates using the scalar kernels and the kernels for an instruction set
+ */
+void test_dispatch_gates(const uint8_t isa, const size_t n_qubits, const size_t n_gates)
+{
+    tableau_t* tab = tableau_random_create(n_qubits);
+    tableau_t* tab_cmp = tableau_copy(tab);
+
+    for (size_t i = 0; i < n_gates; i++)
+    {
+        const size_t ctrl = rand() % n_qubits;
+        size_t targ;
+        while ((targ = rand() % n_qubits) == ctrl) {};
+
+        const instruction_t cliff = rand() % N_LOCAL_CLIFFORDS;
+        const instruction_t gate = rand() % N_NON_LOCAL_CLIFFORDS;
+
+        cpu_dispatch_select(CPU_ISA_SCALAR);
+        SINGLE_QUBIT_OPERATIONS[cliff](tab_cmp, ctrl);
+        TWO_QUBIT_OPERATIONS[gate](tab_cmp, ctrl, targ);
+
+        cpu_dispatch_select(isa);
+        SINGLE_QUBIT_OPERATIONS[cliff](tab, ctrl);
+        TWO_QUBIT_OPERATIONS[gate](tab, ctrl, targ);
+    }
+    test_tableau_eq(tab, tab_cmp);
+
+    tableau_destroy(tab);
+    tableau_destroy(tab_cmp);
+}
+
+/*
+ * test_dispatch_transpose
+ * Compares the transpose for an instruction set against the scalar transpose
+ */
+void test_dispatch_transpose(const uint8_t isa, const size_t n_qubits)
+{
+    tableau_t* tab = tableau_random_create(n_qubits);
+    tableau_t* tab_cmp = tableau_copy(tab);
+
+    cpu_dispatch_select(CPU_ISA_SCALAR);
+    tableau_transpose(tab_cmp);
+
+    cpu_dispatch_select(isa);
+    tableau_transpose(tab);
+
+    test_tableau_eq(tab, tab_cmp);
+
+    tableau_destroy(tab);
+    tableau_destroy(tab_cmp);
+}
+
+/*
+ * test_dispatch_transverse_hadamard
+ * Compares the transverse hadamard for an instruction set against swapping each pair of bits
+ */
+void test_dispatch_transverse_hadamard(const uint8_t isa, const size_t n_qubits, const size_t n_gates)
+{
+    tableau_t* tab = tableau_random_create(n_qubits);
+    tableau_t* tab_cmp = tableau_copy(tab);
+
+    cpu_dispatch_select(isa);
+    for (size_t i = 0; i < n_gates; i++)
+    {
+        const size_t targ = rand() % n_qubits;
+        tableau_transverse_hadamard(tab, targ);
+
+        for (size_t j = 0; j < n_qubits; j++)
+        {
+            const uint8_t bit_x = __inline_slice_get_bit(tab_cmp->slices_x[j], targ);
+            const uint8_t bit_z = __inline_slice_get_bit(tab_cmp->slices_z[j], targ);
+            __inline_slice_set_bit(tab_cmp->slices_x[j], targ, bit_z);
+            __inline_slice_set_bit(tab_cmp->slices_z[j], targ, bit_x);
+        }
+    }
+    test_tableau_eq(tab, tab_cmp);
+
+    tableau_destroy(tab);
+    tableau_destroy(tab_cmp);
+}
+
+/*
+ * test_dispatch_ctz
+ * Compares the ctz for an instruction set against the scalar ctz over every single bit position
+ */
+void test_dispatch_ctz(const uint8_t isa, const size_t slice_len)
+{
+    CHUNK_OBJ* slice = calloc(slice_len, sizeof(CHUNK_OBJ));
+
+    cpu_dispatch_select(isa);
+    assert(CTZ_SENTINEL == tableau_ctz(slice, slice_len));
+
+    for (size_t i = 0; i < slice_len * CHUNK_SIZE_BITS; i++)
+    {
+        slice[i / CHUNK_SIZE_BITS] = 1ull << (i % CHUNK_SIZE_BITS);
+        slice[slice_len - 1] |= 1ull << 63;
+        assert(tableau_ctz_scalar(slice, slice_len) == tableau_ctz(slice, slice_len));
+        slice[i / CHUNK_SIZE_BITS] = 0;
+    }
+
+    free(slice);
+}
+
+
+int main()
+{
+    const uint8_t host_isa = cpu_dispatch_detect();
+    assert(CPU_DISPATCH.isa <= host_isa);
+
+    for (uint8_t isa = CPU_ISA_SCALAR; isa <= host_isa; isa++)
+    {
+        srand(isa);
+        test_dispatch_gates(isa, 200, 500);
+        test_dispatch_gates(isa, 1000, 200);
+
+        test_dispatch_transpose(isa, 128);
+        test_dispatch_transpose(isa, 200);
+
+        test_dispatch_transverse_hadamard(isa, 128, 300);
+        test_dispatch_transverse_hadamard(isa, 203, 300);
+
+        // Contiguous test slices only match the slice layout
+        if (TABLEAU_LAYOUT == TABLEAU_LAYOUT_SLICES)
+        {
+            test_dispatch_ctz(isa, 1);
+            test_dispatch_ctz(isa, 13);
+            test_dispatch_ctz(isa, 16);
+        }
+    }
+
+    cpu_dispatch_select(host_isa);
+    return 0;
+}
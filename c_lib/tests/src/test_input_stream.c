@@ -23,8 +23,8 @@ tableau_t* tableau_random_create()
     {
         for (size_t j = 0; j < tab->slice_len; j++)
         {
-           tab->slices_x[i][j] = rand(); 
-           tab->slices_z[i][j] = rand(); 
+           TABLEAU_CHUNK(tab->slices_x[i], j) = rand(); 
+           TABLEAU_CHUNK(tab->slices_z[i], j) = rand(); 
         }
     }     
     tab->phases[0] = rand(); 
@@ -39,13 +39,13 @@ tableau_t* tableau_copy(tableau_t* tab)
     {
         for (size_t j = 0; j < tab->slice_len; j++)
         {
-            tab_cpy->slices_x[i][j] = tab->slices_x[i][j]; 
-            tab_cpy->slices_z[i][j] = tab->slices_z[i][j]; 
+            TABLEAU_CHUNK(tab_cpy->slices_x[i], j) = TABLEAU_CHUNK(tab->slices_x[i], j); 
+            TABLEAU_CHUNK(tab_cpy->slices_z[i], j) = TABLEAU_CHUNK(tab->slices_z[i], j); 
         }
     }   
     for (size_t j = 0; j < tab->slice_len; j++)
     {
-        tab_cpy->phases[j] = tab->phases[j]; 
+        TABLEAU_CHUNK(tab_cpy->phases, j) = TABLEAU_CHUNK(tab->phases, j); 
     }
     return tab_cpy;
 }
@@ -62,13 +62,13 @@ void test_tableau_copy()
     {
         for (size_t j = 0; j < tab->slice_len; j++)
         {
-            assert(tab->slices_x[i][j] == wid->tableau->slices_x[i][j]); 
-            assert(tab->slices_z[i][j] == wid->tableau->slices_z[i][j]); 
+            assert(TABLEAU_CHUNK(tab->slices_x[i], j) == TABLEAU_CHUNK(wid->tableau->slices_x[i], j)); 
+            assert(TABLEAU_CHUNK(tab->slices_z[i], j) == TABLEAU_CHUNK(wid->tableau->slices_z[i], j)); 
         }
     }   
     for (size_t j = 0; j < tab->slice_len; j++)
     {
-        assert(tab->phases[j] == wid->tableau->phases[j]); 
+        assert(TABLEAU_CHUNK(tab->phases, j) == TABLEAU_CHUNK(wid->tableau->phases, j)); 
     }
     tableau_destroy(tab);
     widget_destroy(wid);
@@ -252,6 +252,81 @@ void test_cz_stream(void)
 }
 
 
+/*
+ * test_ingest_modes
+ * Compares the serial per gate dispatch against another ingest mode
+ * :: threshold : const size_t :: Parallel threshold for the compared widget
+ * :: mode : const uint8_t :: Ingest mode of the compared widget
+ */
+void test_ingest_modes(const size_t n_qubits, const size_t n_gates, const size_t threshold, const uint8_t mode)
+{
+    const size_t n_rz = n_gates / 8;
+    widget_t* wid_dispatch = widget_create(n_qubits, n_qubits + n_rz);
+    widget_t* wid_cmp = widget_create(n_qubits, n_qubits + n_rz);
+    widget_set_ingest_mode(wid_dispatch, INGEST_DISPATCH);
+    widget_set_ingest_mode(wid_cmp, mode);
+    widget_set_parallel_threshold(wid_dispatch, SIZE_MAX);
+    widget_set_parallel_threshold(wid_cmp, threshold);
+
+    instruction_stream_u* inst = malloc((n_gates + n_rz) * sizeof(instruction_stream_u));
+    size_t n_inst = 0;
+    for (size_t i = 0; i < n_gates; i++)
+    {
+        if (rand() % 2)
+        {
+            inst[n_inst].single.opcode = LOCAL_CLIFFORD_MASK | (rand() % N_LOCAL_CLIFFORD_INSTRUCTIONS);
+            inst[n_inst].single.arg = rand() % n_qubits;
+        }
+        else
+        {
+            inst[n_inst].multi.opcode = NON_LOCAL_CLIFFORD_MASK | (rand() % N_NON_LOCAL_CLIFFORD_INSTRUCTIONS);
+            inst[n_inst].multi.ctrl = rand() % n_qubits;
+            while ((inst[n_inst].multi.targ = rand() % n_qubits) == inst[n_inst].multi.ctrl){};
+        }
+        n_inst++;
+
+        if (0 == (i % 8))
+        {
+            inst[n_inst].rz.opcode = _RZ_;
+            inst[n_inst].rz.arg = rand() % n_qubits;
+            inst[n_inst].rz.tag = i;
+            n_inst++;
+        }
+    }
+
+    parse_instruction_block(wid_dispatch, inst, n_inst);
+    parse_instruction_block(wid_cmp, inst, n_inst);
+
+    assert(wid_dispatch->n_qubits == wid_cmp->n_qubits);
+    for (size_t i = 0; i < wid_dispatch->n_qubits; i++)
+    {
+        assert(wid_dispatch->queue->table[i] == wid_cmp->queue->table[i]);
+    }
+
+    apply_local_cliffords(wid_dispatch);
+    apply_local_cliffords(wid_cmp);
+
+    for (size_t i = 0; i < wid_dispatch->n_qubits; i++)
+    {
+        assert(wid_dispatch->queue->table[i] == wid_cmp->queue->table[i]);
+        for (size_t j = 0; j < wid_dispatch->tableau->slice_len; j++)
+        {
+            assert(TABLEAU_CHUNK(wid_dispatch->tableau->slices_x[i], j) == TABLEAU_CHUNK(wid_cmp->tableau->slices_x[i], j));
+            assert(TABLEAU_CHUNK(wid_dispatch->tableau->slices_z[i], j) == TABLEAU_CHUNK(wid_cmp->tableau->slices_z[i], j));
+        }
+    }
+    for (size_t j = 0; j < wid_dispatch->tableau->slice_len; j++)
+    {
+        assert(TABLEAU_CHUNK(wid_dispatch->tableau->phases, j) == TABLEAU_CHUNK(wid_cmp->tableau->phases, j));
+    }
+
+    free(inst);
+    widget_destroy(wid_dispatch);
+    widget_destroy(wid_cmp);
+    return;
+}
+
+
 int main()
 {
     test_tableau_copy();
@@ -262,5 +337,13 @@ int main()
     test_cnot_stream();
     test_cz_stream();
 
+    for (size_t i = 0; i < 10; i++)
+    {
+        srand(i);
+        test_ingest_modes(8 + 97 * i, 1000 * (i + 1), 0, INGEST_CHUNK_REPLAY);
+        test_ingest_modes(8 + 97 * i, 1000 * (i + 1), SIZE_MAX, INGEST_CHUNK_REPLAY);
+        test_ingest_modes(8 + 97 * i, 1000 * (i + 1), SIZE_MAX, INGEST_THREADED);
+    }
+
     return 0;
 }
@@ -0,0 +1,269 @@
+#include <assert.h>
+
+#define INSTRUCTIONS_TABLE
+
+#include "widget.h"
+#include "tableau_operations.h"
+#include "input_stream.h"
+#include "instructions.h"
+#include "packed_stream.h"
+
+/*
+ * create_instruction_stream
+ * Random stream of every instruction type
+ * :: n_qubits : const size_t :: Number of qubits
+ * :: n_gates : const size_t :: Number of instructions
+ * :: locality : const size_t :: Maximum distance between the qubits of a two qubit gate
+ * :: conditionals : const bool :: Whether to include measurement conditioned instructions
+ * RZ tags increase by small steps with the occasional jump in either direction
+ */
+instruction_stream_u* create_instruction_stream(const size_t n_qubits, const size_t n_gates, const size_t locality, const bool conditionals)
+{
+    instruction_stream_u* inst = malloc(n_gates * sizeof(instruction_stream_u));
+    non_clifford_tag_t tag = 0;
+    for (size_t i = 0; i < n_gates; i++)
+    {
+        const size_t ctrl = rand() % n_qubits;
+        size_t targ;
+        while ((targ = (ctrl + n_qubits - locality + rand() % (2 * locality + 1)) % n_qubits) == ctrl) {};
+
+        switch (rand() % (conditionals ? 4 : 3))
+        {
+            case 0:
+                inst[i].single.opcode = LOCAL_CLIFFORD_MASK | (rand() % N_LOCAL_CLIFFORD_INSTRUCTIONS);
+                inst[i].single.arg = ctrl;
+                break;
+            case 1:
+                inst[i].multi.opcode = NON_LOCAL_CLIFFORD_MASK | (rand() % N_NON_LOCAL_CLIFFORD_INSTRUCTIONS);
+                inst[i].multi.ctrl = ctrl;
+                inst[i].multi.targ = targ;
+                break;
+            case 2:
+                tag = (rand() % 16) ? tag + 1 : (non_clifford_tag_t)rand();
+                inst[i].rz.opcode = _RZ_;
+                inst[i].rz.arg = ctrl;
+                inst[i].rz.tag = tag;
+                break;
+            default:
+                inst[i].cond.opcode = _MCX_ + rand() % 3;
+                inst[i].cond.ctrl = ctrl;
+                inst[i].cond.targ = targ;
+        }
+    }
+    return inst;
+}
+
+/*
+ * test_instruction_eq
+ * Compares the fields of two instructions that are used by their type
+ */
+void test_instruction_eq(const instruction_stream_u* a, const instruction_stream_u* b)
+{
+    assert(a->instruction == b->instruction);
+    switch (INSTRUCTION_TYPE(a->instruction))
+    {
+        case INSTRUCTION_TYPE(LOCAL_CLIFFORD_MASK):
+            assert(a->single.arg == b->single.arg);
+            break;
+        case INSTRUCTION_TYPE(NON_LOCAL_CLIFFORD_MASK):
+            assert(a->multi.ctrl == b->multi.ctrl);
+            assert(a->multi.targ == b->multi.targ);
+            break;
+        case INSTRUCTION_TYPE(RZ_MASK):
+            assert(a->rz.arg == b->rz.arg);
+            assert(a->rz.tag == b->rz.tag);
+            break;
+        default:
+            assert(a->cond.ctrl == b->cond.ctrl);
+            assert(a->cond.targ == b->cond.targ);
+    }
+}
+
+/*
+ * test_round_trip
+ * Packs a stream and unpacks it in blocks of a given size
+ */
+void test_round_trip(const size_t n_qubits, const size_t n_gates, const size_t locality, const size_t block)
+{
+    instruction_stream_u* inst = create_instruction_stream(n_qubits, n_gates, locality, true);
+    uint8_t* bytes = malloc(packed_stream_bound(n_gates));
+    const size_t n_bytes = packed_stream_encode(inst, n_gates, bytes);
+    assert(n_bytes <= packed_stream_bound(n_gates));
+
+    instruction_stream_u* unpacked = malloc(block * sizeof(instruction_stream_u));
+    packed_stream_decoder_t dec;
+    packed_stream_decoder_init(&dec, bytes, n_bytes);
+
+    size_t n_decoded = 0;
+    size_t n;
+    while ((n = packed_stream_decode(&dec, unpacked, block)))
+    {
+        assert(n <= block);
+        for (size_t i = 0; i < n; i++)
+        {
+            test_instruction_eq(inst + n_decoded + i, unpacked + i);
+        }
+        n_decoded += n;
+    }
+    assert(n_decoded == n_gates);
+    assert(dec.pos == n_bytes);
+    assert(PACKED_STREAM_OK == dec.status);
+
+    free(unpacked);
+    free(bytes);
+    free(inst);
+}
+
+/*
+ * test_extremes
+ * Round trips the largest field values and the largest differences between them
+ */
+void test_extremes()
+{
+    instruction_stream_u inst[6];
+    inst[0].single.opcode = _H_;
+    inst[0].single.arg = UINT32_MAX;
+    inst[1].multi.opcode = _CNOT_;
+    inst[1].multi.ctrl = 0;
+    inst[1].multi.targ = UINT32_MAX;
+    inst[2].multi.opcode = _CZ_;
+    inst[2].multi.ctrl = UINT32_MAX;
+    inst[2].multi.targ = 0;
+    inst[3].rz.opcode = _RZ_;
+    inst[3].rz.arg = 1;
+    inst[3].rz.tag = UINT32_MAX;
+    inst[4].rz.opcode = _RZ_;
+    inst[4].rz.arg = 0;
+    inst[4].rz.tag = 0;
+    inst[5].cond.opcode = _MCZ_;
+    inst[5].cond.ctrl = UINT32_MAX;
+    inst[5].cond.targ = 1;
+
+    uint8_t bytes[6 * PACKED_STREAM_MAX_INSTRUCTION_BYTES];
+    const size_t n_bytes = packed_stream_encode(inst, 6, bytes);
+
+    instruction_stream_u unpacked[6];
+    packed_stream_decoder_t dec;
+    packed_stream_decoder_init(&dec, bytes, n_bytes);
+    assert(6 == packed_stream_decode(&dec, unpacked, 6));
+    assert(0 == packed_stream_decode(&dec, unpacked, 6));
+    for (size_t i = 0; i < 6; i++)
+    {
+        test_instruction_eq(inst + i, unpacked + i);
+    }
+}
+
+/*
+ * test_malformed
+ * Truncated buffers and unknown opcodes stop the decode with a status
+ */
+void test_malformed()
+{
+    instruction_stream_u inst[2];
+    inst[0].multi.opcode = _CNOT_;
+    inst[0].multi.ctrl = 1000;
+    inst[0].multi.targ = 0;
+    inst[1] = inst[0];
+
+    uint8_t bytes[2 * PACKED_STREAM_MAX_INSTRUCTION_BYTES];
+    const size_t n_bytes = packed_stream_encode(inst, 2, bytes);
+
+    // Ends inside the last varint
+    instruction_stream_u unpacked[2];
+    packed_stream_decoder_t dec;
+    packed_stream_decoder_init(&dec, bytes, n_bytes - 2);
+    assert(1 == packed_stream_decode(&dec, unpacked, 2));
+    assert(PACKED_STREAM_ERR_TRUNCATED == dec.status);
+    assert(0 == packed_stream_decode(&dec, unpacked, 2));
+
+    // Varints longer than five bytes
+    const uint8_t long_varint[] = {_H_, 0x80, 0x80, 0x80, 0x80, 0x80, 0x01};
+    packed_stream_decoder_init(&dec, long_varint, sizeof(long_varint));
+    assert(0 == packed_stream_decode(&dec, unpacked, 2));
+    assert(PACKED_STREAM_ERR_TRUNCATED == dec.status);
+
+    bytes[0] = 0x00;
+    packed_stream_decoder_init(&dec, bytes, n_bytes);
+    assert(0 == packed_stream_decode(&dec, unpacked, 2));
+    assert(PACKED_STREAM_ERR_OPCODE == dec.status);
+}
+
+/*
+ * test_packed_size
+ * Checks that a local stream packs to well under half of its unpacked size
+ */
+void test_packed_size(const size_t n_qubits, const size_t n_gates, const size_t locality)
+{
+    instruction_stream_u* inst = create_instruction_stream(n_qubits, n_gates, locality, false);
+    uint8_t* bytes = malloc(packed_stream_bound(n_gates));
+    const size_t n_bytes = packed_stream_encode(inst, n_gates, bytes);
+
+    assert(2 * n_bytes < n_gates * sizeof(instruction_stream_u));
+
+    free(bytes);
+    free(inst);
+}
+
+/*
+ * test_parse_packed
+ * Parses the same stream packed and unpacked
+ */
+void test_parse_packed(const size_t n_qubits, const size_t n_gates, const size_t locality)
+{
+    instruction_stream_u* inst = create_instruction_stream(n_qubits, n_gates, locality, false);
+    uint8_t* bytes = malloc(packed_stream_bound(n_gates));
+    const size_t n_bytes = packed_stream_encode(inst, n_gates, bytes);
+
+    widget_t* wid = widget_create(n_qubits, n_qubits + n_gates);
+    widget_t* wid_ref = widget_create(n_qubits, n_qubits + n_gates);
+    assert(n_gates == parse_packed_block(wid, bytes, n_bytes));
+    parse_instruction_block(wid_ref, inst, n_gates);
+
+    assert(wid->n_qubits == wid_ref->n_qubits);
+    for (size_t i = 0; i < wid->n_qubits; i++)
+    {
+        assert(wid->queue->table[i] == wid_ref->queue->table[i]);
+        assert(wid->queue->non_cliffords[i] == wid_ref->queue->non_cliffords[i]);
+        for (size_t j = 0; j < wid->tableau->slice_len; j++)
+        {
+            assert(TABLEAU_CHUNK(wid->tableau->slices_x[i], j) == TABLEAU_CHUNK(wid_ref->tableau->slices_x[i], j));
+            assert(TABLEAU_CHUNK(wid->tableau->slices_z[i], j) == TABLEAU_CHUNK(wid_ref->tableau->slices_z[i], j));
+        }
+    }
+    for (size_t j = 0; j < wid->tableau->slice_len; j++)
+    {
+        assert(TABLEAU_CHUNK(wid->tableau->phases, j) == TABLEAU_CHUNK(wid_ref->tableau->phases, j));
+    }
+
+    widget_destroy(wid);
+    widget_destroy(wid_ref);
+    free(bytes);
+    free(inst);
+}
+
+
+int main()
+{
+    test_extremes();
+    test_malformed();
+
+    for (size_t i = 0; i < 10; i++)
+    {
+        srand(i);
+        test_round_trip(10 + i, 1000, 3, 1);
+        test_round_trip(1000, 10000, 500, 7 + i);
+        test_round_trip(1 << 20, 10000, 1 << 19, PACKED_STREAM_WINDOW);
+    }
+
+    test_packed_size(1000, 100000, 16);
+    test_packed_size(100000, 100000, 64);
+
+    for (size_t i = 0; i < 3; i++)
+    {
+        srand(i);
+        test_parse_packed(100, 1000, 8);
+        test_parse_packed(500, 3 * PACKED_STREAM_WINDOW, 32);
+    }
+
+    return 0;
+}
@@ -0,0 +1,242 @@
+#include <assert.h>
+
+#define INSTRUCTIONS_TABLE
+
+#include "widget.h"
+#include "tableau_operations.h"
+#include "input_stream.h"
+#include "instructions.h"
+#include "peephole.h"
+
+/*
+ * set_single
+ * Writes a local Clifford or RZ instruction
+ */
+void set_single(instruction_stream_u* inst, const instruction_t opcode, const uint32_t arg)
+{
+    inst->rz.opcode = opcode;
+    inst->rz.arg = arg;
+    inst->rz.tag = 0;
+}
+
+/*
+ * set_multi
+ * Writes a two qubit instruction
+ */
+void set_multi(instruction_stream_u* inst, const instruction_t opcode, const uint32_t ctrl, const uint32_t targ)
+{
+    inst->multi.opcode = opcode;
+    inst->multi.ctrl = ctrl;
+    inst->multi.targ = targ;
+}
+
+/*
+ * test_cancel_pairs
+ * Small streams with known simplifications
+ */
+void test_cancel_pairs()
+{
+    instruction_stream_u inst[PEEPHOLE_WINDOW + 2];
+    peephole_stats_t stats = {0};
+
+    // Self inverse pairs
+    set_multi(inst + 0, _CNOT_, 0, 1);
+    set_multi(inst + 1, _CNOT_, 0, 1);
+    assert(0 == peephole_simplify(inst, 2, &stats));
+    assert(2 == stats.n_removed);
+    assert(1 == stats.n_cancelled);
+
+    set_multi(inst + 0, _CZ_, 0, 1);
+    set_multi(inst + 1, _CZ_, 1, 0);
+    assert(0 == peephole_simplify(inst, 2, NULL));
+
+    set_multi(inst + 0, _CNOT_, 0, 1);
+    set_multi(inst + 1, _CNOT_, 1, 0);
+    assert(2 == peephole_simplify(inst, 2, NULL));
+
+    set_single(inst + 0, _H_, 0);
+    set_single(inst + 1, _H_, 0);
+    assert(0 == peephole_simplify(inst, 2, NULL));
+
+    // Merged local Cliffords
+    set_single(inst + 0, _S_, 0);
+    set_single(inst + 1, _S_, 0);
+    assert(1 == peephole_simplify(inst, 2, NULL));
+    assert(_Z_ == inst[0].single.opcode);
+
+    set_single(inst + 0, _H_, 0);
+    set_single(inst + 1, _S_, 0);
+    assert(2 == peephole_simplify(inst, 2, NULL));
+
+    // Commuting gates between the pair
+    memset(&stats, 0, sizeof(stats));
+    set_multi(inst + 0, _CZ_, 0, 1);
+    set_single(inst + 1, _S_, 0);
+    set_single(inst + 2, _H_, 2);
+    set_multi(inst + 3, _CNOT_, 1, 2);
+    set_multi(inst + 4, _CZ_, 0, 1);
+    assert(3 == peephole_simplify(inst, 5, &stats));
+    assert(2 == stats.n_removed);
+    assert(_S_ == inst[0].single.opcode);
+    assert(_H_ == inst[1].single.opcode);
+    assert(_CNOT_ == inst[2].multi.opcode);
+
+    set_single(inst + 0, _X_, 0);
+    set_multi(inst + 1, _CNOT_, 1, 0);
+    set_single(inst + 2, _X_, 0);
+    assert(1 == peephole_simplify(inst, 3, NULL));
+    assert(_CNOT_ == inst[0].multi.opcode);
+
+    // Paulis pushed through the pair
+    memset(&stats, 0, sizeof(stats));
+    set_multi(inst + 0, _CNOT_, 0, 1);
+    set_single(inst + 1, _X_, 0);
+    set_multi(inst + 2, _CNOT_, 0, 1);
+    assert(2 == peephole_simplify(inst, 3, &stats));
+    assert(1 == stats.n_pushed);
+    assert((_X_ == inst[0].single.opcode) && (0 == inst[0].single.arg));
+    assert((_X_ == inst[1].single.opcode) && (1 == inst[1].single.arg));
+
+    set_multi(inst + 0, _CZ_, 0, 1);
+    set_single(inst + 1, _Y_, 1);
+    set_multi(inst + 2, _CZ_, 0, 1);
+    assert(2 == peephole_simplify(inst, 3, NULL));
+    assert((_Z_ == inst[0].single.opcode) && (0 == inst[0].single.arg));
+    assert((_Y_ == inst[1].single.opcode) && (1 == inst[1].single.arg));
+
+    // Barriers
+    set_multi(inst + 0, _CNOT_, 0, 1);
+    set_single(inst + 1, _H_, 0);
+    set_multi(inst + 2, _CNOT_, 0, 1);
+    assert(3 == peephole_simplify(inst, 3, NULL));
+
+    set_multi(inst + 0, _CNOT_, 0, 1);
+    set_single(inst + 1, _RZ_, 1);
+    set_multi(inst + 2, _CNOT_, 0, 1);
+    assert(3 == peephole_simplify(inst, 3, NULL));
+
+    set_multi(inst + 0, _CZ_, 0, 1);
+    set_multi(inst + 1, _MCZ_, 2, 0);
+    set_multi(inst + 2, _CZ_, 0, 1);
+    assert(3 == peephole_simplify(inst, 3, NULL));
+
+    // Window bound
+    for (size_t n_between = PEEPHOLE_WINDOW - 1; n_between <= PEEPHOLE_WINDOW; n_between++)
+    {
+        set_multi(inst, _CNOT_, 0, 1);
+        for (size_t i = 0; i < n_between; i++)
+        {
+            set_single(inst + 1 + i, _H_, 2 + i);
+        }
+        set_multi(inst + n_between + 1, _CNOT_, 0, 1);
+        const size_t kept = peephole_simplify(inst, n_between + 2, NULL);
+        assert(kept == ((n_between < PEEPHOLE_WINDOW) ? n_between : n_between + 2));
+    }
+}
+
+/*
+ * create_redundant_stream
+ * Random stream where many instructions repeat one of the last few instructions
+ * :: n_qubits : const size_t :: Number of qubits
+ * :: n_gates : const size_t :: Number of instructions
+ * :: n_rz : size_t* :: Written with the number of RZ instructions
+ */
+instruction_stream_u* create_redundant_stream(const size_t n_qubits, const size_t n_gates, size_t* n_rz)
+{
+    instruction_stream_u* inst = malloc(n_gates * sizeof(instruction_stream_u));
+    *n_rz = 0;
+    for (size_t i = 0; i < n_gates; i++)
+    {
+        const uint32_t ctrl = rand() % n_qubits;
+        uint32_t targ;
+        while ((targ = rand() % n_qubits) == ctrl) {};
+
+        const size_t choice = rand() % 16;
+        if ((i > 0) && (choice < 6))
+        {
+            inst[i] = inst[i - 1 - rand() % ((i < 6) ? i : 6)];
+            if ((_CZ_ == inst[i].multi.opcode) && (rand() % 2))
+            {
+                set_multi(inst + i, _CZ_, inst[i].multi.targ, inst[i].multi.ctrl);
+            }
+            *n_rz += (_RZ_ == inst[i].instruction);
+        }
+        else if (choice < 11)
+        {
+            set_single(inst + i, LOCAL_CLIFFORD_MASK | (rand() % N_LOCAL_CLIFFORD_INSTRUCTIONS), ctrl);
+        }
+        else if (choice < 15)
+        {
+            set_multi(inst + i, NON_LOCAL_CLIFFORD_MASK | (rand() % N_NON_LOCAL_CLIFFORD_INSTRUCTIONS), ctrl, targ);
+        }
+        else
+        {
+            set_single(inst + i, _RZ_, ctrl);
+            inst[i].rz.tag = i;
+            *n_rz += 1;
+        }
+    }
+    return inst;
+}
+
+/*
+ * test_equivalence
+ * Parses a stream before and after simplification and compares the widgets
+ */
+void test_equivalence(const size_t n_qubits, const size_t n_gates)
+{
+    size_t n_rz;
+    instruction_stream_u* inst = create_redundant_stream(n_qubits, n_gates, &n_rz);
+    instruction_stream_u* simplified = malloc(n_gates * sizeof(instruction_stream_u));
+    memcpy(simplified, inst, n_gates * sizeof(instruction_stream_u));
+
+    peephole_stats_t stats = {0};
+    const size_t n_kept = peephole_simplify(simplified, n_gates, &stats);
+    assert(n_kept + stats.n_removed == n_gates);
+    assert(stats.n_removed > 0);
+
+    widget_t* wid = widget_create(n_qubits, n_qubits + n_rz);
+    widget_t* wid_ref = widget_create(n_qubits, n_qubits + n_rz);
+    parse_instruction_block(wid, simplified, n_kept);
+    parse_instruction_block(wid_ref, inst, n_gates);
+
+    // Gates may be split differently between the tableau and the queue
+    apply_local_cliffords(wid);
+    apply_local_cliffords(wid_ref);
+
+    assert(wid->n_qubits == wid_ref->n_qubits);
+    for (size_t i = 0; i < wid->n_qubits; i++)
+    {
+        assert(wid->queue->non_cliffords[i] == wid_ref->queue->non_cliffords[i]);
+        for (size_t j = 0; j < wid->tableau->slice_len; j++)
+        {
+            assert(TABLEAU_CHUNK(wid->tableau->slices_x[i], j) == TABLEAU_CHUNK(wid_ref->tableau->slices_x[i], j));
+            assert(TABLEAU_CHUNK(wid->tableau->slices_z[i], j) == TABLEAU_CHUNK(wid_ref->tableau->slices_z[i], j));
+        }
+    }
+    for (size_t j = 0; j < wid->tableau->slice_len; j++)
+    {
+        assert(TABLEAU_CHUNK(wid->tableau->phases, j) == TABLEAU_CHUNK(wid_ref->tableau->phases, j));
+    }
+
+    widget_destroy(wid);
+    widget_destroy(wid_ref);
+    free(simplified);
+    free(inst);
+}
+
+
+int main()
+{
+    test_cancel_pairs();
+
+    for (size_t i = 0; i < 20; i++)
+    {
+        srand(i);
+        test_equivalence(3, 100);
+        test_equivalence(8, 1000);
+        test_equivalence(64, 10000);
+    }
+
+    return 0;
+}
@@ -61,5 +61,33 @@ int main()
         test_tableau_create(n_qubits);
     }
 
+    // Each allocation policy, including tableaus that span several huge pages
+    // Unavailable huge pages or NUMA policies fall back to regular mappings
+    const uint8_t policies[] = {
+        0,
+        TABLEAU_ALLOC_HUGEPAGE,
+        TABLEAU_ALLOC_HUGETLB,
+        TABLEAU_ALLOC_INTERLEAVE,
+        TABLEAU_ALLOC_HUGEPAGE | TABLEAU_ALLOC_INTERLEAVE,
+        TABLEAU_ALLOC_HUGETLB | TABLEAU_ALLOC_INTERLEAVE
+    };
+    const uint8_t default_policy = tableau_get_alloc_policy();
+    for (size_t i = 0; i < sizeof(policies) / sizeof(policies[0]); i++)
+    {
+        tableau_set_alloc_policy(policies[i]);
+        assert(policies[i] == tableau_get_alloc_policy());
+
+        test_tableau_mem(1);
+        test_tableau_create(200);
+        test_tableau_create(4096);
+        test_tableau_create(4096 + 1);
+
+        // Only requested flags can take effect
+        tableau_t* tab = tableau_create(4096);
+        assert(0 == (tab->alloc_applied & ~policies[i]));
+        tableau_destroy(tab);
+    }
+    tableau_set_alloc_policy(default_policy);
+
     return 0;    
 }
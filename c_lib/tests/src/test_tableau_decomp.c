@@ -114,13 +114,252 @@ void test_random(const size_t n_qubits)
 
     for (size_t i = 0; i < wid->tableau->slice_len; i++)
     {
-        assert(0 == wid->tableau->phases[i]);
+        assert(0 == TABLEAU_CHUNK(wid->tableau->phases, i));
     }
 
     widget_destroy(wid);
     return;
 }
 
+/*
+ * test_active_bound
+ * Compares a widget whose kernels are bounded by the active qubits against one whose kernels
+ * sweep every chunk of the tableau, before and after decomposition
+ */
+void test_active_bound(const size_t n_qubits, const size_t n_gates, const size_t n_rz)
+{
+    const size_t max_qubits = n_qubits + n_rz;
+    widget_t* wid = widget_create(n_qubits, max_qubits);
+    widget_t* wid_full = widget_create(n_qubits, max_qubits);
+    widget_reserve_qubits(wid, max_qubits);
+    widget_reserve_qubits(wid_full, max_qubits);
+
+    assert(wid->tableau->active_len == n_qubits / CHUNK_SIZE_BITS + !!(n_qubits % CHUNK_SIZE_BITS));
+    assert(wid->tableau->n_qubits == max_qubits);
+
+    instruction_stream_u* stream = create_instruction_stream(n_qubits, n_gates);
+    for (size_t i = 0; i < n_gates; i++)
+    {
+        instruction_stream_u inst[2] = {stream[i]};
+        size_t n_inst = 1;
+        if (i < n_rz)
+        {
+            inst[1].rz.opcode = _RZ_;
+            inst[1].rz.arg = rand() % n_qubits;
+            inst[1].rz.tag = i;
+            n_inst++;
+        }
+        parse_instruction_block(wid, inst, n_inst);
+
+        for (size_t j = 0; j < n_inst; j++)
+        {
+            tableau_set_active_qubits(wid_full->tableau, wid_full->tableau->n_qubits);
+            parse_instruction_block(wid_full, inst + j, 1);
+        }
+    }
+    free(stream);
+
+    tableau_set_active_qubits(wid_full->tableau, wid_full->tableau->n_qubits);
+    apply_local_cliffords(wid);
+    apply_local_cliffords(wid_full);
+
+    assert(wid->n_qubits == wid_full->n_qubits);
+    assert(wid->tableau->active_len * CHUNK_SIZE_BITS < wid->n_qubits + CHUNK_SIZE_BITS);
+
+    for (size_t i = 0; i < wid->n_qubits; i++)
+    {
+        for (size_t j = 0; j < wid->tableau->slice_len; j++)
+        {
+            assert(TABLEAU_CHUNK(wid->tableau->slices_x[i], j) == TABLEAU_CHUNK(wid_full->tableau->slices_x[i], j));
+            assert(TABLEAU_CHUNK(wid->tableau->slices_z[i], j) == TABLEAU_CHUNK(wid_full->tableau->slices_z[i], j));
+        }
+    }
+
+    widget_decompose(wid);
+    widget_decompose(wid_full);
+
+    for (size_t i = 0; i < wid->n_qubits; i++)
+    {
+        assert(wid->queue->table[i] == wid_full->queue->table[i]);
+        for (size_t j = 0; j < wid->tableau->slice_len; j++)
+        {
+            assert(TABLEAU_CHUNK(wid->tableau->slices_x[i], j) == TABLEAU_CHUNK(wid_full->tableau->slices_x[i], j));
+            assert(TABLEAU_CHUNK(wid->tableau->slices_z[i], j) == TABLEAU_CHUNK(wid_full->tableau->slices_z[i], j));
+        }
+    }
+
+    widget_destroy(wid);
+    widget_destroy(wid_full);
+    return;
+}
+
+/*
+ * test_elim_reference
+ * Eliminates one column at a time with a single row sum for each row
+ */
+void test_elim_reference(widget_t* wid, const bool upper)
+{
+    const size_t n_active = __inline_tableau_active_qubits(wid->tableau);
+    for (size_t i = 0; i < wid->n_qubits; i++)
+    {
+        if (0 == __inline_slice_get_bit(wid->tableau->slices_x[i], i))
+        {
+            tableau_X_diag_element(wid->tableau, wid->queue, i);
+        }
+        for (size_t j = (upper ? i + 1 : 0); j < (upper ? n_active : i); j++)
+        {
+            if (__inline_slice_get_bit(wid->tableau->slices_x[j], i))
+            {
+                tableau_slice_xor(wid->tableau, i, j);
+            }
+        }
+    }
+}
+
+/*
+ * test_elim
+ * Compares the batched column elimination or the blocked elimination against single row sums
+ * :: n_qubits : const size_t :: Number of qubits
+ * :: n_gates : const size_t :: Number of random gates, few gates leave some X columns without pivots
+ * :: blocked : const bool :: Use the blocked elimination rather than one column at a time
+ */
+void test_elim(const size_t n_qubits, const size_t n_gates, const bool blocked)
+{
+    widget_t* wid = widget_create(n_qubits, n_qubits);
+    widget_t* wid_ref = widget_create(n_qubits, n_qubits);
+
+    instruction_stream_u* stream = create_instruction_stream(n_qubits, n_gates);
+    parse_instruction_block(wid, stream, n_gates);
+    parse_instruction_block(wid_ref, stream, n_gates);
+    free(stream);
+    apply_local_cliffords(wid);
+    apply_local_cliffords(wid_ref);
+
+    tableau_remove_zero_X_columns(wid->tableau, wid->queue);
+    tableau_remove_zero_X_columns(wid_ref->tableau, wid_ref->queue);
+    tableau_transpose(wid->tableau);
+    tableau_transpose(wid_ref->tableau);
+
+    if (blocked)
+    {
+        tableau_X_elim_upper(wid->tableau, wid->queue, n_qubits, TABLEAU_PIVOT_FIRST, NULL);
+        tableau_X_elim_lower(wid->tableau, wid->queue, n_qubits, TABLEAU_PIVOT_FIRST, NULL);
+    }
+    else
+    {
+        for (size_t i = 0; i < n_qubits; i++)
+        {
+            if (0 == __inline_slice_get_bit(wid->tableau->slices_x[i], i))
+            {
+                tableau_X_diag_element(wid->tableau, wid->queue, i);
+            }
+            tableau_X_diag_col_upper(wid->tableau, i);
+        }
+        for (size_t i = 0; i < n_qubits; i++)
+        {
+            if (0 == __inline_slice_get_bit(wid->tableau->slices_x[i], i))
+            {
+                tableau_X_diag_element(wid->tableau, wid->queue, i);
+            }
+            tableau_X_diag_col_lower(wid->tableau, i);
+        }
+    }
+    test_elim_reference(wid_ref, true);
+    test_elim_reference(wid_ref, false);
+
+    for (size_t i = 0; i < n_qubits; i++)
+    {
+        assert(wid->queue->table[i] == wid_ref->queue->table[i]);
+        for (size_t j = 0; j < wid->tableau->slice_len; j++)
+        {
+            assert(TABLEAU_CHUNK(wid->tableau->slices_x[i], j) == TABLEAU_CHUNK(wid_ref->tableau->slices_x[i], j));
+            assert(TABLEAU_CHUNK(wid->tableau->slices_z[i], j) == TABLEAU_CHUNK(wid_ref->tableau->slices_z[i], j));
+        }
+    }
+    for (size_t j = 0; j < wid->tableau->slice_len; j++)
+    {
+        assert(TABLEAU_CHUNK(wid->tableau->phases, j) == TABLEAU_CHUNK(wid_ref->tableau->phases, j));
+    }
+
+    widget_destroy(wid);
+    widget_destroy(wid_ref);
+}
+
+/*
+ * test_pivot_modes
+ * Decomposes the same circuit with each pivot strategy
+ * Row swaps carry phases with them, so only the X and Z slices are compared
+ */
+void test_pivot_modes(const size_t n_qubits, const size_t n_gates)
+{
+    widget_t* wid = widget_create(n_qubits, n_qubits);
+    widget_t* wid_ref = widget_create(n_qubits, n_qubits);
+    widget_set_pivot_mode(wid, TABLEAU_PIVOT_MARKOWITZ);
+
+    instruction_stream_u* stream = create_instruction_stream(n_qubits, n_gates);
+    parse_instruction_block(wid, stream, n_gates);
+    parse_instruction_block(wid_ref, stream, n_gates);
+    free(stream);
+    apply_local_cliffords(wid);
+    apply_local_cliffords(wid_ref);
+
+    widget_decompose(wid);
+    widget_decompose(wid_ref);
+
+    for (size_t i = 0; i < n_qubits; i++)
+    {
+        for (size_t j = 0; j < wid->tableau->slice_len; j++)
+        {
+            assert(TABLEAU_CHUNK(wid->tableau->slices_x[i], j) == TABLEAU_CHUNK(wid_ref->tableau->slices_x[i], j));
+            assert(TABLEAU_CHUNK(wid->tableau->slices_z[i], j) == TABLEAU_CHUNK(wid_ref->tableau->slices_z[i], j));
+        }
+    }
+
+    const tableau_elim_stats_t stats = widget_get_elim_stats(wid);
+    const tableau_elim_stats_t stats_ref = widget_get_elim_stats(wid_ref);
+    assert((stats.row_sums > 0) == (stats.chunk_xors > 0));
+    assert((stats_ref.row_sums > 0) == (stats_ref.chunk_xors > 0));
+
+    widget_destroy(wid);
+    widget_destroy(wid_ref);
+}
+
+/*
+ * test_decompose_modes
+ * Decomposes the same circuit on the column major tableau and on the transposed tableau
+ * Both choose the same pivot rows, so the slices and the local Clifford queues match
+ */
+void test_decompose_modes(const size_t n_qubits, const size_t n_gates)
+{
+    widget_t* wid = widget_create(n_qubits, n_qubits);
+    widget_t* wid_ref = widget_create(n_qubits, n_qubits);
+    widget_set_decompose_mode(wid, DECOMPOSE_COLUMNS);
+    widget_set_decompose_mode(wid_ref, DECOMPOSE_TRANSPOSE);
+
+    instruction_stream_u* stream = create_instruction_stream(n_qubits, n_gates);
+    parse_instruction_block(wid, stream, n_gates);
+    parse_instruction_block(wid_ref, stream, n_gates);
+    free(stream);
+    apply_local_cliffords(wid);
+    apply_local_cliffords(wid_ref);
+
+    widget_decompose(wid);
+    widget_decompose(wid_ref);
+
+    for (size_t i = 0; i < n_qubits; i++)
+    {
+        assert(wid->queue->table[i] == wid_ref->queue->table[i]);
+        for (size_t j = 0; j < wid->tableau->slice_len; j++)
+        {
+            assert(TABLEAU_CHUNK(wid->tableau->slices_x[i], j) == TABLEAU_CHUNK(wid_ref->tableau->slices_x[i], j));
+            assert(TABLEAU_CHUNK(wid->tableau->slices_z[i], j) == TABLEAU_CHUNK(wid_ref->tableau->slices_z[i], j));
+        }
+    }
+
+    widget_destroy(wid);
+    widget_destroy(wid_ref);
+}
+
 int main()
 {
     
@@ -137,5 +376,50 @@ int main()
         test_random(i * 64);
     }
 
+    for (size_t i = 0; i < 10; i++)
+    {
+        srand(i);
+        test_active_bound(8 + i, 100, 10 * i);
+        test_active_bound(100 + i, 1000, 300);
+    }
+
+    for (size_t i = 0; i < 10; i++)
+    {
+        for (size_t blocked = 0; blocked < 2; blocked++)
+        {
+            srand(i);
+            test_elim(5 + i, 4, blocked);
+            test_elim(40 + i, 400, blocked);
+            test_elim(100 + i, 20, blocked);
+            test_elim(300 + i, 3000, blocked);
+        }
+    }
+    srand(0);
+    test_elim(2000, 20000, false);
+    test_elim(2000, 20000, true);
+    test_elim(2000, 2000, true);
+
+    // Spans several tiles of the blocked elimination
+    test_elim(4100, 4100, true);
+
+    for (size_t i = 0; i < 10; i++)
+    {
+        srand(i);
+        test_pivot_modes(5 + i, 4);
+        test_pivot_modes(100 + i, 1000);
+        test_pivot_modes(300 + i, 300);
+    }
+    test_pivot_modes(2000, 20000);
+
+    for (size_t i = 0; i < 10; i++)
+    {
+        srand(i);
+        test_decompose_modes(5 + i, 4);
+        test_decompose_modes(100 + i, 1000);
+        test_decompose_modes(300 + i, 300);
+    }
+    test_decompose_modes(2000, 20000);
+    test_decompose_modes(4100, 500);
+
     return 0;
 }
@@ -0,0 +1,89 @@
+#include <assert.h>
+
+#include "tableau.h"
+#include "tableau_operations.h"
+#include "tableau_fused_operations.h"
+#include "test_tableau.h"
+
+
+/*
+ * test_fused_operation
+ * Compares a fused kernel against flushing both local Cliffords and then applying the gate
+ */
+void test_fused_operation(
+    const size_t n_qubits,
+    const instruction_t gate,
+    const instruction_t ctrl_cliff,
+    const instruction_t targ_cliff,
+    const size_t ctrl,
+    const size_t targ)
+{
+    tableau_t* tab = tableau_random_create(n_qubits);
+    tableau_t* tab_cmp = tableau_copy(tab);
+
+    // Serial fused kernel against the forked unfused kernels
+    tab->parallel_threshold = SIZE_MAX;
+    tab_cmp->parallel_threshold = 0;
+    for (size_t j = 0; j < tab->slice_len; j++)
+    {
+        TABLEAU_CHUNK(tab->phases, j) = ((uint64_t)rand() << 32) | rand();
+        TABLEAU_CHUNK(tab_cmp->phases, j) = TABLEAU_CHUNK(tab->phases, j);
+    }
+
+    tableau_fused_two_qubit_operation(tab, gate, ctrl_cliff, targ_cliff, ctrl, targ);
+
+    SINGLE_QUBIT_OPERATIONS[ctrl_cliff & INSTRUCTION_OPERATOR_MASK](tab_cmp, ctrl);
+    SINGLE_QUBIT_OPERATIONS[targ_cliff & INSTRUCTION_OPERATOR_MASK](tab_cmp, targ);
+    TWO_QUBIT_OPERATIONS[gate & INSTRUCTION_OPERATOR_MASK](tab_cmp, ctrl, targ);
+
+    for (size_t i = 0; i < tab->n_qubits; i++)
+    {
+        for (size_t j = 0; j < tab->slice_len; j++)
+        {
+            assert(TABLEAU_CHUNK(tab->slices_x[i], j) == TABLEAU_CHUNK(tab_cmp->slices_x[i], j));
+            assert(TABLEAU_CHUNK(tab->slices_z[i], j) == TABLEAU_CHUNK(tab_cmp->slices_z[i], j));
+        }
+    }
+    for (size_t j = 0; j < tab->slice_len; j++)
+    {
+        assert(TABLEAU_CHUNK(tab->phases, j) == TABLEAU_CHUNK(tab_cmp->phases, j));
+    }
+
+    tableau_destroy(tab);
+    tableau_destroy(tab_cmp);
+    return;
+}
+
+
+int main()
+{
+    const instruction_t gates[N_NON_LOCAL_CLIFFORDS] = {_CNOT_, _CZ_};
+
+    for (size_t gate = 0; gate < N_NON_LOCAL_CLIFFORDS; gate++)
+    {
+        for (size_t ctrl_cliff = 0; ctrl_cliff < N_LOCAL_CLIFFORDS; ctrl_cliff++)
+        {
+            for (size_t targ_cliff = 0; targ_cliff < N_LOCAL_CLIFFORDS; targ_cliff++)
+            {
+                srand(ctrl_cliff * N_LOCAL_CLIFFORDS + targ_cliff);
+                test_fused_operation(
+                    128,
+                    gates[gate],
+                    ctrl_cliff | LOCAL_CLIFFORD_MASK,
+                    targ_cliff | LOCAL_CLIFFORD_MASK,
+                    rand() % 64,
+                    64 + rand() % 64);
+
+                // Control and target in the same chunk, reversed ordering
+                test_fused_operation(
+                    200,
+                    gates[gate],
+                    ctrl_cliff | LOCAL_CLIFFORD_MASK,
+                    targ_cliff | LOCAL_CLIFFORD_MASK,
+                    7,
+                    3);
+            }
+        }
+    }
+    return 0;
+}
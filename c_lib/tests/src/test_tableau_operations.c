@@ -188,6 +188,14 @@ void test_cliffords()
         assert(val_z == tab->slices_z[i][0]);  
         assert(val_r == tab->phases[0]);  
 
+        tableau_HY(tab, i);
+        tableau_H(tab, i);
+        tableau_Y(tab, i);
+
+        assert(val_x == tab->slices_x[i][0]);  
+        assert(val_z == tab->slices_z[i][0]);  
+        assert(val_r == tab->phases[0]);  
+
 
         tableau_SH(tab, i);
         tableau_R(tab, i);
@@ -206,8 +214,8 @@ void test_cliffords()
         assert(val_r == tab->phases[0]);  
 
         tableau_HS(tab, i);
-        tableau_R(tab, i);
         tableau_H(tab, i);
+        tableau_R(tab, i);
 
         assert(val_x == tab->slices_x[i][0]);  
         assert(val_z == tab->slices_z[i][0]);  
@@ -0,0 +1,101 @@
+#include <assert.h>
+
+#include "tableau.h"
+#include "tableau_operations.h"
+#include "tableau_simd_operations.h"
+
+#define TEST_SLICE_LEN (67)
+#define N_TEST_SLICES (5)
+
+/*
+ * test_fill_slices
+ * Fills the test slices with random chunks
+ */
+void test_fill_slices(CHUNK_OBJ slices[N_TEST_SLICES][TEST_SLICE_LEN])
+{
+    for (size_t i = 0; i < N_TEST_SLICES; i++)
+    {
+        for (size_t j = 0; j < TEST_SLICE_LEN; j++)
+        {
+            slices[i][j] = ((uint64_t)rand() << 32) | rand();
+        }
+    }
+}
+
+/*
+ * test_single_qubit_kernels
+ * Compares a table of vectorised single qubit kernels against the scalar kernels
+ * Ranges are chosen to exercise both the register loop and the scalar tail
+ */
+void test_single_qubit_kernels(const tableau_kernel_t* kernels, const size_t start, const size_t end)
+{
+    CHUNK_OBJ slices[N_TEST_SLICES][TEST_SLICE_LEN];
+    CHUNK_OBJ slices_cmp[N_TEST_SLICES][TEST_SLICE_LEN];
+
+    for (size_t cliff = 1; cliff < N_LOCAL_CLIFFORDS; cliff++)
+    {
+        test_fill_slices(slices);
+        memcpy(slices_cmp, slices, sizeof(slices));
+
+        kernels[cliff](slices[0], slices[1], slices[2], start, end);
+        TABLEAU_SCALAR_SINGLE_QUBIT_KERNELS[cliff](slices_cmp[0], slices_cmp[1], slices_cmp[2], start, end);
+
+        assert(0 == memcmp(slices, slices_cmp, sizeof(slices)));
+    }
+}
+
+/*
+ * test_two_qubit_kernels
+ * Compares a table of vectorised two qubit kernels against the scalar kernels
+ */
+void test_two_qubit_kernels(const tableau_two_qubit_kernel_t* kernels, const size_t start, const size_t end)
+{
+    CHUNK_OBJ slices[N_TEST_SLICES][TEST_SLICE_LEN];
+    CHUNK_OBJ slices_cmp[N_TEST_SLICES][TEST_SLICE_LEN];
+
+    for (size_t gate = 0; gate < N_NON_LOCAL_CLIFFORDS; gate++)
+    {
+        test_fill_slices(slices);
+        memcpy(slices_cmp, slices, sizeof(slices));
+
+        kernels[gate](slices[0], slices[1], slices[2], slices[3], slices[4], start, end);
+        TABLEAU_SCALAR_TWO_QUBIT_KERNELS[gate](
+            slices_cmp[0], slices_cmp[1], slices_cmp[2], slices_cmp[3], slices_cmp[4], start, end);
+
+        assert(0 == memcmp(slices, slices_cmp, sizeof(slices)));
+    }
+}
+
+void test_kernel_ranges(const tableau_kernel_t* single_kernels, const tableau_two_qubit_kernel_t* two_kernels)
+{
+    const size_t ranges[][2] = {{0, TEST_SLICE_LEN}, {8, 16}, {8, 61}, {0, 3}, {5, 5}};
+    for (size_t i = 0; i < sizeof(ranges) / sizeof(ranges[0]); i++)
+    {
+        test_single_qubit_kernels(single_kernels, ranges[i][0], ranges[i][1]);
+        test_two_qubit_kernels(two_kernels, ranges[i][0], ranges[i][1]);
+    }
+}
+
+
+int main()
+{
+    // The scalar reference kernels walk strided slices in the tiled layout
+    if (TABLEAU_LAYOUT != TABLEAU_LAYOUT_SLICES)
+    {
+        return 0;
+    }
+
+    srand(0);
+
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        test_kernel_ranges(TABLEAU_AVX2_SINGLE_QUBIT_KERNELS, TABLEAU_AVX2_TWO_QUBIT_KERNELS);
+    }
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        test_kernel_ranges(TABLEAU_AVX512_SINGLE_QUBIT_KERNELS, TABLEAU_AVX512_TWO_QUBIT_KERNELS);
+    }
+
+    return 0;
+}
@@ -0,0 +1,181 @@
+#include <assert.h>
+
+#define INSTRUCTIONS_TABLE
+
+#include "widget.h"
+#include "tableau_operations.h"
+#include "input_stream.h"
+#include "instructions.h"
+
+#define TEST_OCCUPANCY_WORDS (4)
+
+/*
+ * test_next_run
+ * Compares the runs found in a random bitmap against a bit by bit scan
+ */
+void test_next_run(const size_t start, const size_t end)
+{
+    CHUNK_OBJ occ[TEST_OCCUPANCY_WORDS];
+    for (size_t i = 0; i < TEST_OCCUPANCY_WORDS; i++)
+    {
+        // Sparse, dense and empty words
+        switch (rand() % 3)
+        {
+            case 0: occ[i] = 0; break;
+            case 1: occ[i] = ~0ull; break;
+            default: occ[i] = ((uint64_t)rand() << 32) | rand();
+        }
+    }
+
+    size_t pos = start;
+    size_t run_start;
+    size_t bit = start;
+    while (__inline_tableau_next_run(occ, &pos, end, &run_start))
+    {
+        // Every chunk between runs is unoccupied
+        for (; bit < run_start; bit++)
+        {
+            assert(0 == ((occ[bit / CHUNK_SIZE_BITS] >> (bit % CHUNK_SIZE_BITS)) & 1));
+        }
+        assert(run_start < pos);
+        for (; bit < pos; bit++)
+        {
+            assert(1 == ((occ[bit / CHUNK_SIZE_BITS] >> (bit % CHUNK_SIZE_BITS)) & 1));
+        }
+        assert((pos == end) || (0 == ((occ[pos / CHUNK_SIZE_BITS] >> (pos % CHUNK_SIZE_BITS)) & 1)));
+    }
+    assert(pos == end);
+    for (; bit < end; bit++)
+    {
+        assert(0 == ((occ[bit / CHUNK_SIZE_BITS] >> (bit % CHUNK_SIZE_BITS)) & 1));
+    }
+}
+
+/*
+ * test_occupancy_bound
+ * Checks that every non zero chunk of every slice is marked as occupied
+ */
+void test_occupancy_bound(const tableau_t* tab)
+{
+    for (size_t i = 0; i < tab->n_qubits; i++)
+    {
+        const CHUNK_OBJ* occ = __inline_tableau_occupancy(tab, i);
+        for (size_t j = 0; j < tab->slice_len; j++)
+        {
+            if (TABLEAU_CHUNK(tab->slices_x[i], j) | TABLEAU_CHUNK(tab->slices_z[i], j))
+            {
+                assert((occ[j / CHUNK_SIZE_BITS] >> (j % CHUNK_SIZE_BITS)) & 1);
+            }
+        }
+    }
+}
+
+/*
+ * test_widget_eq
+ * Compares the first n_qubits slices, the phases and the local Clifford queues of two widgets
+ */
+void test_widget_eq(const widget_t* wid, const widget_t* wid_cmp)
+{
+    assert(wid->n_qubits == wid_cmp->n_qubits);
+    for (size_t i = 0; i < wid->n_qubits; i++)
+    {
+        assert(wid->queue->table[i] == wid_cmp->queue->table[i]);
+        for (size_t j = 0; j < wid->tableau->slice_len; j++)
+        {
+            assert(TABLEAU_CHUNK(wid->tableau->slices_x[i], j) == TABLEAU_CHUNK(wid_cmp->tableau->slices_x[i], j));
+            assert(TABLEAU_CHUNK(wid->tableau->slices_z[i], j) == TABLEAU_CHUNK(wid_cmp->tableau->slices_z[i], j));
+        }
+    }
+    for (size_t j = 0; j < wid->tableau->slice_len; j++)
+    {
+        assert(TABLEAU_CHUNK(wid->tableau->phases, j) == TABLEAU_CHUNK(wid_cmp->tableau->phases, j));
+    }
+}
+
+/*
+ * test_sparse_widget
+ * Compares a sparse widget against a dense widget over the same gates, then decomposes both
+ * :: n_qubits : const size_t :: Number of initial qubits
+ * :: n_gates : const size_t :: Number of Clifford gates
+ * :: locality : const size_t :: Maximum distance between the qubits of a two qubit gate
+ * :: mode : const uint8_t :: Ingest mode of both widgets
+ */
+void test_sparse_widget(const size_t n_qubits, const size_t n_gates, const size_t locality, const uint8_t mode)
+{
+    const size_t n_rz = n_gates / 16 + 1;
+    widget_t* wid = widget_create(n_qubits, n_qubits + n_rz);
+    widget_t* wid_dense = widget_create(n_qubits, n_qubits + n_rz);
+    widget_set_ingest_mode(wid, mode);
+    widget_set_ingest_mode(wid_dense, mode);
+    widget_set_sparse_slices(wid, true);
+
+    instruction_stream_u* inst = malloc((n_gates + n_rz) * sizeof(instruction_stream_u));
+    size_t n_inst = 0;
+    for (size_t i = 0; i < n_gates; i++)
+    {
+        if (rand() % 2)
+        {
+            inst[n_inst].single.opcode = LOCAL_CLIFFORD_MASK | (rand() % N_LOCAL_CLIFFORD_INSTRUCTIONS);
+            inst[n_inst].single.arg = rand() % n_qubits;
+        }
+        else
+        {
+            inst[n_inst].multi.opcode = NON_LOCAL_CLIFFORD_MASK | (rand() % N_NON_LOCAL_CLIFFORD_INSTRUCTIONS);
+            inst[n_inst].multi.ctrl = rand() % (n_qubits - locality);
+            inst[n_inst].multi.targ = inst[n_inst].multi.ctrl + 1 + rand() % locality;
+        }
+        n_inst++;
+
+        if (0 == (i % 16))
+        {
+            inst[n_inst].rz.opcode = _RZ_;
+            inst[n_inst].rz.arg = rand() % n_qubits;
+            inst[n_inst].rz.tag = i;
+            n_inst++;
+        }
+    }
+
+    parse_instruction_block(wid, inst, n_inst);
+    parse_instruction_block(wid_dense, inst, n_inst);
+    apply_local_cliffords(wid);
+    apply_local_cliffords(wid_dense);
+
+    assert(NULL != wid->tableau->occupancy);
+    assert(NULL == wid_dense->tableau->occupancy);
+    test_occupancy_bound(wid->tableau);
+    test_widget_eq(wid, wid_dense);
+
+    // Decomposition densifies on demand
+    widget_decompose(wid);
+    widget_decompose(wid_dense);
+    assert(NULL == wid->tableau->occupancy);
+    test_widget_eq(wid, wid_dense);
+
+    free(inst);
+    widget_destroy(wid);
+    widget_destroy(wid_dense);
+}
+
+
+int main()
+{
+    srand(0);
+    for (size_t i = 0; i < 100; i++)
+    {
+        test_next_run(0, TEST_OCCUPANCY_WORDS * CHUNK_SIZE_BITS);
+        test_next_run(rand() % 64, TEST_OCCUPANCY_WORDS * CHUNK_SIZE_BITS - rand() % 64);
+        test_next_run(3, 3);
+    }
+
+    for (size_t i = 0; i < 5; i++)
+    {
+        srand(i);
+        test_sparse_widget(100, 500, 8, INGEST_DISPATCH);
+        test_sparse_widget(8192, 2000, 16, INGEST_DISPATCH);
+        test_sparse_widget(8192, 2000, 16, INGEST_CHUNK_REPLAY);
+        test_sparse_widget(8192, 2000, 16, INGEST_THREADED);
+        test_sparse_widget(8192, 2000, 4096, INGEST_CHUNK_REPLAY);
+    }
+
+    return 0;
+}
@@ -18,8 +18,8 @@ void test_tableau_transpose(const size_t n_qubits)
     {
         for (size_t j = 0; j < tab->slice_len; j++)
          {
-            assert(tab->slices_x[i][j] == tab_cmp->slices_x[i][j]);
-            assert(tab->slices_z[i][j] == tab_cmp->slices_z[i][j]);
+            assert(TABLEAU_CHUNK(tab->slices_x[i], j) == TABLEAU_CHUNK(tab_cmp->slices_x[i], j));
+            assert(TABLEAU_CHUNK(tab->slices_z[i], j) == TABLEAU_CHUNK(tab_cmp->slices_z[i], j));
         }
     } 
 
@@ -37,15 +37,15 @@ void test_tableau_transpose(const size_t n_qubits)
     {
         for (size_t j = 0; j < tab->slice_len; j++)
          {
-            if (tab->slices_x[i][j] != tab_cmp->slices_x[i][j])
+            if (TABLEAU_CHUNK(tab->slices_x[i], j) != TABLEAU_CHUNK(tab_cmp->slices_x[i], j))
             {
                printf("\tFailed: %lu %lu\n", i, j); 
                j += tab->slice_len; 
                i += 64;
             }
 
-            assert(tab->slices_x[i][j] == tab_cmp->slices_x[i][j]);
-            assert(tab->slices_z[i][j] == tab_cmp->slices_z[i][j]);
+            assert(TABLEAU_CHUNK(tab->slices_x[i], j) == TABLEAU_CHUNK(tab_cmp->slices_x[i], j));
+            assert(TABLEAU_CHUNK(tab->slices_z[i], j) == TABLEAU_CHUNK(tab_cmp->slices_z[i], j));
         }
     } 
     return;
@@ -54,6 +54,13 @@ void test_tableau_transpose(const size_t n_qubits)
 
 int main()
 {
+    // Fewer qubits than a single block
+    for (size_t i = 1; i < 64; i++)
+    {
+        srand(i);
+        test_tableau_transpose(i);
+    }
+
     // Single inplace transpose
     for (size_t i = 0; i < 1000; i++)
     {
@@ -93,7 +93,12 @@ void test_2x16()
     return;
 }
 
-void test_64x64()
+/*
+ * test_64x64
+ * Compares a pair transpose against the chunk transpose and the naive transpose
+ * :: transpose : Transpose under test
+ */
+void test_64x64(void (*transpose)(uint64_t* src[64], uint64_t* targ[64]))
 {
     const size_t n_channels = 64;
     const size_t stride = 1; 
@@ -146,7 +151,7 @@ void test_64x64()
 
     for (size_t i = 0; i < n_bytes; i++)
     {
-        ((uint8_t*)arr_a_naive)[i] = (i | (i % 3)) | (i << (i % 7));
+        ((uint8_t*)arr_a_naive)[i] = ((i | (i % 3)) | (i << (i % 7))) ^ rand();
     }
     memcpy(arr_a_chunk, arr_a_naive, n_bytes); 
     memcpy(arr_a_simd, arr_a_naive, n_bytes); 
@@ -161,7 +166,7 @@ void test_64x64()
     }
 
     transpose_naive(ptrs_a_naive, 64);
-    simd_transpose_64x64(ptrs_a_simd, ptrs_b_simd);
+    transpose(ptrs_a_simd, ptrs_b_simd);
     chunk_transpose_64x64(ptrs_a_chunk, ptrs_b_chunk);
 
     for (size_t i = 0; i < n_bytes; i++)
@@ -172,7 +177,7 @@ void test_64x64()
     }
 
     transpose_naive(ptrs_a_naive, 64);
-    simd_transpose_64x64(ptrs_a_simd, ptrs_b_simd);
+    transpose(ptrs_a_simd, ptrs_b_simd);
     chunk_transpose_64x64(ptrs_a_chunk, ptrs_b_chunk);
 
     for (size_t i = 0; i < n_bytes; i++)
@@ -188,7 +193,12 @@ void test_64x64()
 }
 
 
-void test_inplace_64x64()
+/*
+ * test_inplace_64x64
+ * Compares an in place transpose against the chunk transpose
+ * :: transpose : Transpose under test
+ */
+void test_inplace_64x64(void (*transpose)(uint64_t* src[64]))
 {
     const size_t n_channels = 64;
     const size_t stride = 1; 
@@ -234,8 +244,8 @@ void test_inplace_64x64()
 
     for (size_t i = 0; i < n_bytes; i++)
     {
-        ((uint8_t*)arr_a_chunk)[i] = (i | (i % 3)) | (i << (i % 7));
-        ((uint8_t*)arr_a_simd)[i] = (i | (i % 3)) | (i << (i % 7));
+        ((uint8_t*)arr_a_chunk)[i] = ((i | (i % 3)) | (i << (i % 7))) ^ rand();
+        ((uint8_t*)arr_a_simd)[i] = ((uint8_t*)arr_a_chunk)[i];
     }
 
     // Initial state equal    
@@ -245,7 +255,7 @@ void test_inplace_64x64()
         assert(((uint8_t*)arr_a_chunk)[i] == ((uint8_t*)arr_a_simd)[i]);
     }
 
-    simd_transpose_64x64_inplace(ptrs_a_simd);
+    transpose(ptrs_a_simd);
     chunk_transpose_64x64(ptrs_a_chunk, ptrs_b_chunk);
 
     for (size_t i = 0; i < n_bytes; i++)
@@ -253,7 +263,7 @@ void test_inplace_64x64()
         assert(((uint8_t*)arr_b_chunk)[i] == ((uint8_t*)arr_a_simd)[i]);
     }
 
-    simd_transpose_64x64_inplace(ptrs_a_simd);
+    transpose(ptrs_a_simd);
     chunk_transpose_64x64(ptrs_a_chunk, ptrs_b_chunk);
 
     for (size_t i = 0; i < n_bytes; i++)
@@ -268,12 +278,31 @@ void test_inplace_64x64()
 
 int main()
 {
+    // The shuffle transposes require AVX2, the simd transposes also require BMI2
+    __builtin_cpu_init();
+    if (!__builtin_cpu_supports("avx2"))
+    {
+        return 0;
+    }
+
+    for (size_t i = 0; i < 1000; i++)
+    {
+        srand(i);
+        test_64x64(shuffle_transpose_64x64);
+        test_inplace_64x64(shuffle_transpose_64x64_inplace);
+    }
+
+    if (!__builtin_cpu_supports("bmi2"))
+    {
+        return 0;
+    }
+
     for (size_t i = 0; i < 1000; i++)
     {
         srand(i);
         test_2x16();
-        test_64x64();
-        test_inplace_64x64();
+        test_64x64(simd_transpose_64x64);
+        test_inplace_64x64(simd_transpose_64x64_inplace);
     }
     return 0;
 }
@@ -51,10 +51,68 @@ void test_initial_cliffords()
 }
 
 
+/*
+ * test_widget_growth
+ * Compares a widget whose tableau grows with rz gates against one allocated at its maximum size
+ */
+void test_widget_growth(const size_t n_qubits, const size_t n_rz)
+{
+    const size_t max_qubits = n_qubits + n_rz;
+    widget_t* wid = widget_create(n_qubits, max_qubits);
+    widget_t* wid_full = widget_create(n_qubits, max_qubits);
+    widget_reserve_qubits(wid_full, max_qubits);
+
+    assert(wid->tableau->n_qubits <= max_qubits);
+    assert(wid->tableau->n_qubits <= ((n_qubits > WIDGET_MIN_TABLEAU_QUBITS) ? n_qubits : WIDGET_MIN_TABLEAU_QUBITS));
+    assert(wid_full->tableau->n_qubits == max_qubits);
+
+    instruction_stream_u inst[2];
+    for (size_t i = 0; i < n_rz; i++)
+    {
+        inst[0].multi.opcode = NON_LOCAL_CLIFFORD_MASK | (rand() % N_NON_LOCAL_CLIFFORD_INSTRUCTIONS);
+        inst[0].multi.ctrl = rand() % n_qubits;
+        while ((inst[0].multi.targ = rand() % n_qubits) == inst[0].multi.ctrl){};
+
+        inst[1].rz.opcode = _RZ_;
+        inst[1].rz.arg = rand() % n_qubits;
+        inst[1].rz.tag = i;
+
+        parse_instruction_block(wid, inst, 2);
+        parse_instruction_block(wid_full, inst, 2);
+
+        // Capacity at most doubles past the number of allocated qubits
+        assert(wid->tableau->n_qubits >= wid->n_qubits);
+        assert(wid->tableau->n_qubits <= max_qubits);
+    }
+
+    assert(wid->n_qubits == wid_full->n_qubits);
+    for (size_t i = 0; i < wid->n_qubits; i++)
+    {
+        for (size_t j = 0; j < wid->tableau->slice_len; j++)
+        {
+            assert(TABLEAU_CHUNK(wid->tableau->slices_x[i], j) == TABLEAU_CHUNK(wid_full->tableau->slices_x[i], j));
+            assert(TABLEAU_CHUNK(wid->tableau->slices_z[i], j) == TABLEAU_CHUNK(wid_full->tableau->slices_z[i], j));
+        }
+    }
+    for (size_t j = 0; j < wid->tableau->slice_len; j++)
+    {
+        assert(TABLEAU_CHUNK(wid->tableau->phases, j) == TABLEAU_CHUNK(wid_full->tableau->phases, j));
+    }
+
+    widget_destroy(wid);
+    widget_destroy(wid_full);
+}
+
+
 int main()
 {
     test_widget_create();
     test_initial_map();
     test_initial_cliffords();
+
+    srand(0);
+    test_widget_growth(4, 8);
+    test_widget_growth(100, 1000);
+    test_widget_growth(600, 1500);
     return 0;
 }